@@ -3,59 +3,117 @@
 #############################################################################
 
 SOURCES += \
-    src/qcustomtablewidget.cpp \
     src/global_settings_io.cpp \
     src/air.cpp \
     src/preference_dialog.cpp \
+    src/batch_renderer.cpp \
+    src/catalog_loader.cpp \
+    src/catalog_snapshot.cpp \
     src/catalog_view_form.cpp \
+    src/catalog_view_model.cpp \
     src/catalog_view_setting_dialog.cpp \
     src/curve_fitting_dialog.cpp \
+    src/derived_column_cache.cpp \
+    src/dispersion_fitter.cpp \
     src/dispersion_plot_form.cpp \
+    src/dispersion_similarity_engine.cpp \
+    src/dispersion_similarity_form.cpp \
     src/dndt_plot_form.cpp \
     src/glass.cpp \
+    src/glass_arena.cpp \
+    src/glass_athermal_engine.cpp \
+    src/glass_athermal_form.cpp \
     src/glass_catalog.cpp \
     src/glass_catalog_manager.cpp \
+    src/glass_combination_engine.cpp \
+    src/glass_combination_form.cpp \
     src/glass_datasheet_form.cpp \
+    src/glass_expression.cpp \
+    src/glass_melt_fit_form.cpp \
+    src/glass_search_engine.cpp \
     src/glass_selection_dialog.cpp \
     src/glass_search_form.cpp \
+    src/glass_skyline.cpp \
+    src/glass_skyline_form.cpp \
+    src/glass_substitute_engine.cpp \
+    src/glass_substitute_form.cpp \
+    src/glass_table.cpp \
     src/glassmap_form.cpp \
+    src/kd_tree_2d.cpp \
     src/load_catalog_result_dialog.cpp \
     src/main.cpp \
     src/main_window.cpp \
+    src/normal_line.cpp \
+    src/parse_diagnostics.cpp \
+    src/parse_diagnostics_model.cpp \
+    src/plot_data_model.cpp \
     src/preset_dialog.cpp \
     src/property_plot_form.cpp \
     src/qcpscatterchart.cpp \
+    src/qcpscatterpoints.cpp \
+    src/qcptextlabels.cpp \
+    src/qcustomtableview.cpp \
     src/spectral_line.cpp \
     src/transmittance_plot_form.cpp \
+    src/vp_tree.cpp \
     3rdparty/QCustomPlot/qcustomplot.cpp \
     3rdparty/pugixml/src/pugixml.cpp
 
 
 HEADERS += \
-    src/qcustomtablewidget.h \
     src/global_settings_io.h \
     src/air.h \
     src/preference_dialog.h \
+    src/batch_renderer.h \
+    src/catalog_loader.h \
+    src/catalog_snapshot.h \
     src/catalog_view_form.h \
+    src/catalog_view_model.h \
     src/catalog_view_setting_dialog.h \
     src/curve_fitting_dialog.h \
+    src/derived_column_cache.h \
+    src/dispersion_fitter.h \
     src/dispersion_formula.h \
     src/dispersion_plot_form.h \
+    src/dispersion_similarity_engine.h \
+    src/dispersion_similarity_form.h \
     src/dndt_plot_form.h \
     src/glass.h \
+    src/glass_arena.h \
+    src/glass_athermal_engine.h \
+    src/glass_athermal_form.h \
     src/glass_catalog.h \
     src/glass_catalog_manager.h \
+    src/glass_combination_engine.h \
+    src/glass_combination_form.h \
     src/glass_datasheet_form.h \
+    src/glass_expression.h \
+    src/glass_melt_fit_form.h \
+    src/glass_search_engine.h \
     src/glass_selection_dialog.h \
     src/glass_search_form.h \
+    src/glass_skyline.h \
+    src/glass_skyline_form.h \
+    src/glass_substitute_engine.h \
+    src/glass_substitute_form.h \
+    src/glass_table.h \
     src/glassmap_form.h \
+    src/kd_tree_2d.h \
     src/load_catalog_result_dialog.h \
     src/main_window.h \
+    src/normal_line.h \
+    src/parse_diagnostics.h \
+    src/parse_diagnostics_model.h \
+    src/plot_data_model.h \
     src/preset_dialog.h \
     src/property_plot_form.h \
     src/qcpscatterchart.h \
+    src/qcpscatterpoints.h \
+    src/qcptextlabels.h \
+    src/qcustomtableview.h \
     src/spectral_line.h \
     src/transmittance_plot_form.h \
+    src/vp_tree.h \
     3rdparty/QCustomPlot/qcustomplot.h
 
     #pugixml/src/pugiconfig.hpp \   # pugixml
@@ -69,10 +127,16 @@ FORMS += \
     src/catalog_view_setting_dialog.ui \
     src/curve_fitting_dialog.ui \
     src/dispersion_plot_form.ui \
+    src/dispersion_similarity_form.ui \
     src/dndt_plot_form.ui \
+    src/glass_athermal_form.ui \
+    src/glass_combination_form.ui \
     src/glass_datasheet_form.ui \
+    src/glass_melt_fit_form.ui \
     src/glass_selection_dialog.ui \
     src/glass_search_form.ui \
+    src/glass_skyline_form.ui \
+    src/glass_substitute_form.ui \
     src/load_catalog_result_dialog.ui \
     src/main_window.ui \
     src/preset_dialog.ui \
@@ -0,0 +1,413 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "batch_renderer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include <QDir>
+#include <QProcess>
+#include <QSettings>
+#include <QTextCodec>
+#include <QThread>
+#include <QTextStream>
+
+#include "glass.h"
+#include "glass_catalog_manager.h"
+#include "global_settings_io.h"
+
+bool BatchRenderer::isRequested(int argc, char *argv[])
+{
+    for(int i = 1; i < argc; i++){
+        if(0 == std::strcmp(argv[i], "--render") || 0 == std::strncmp(argv[i], "--render=", 9)){
+            return true;
+        }
+    }
+    return false;
+}
+
+int BatchRenderer::exec(const QStringList &arguments)
+{
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Render glass maps and property plots listed in a spec file without display");
+    parser.addHelpOption();
+    QCommandLineOption renderOption("render", "Spec file of the plots.", "file");
+    QCommandLineOption jobsOption("jobs", "Number of the worker processes.  Default is the number of the cores.", "n");
+    QCommandLineOption workerOption("worker", "Index of this worker process.  Used internally.", "k");
+    QCommandLineOption workersOption("workers", "Number of the worker processes.  Used internally.", "n");
+    workerOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    workersOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOptions({renderOption, jobsOption, workerOption, workersOption});
+    parser.process(arguments);
+
+    QString specFilePath = parser.value(renderOption);
+
+    QStringList     catalogFilePaths;
+    QList<PlotSpec> specs;
+    QString         errorMessage;
+    if(!readSpecFile(specFilePath, catalogFilePaths, specs, errorMessage)){
+        err << specFilePath << ": " << errorMessage << "\n";
+        return 1;
+    }
+
+    if(!parser.isSet(workerOption)){
+        int jobCount = parser.isSet(jobsOption) ? parser.value(jobsOption).toInt() : QThread::idealThreadCount();
+        jobCount = qBound(1, jobCount, specs.size());
+        if(jobCount > 1){
+            return runWorkers(specFilePath, jobCount);
+        }
+        return render(catalogFilePaths, specs);
+    }
+
+    // the share of this worker
+    int worker  = parser.value(workerOption).toInt();
+    int workers = qMax(1, parser.value(workersOption).toInt());
+    QList<PlotSpec> share;
+    for(int i = worker; i < specs.size(); i += workers){
+        share.append(specs[i]);
+    }
+    return render(catalogFilePaths, share);
+}
+
+int BatchRenderer::runWorkers(const QString &specFilePath, int jobCount)
+{
+    // QWidget, and thus QCustomPlot, can be used only in the main thread, so that the plots are rendered in parallel by processes.
+    QList<QProcess*> processes;
+    for(int k = 0; k < jobCount; k++){
+        QProcess* process = new QProcess;
+        process->setProcessChannelMode(QProcess::ForwardedChannels);
+        process->start(QCoreApplication::applicationFilePath(),
+                       QStringList() << "--render" << specFilePath << "--worker" << QString::number(k) << "--workers" << QString::number(jobCount));
+        processes.append(process);
+    }
+
+    int exitCode = 0;
+    for(auto &process : processes){
+        if(!process->waitForFinished(-1) || process->exitStatus() != QProcess::NormalExit || process->exitCode() != 0){
+            exitCode = 1;
+        }
+        delete process;
+    }
+    return exitCode;
+}
+
+bool BatchRenderer::readSpecFile(const QString &specFilePath, QStringList &catalogFilePaths, QList<PlotSpec> &specs, QString &errorMessage)
+{
+    QFileInfo specFileInfo(specFilePath);
+    if(!specFileInfo.exists()){
+        errorMessage = "File not found";
+        return false;
+    }
+    QDir baseDir = specFileInfo.absoluteDir(); // base of the relative paths
+
+    QSettings settings(specFilePath, QSettings::IniFormat);
+    settings.setIniCodec(QTextCodec::codecForName("UTF-8"));
+
+    // The catalogs and the temperature default to the preference.
+    // The keys of [General] are the top level keys of QSettings.
+    GlobalSettingsIO preference;
+    preference.loadIniFile();
+
+    QStringList files = settings.value("catalogs").toStringList();
+    if(files.isEmpty()){
+        catalogFilePaths = preference.defaultFilePaths();
+    }else{
+        catalogFilePaths.clear();
+        for(auto &file : files){
+            catalogFilePaths.append(baseDir.absoluteFilePath(file.trimmed()));
+        }
+    }
+    if(catalogFilePaths.isEmpty()){
+        errorMessage = "No catalog files";
+        return false;
+    }
+
+    double defaultTemperature = settings.value("temperature", preference.temperature()).toDouble();
+
+    // a range given as "lower, upper"
+    auto readRange = [&settings](const QString& key, QCPRange& range){
+        QStringList values = settings.value(key).toStringList();
+        if(values.size() != 2){
+            return false;
+        }
+        range = QCPRange(values[0].toDouble(), values[1].toDouble());
+        return true;
+    };
+
+    specs.clear();
+    for(auto &group : settings.childGroups()){
+        settings.beginGroup(group);
+
+        PlotSpec spec;
+        spec.name        = group;
+        spec.type        = settings.value("type", "glassmap").toString().toLower();
+        spec.xProperty   = settings.value("x", "vd").toString();
+        spec.yProperty   = settings.value("y", "nd").toString();
+        spec.hasXRange   = readRange("xrange", spec.xRange);
+        spec.hasYRange   = readRange("yrange", spec.yRange);
+        spec.xReversed   = settings.value("xreversed", "glassmap" == spec.type).toBool();
+        spec.suppliers   = settings.value("catalogs").toStringList();
+        spec.glasses     = settings.value("glasses").toStringList();
+        spec.labels      = settings.value("labels", false).toBool();
+        spec.legend      = settings.value("legend", true).toBool();
+        spec.temperature = settings.value("temperature", defaultTemperature).toDouble();
+        spec.thickness   = settings.value("thickness", 25.0).toDouble();
+        spec.width       = settings.value("width", 800).toInt();
+        spec.height      = settings.value("height", 600).toInt();
+        spec.scale       = settings.value("dpi", 96).toDouble()/96.0;
+
+        QString output = settings.value("output", group + ".png").toString();
+        spec.outputPath = baseDir.absoluteFilePath(output);
+
+        for(auto &s : spec.suppliers){
+            s = s.trimmed();
+        }
+        for(auto &g : spec.glasses){
+            g = g.trimmed();
+        }
+
+        settings.endGroup();
+
+        if(spec.type != "glassmap" && spec.type != "dispersion" && spec.type != "transmittance"){
+            errorMessage = "Unknown plot type in [" + group + "]: " + spec.type;
+            return false;
+        }
+        if(spec.width <= 0 || spec.height <= 0 || spec.scale <= 0){
+            errorMessage = "Invalid size in [" + group + "]";
+            return false;
+        }
+
+        specs.append(spec);
+    }
+
+    if(specs.isEmpty()){
+        errorMessage = "No plots";
+        return false;
+    }
+
+    return true;
+}
+
+int BatchRenderer::render(const QStringList &catalogFilePaths, const QList<PlotSpec> &specs)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    if(specs.isEmpty()){
+        return 0;
+    }
+
+    GlassCatalogManager manager;
+
+    GlobalSettingsIO preference;
+    preference.loadIniFile();
+    GlassCatalogManager::setNormalLineReference(static_cast<NormalLine::Reference>(preference.normalLineReference()));
+
+    ParseDiagnostics diagnostics;
+    GlassCatalogManager::loadCatalogFiles(catalogFilePaths, diagnostics);
+    if(GlassCatalogManager::isEmpty()){
+        err << "No catalogs were loaded\n";
+        return 1;
+    }
+
+    // The plots are rendered only with all of the given catalogs.
+    if(diagnostics.count(ParseDiagnostics::CatalogLoadingError) > 0){
+        for(int i = 0; i < diagnostics.recordCount(); i++){
+            if(ParseDiagnostics::CatalogLoadingError == diagnostics.record(i).code){
+                err << diagnostics.toString(diagnostics.record(i)) << "\n";
+            }
+        }
+        return 1;
+    }
+
+    // The table is rebuilt only when the temperature changes.
+    QList<PlotSpec> sorted = specs;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const PlotSpec& a, const PlotSpec& b){
+        return a.temperature < b.temperature;
+    });
+
+    int failureCount = 0;
+    for(auto &spec : sorted){
+        GlassCatalogManager::setTemperature(spec.temperature);
+
+        QString errorMessage;
+        if(renderPlot(spec, errorMessage)){
+            out << spec.outputPath << "\n";
+            out.flush();
+        }else{
+            err << "[" << spec.name << "] " << errorMessage << "\n";
+            err.flush();
+            failureCount++;
+        }
+    }
+
+    return (0 == failureCount) ? 0 : 1;
+}
+
+bool BatchRenderer::renderPlot(const PlotSpec &spec, QString &errorMessage)
+{
+    QCustomPlot customPlot;
+    customPlot.resize(spec.width, spec.height);
+
+    QList<QCPScatterChart*> glassmaps; // removed from the plot before it is deleted
+    bool ok = ("glassmap" == spec.type) ? plotGlassmap(&customPlot, spec, glassmaps, errorMessage) : plotProperty(&customPlot, spec, errorMessage);
+    if(!ok){
+        qDeleteAll(glassmaps);
+        return false;
+    }
+
+    customPlot.legend->setVisible(spec.legend);
+    customPlot.replot();
+
+    QDir().mkpath(QFileInfo(spec.outputPath).absolutePath());
+
+    QString suffix = QFileInfo(spec.outputPath).suffix().toLower();
+    if("pdf" == suffix){
+        ok = customPlot.savePdf(spec.outputPath, spec.width, spec.height);
+    }
+    else if("jpg" == suffix || "jpeg" == suffix){
+        ok = customPlot.saveJpg(spec.outputPath, spec.width, spec.height, spec.scale);
+    }
+    else{
+        ok = customPlot.savePng(spec.outputPath, spec.width, spec.height, spec.scale);
+    }
+
+    qDeleteAll(glassmaps);
+
+    if(!ok){
+        errorMessage = "Failed to save " + spec.outputPath;
+    }
+    return ok;
+}
+
+bool BatchRenderer::plotGlassmap(QCustomPlot *customPlot, const PlotSpec &spec, QList<QCPScatterChart*>& glassmaps, QString &errorMessage)
+{
+    std::shared_ptr<const CatalogSnapshot> snapshot = GlassCatalogManager::snapshot();
+    const GlassTable& table = *snapshot->table();
+
+    QString xError, yError;
+    DerivedColumnCache::Column xColumn = GlassCatalogManager::derivedColumn(snapshot, spec.xProperty, &xError);
+    DerivedColumnCache::Column yColumn = GlassCatalogManager::derivedColumn(snapshot, spec.yProperty, &yError);
+    if(!xColumn || !yColumn){
+        errorMessage = "Invalid property: " + (xColumn ? spec.yProperty + " " + yError : spec.xProperty + " " + xError);
+        return false;
+    }
+
+    // Same colors as the glassmap windows
+    QCPColorGradient colorgrad;
+    colorgrad.loadPreset(QCPColorGradient::gpHues);
+
+    for(int ci = 0; ci < table.catalogCount(); ci++){
+        if(!spec.suppliers.isEmpty() && !spec.suppliers.contains(table.supplier(ci), Qt::CaseInsensitive)){
+            continue;
+        }
+
+        QVector<double> x, y;
+        QVector<QString> labels;
+        int rowBegin = table.firstRow(ci);
+        for(int row = rowBegin; row < rowBegin + table.rowCount(ci); row++){
+            if(table.isValid(row)){
+                x.append(xColumn->at(row));
+                y.append(yColumn->at(row));
+                labels.append(table.fullName(row));
+            }
+        }
+
+        QCPScatterChart* glassmap = new QCPScatterChart(customPlot);
+        glassmap->setData(x, y, labels);
+        glassmap->setName(table.supplier(ci));
+        glassmap->setColor(colorgrad.color(ci, QCPRange(0, table.catalogCount())));
+        glassmap->setVisibleTextLabels(spec.labels);
+        glassmaps.append(glassmap);
+    }
+
+    if(glassmaps.isEmpty()){
+        errorMessage = "No catalogs to plot";
+        return false;
+    }
+
+    customPlot->xAxis->setLabel(spec.xProperty);
+    customPlot->yAxis->setLabel(spec.yProperty);
+    customPlot->xAxis->setRangeReversed(spec.xReversed);
+    customPlot->rescaleAxes();
+    if(spec.hasXRange){
+        customPlot->xAxis->setRange(spec.xRange);
+    }
+    if(spec.hasYRange){
+        customPlot->yAxis->setRange(spec.yRange);
+    }
+
+    return true;
+}
+
+bool BatchRenderer::plotProperty(QCustomPlot *customPlot, const PlotSpec &spec, QString &errorMessage)
+{
+    std::shared_ptr<const CatalogSnapshot> snapshot = GlassCatalogManager::snapshot();
+
+    const bool transmittance = ("transmittance" == spec.type);
+
+    // same default axes as the plot windows.  The wavelength is in micron for the dispersion and in nm for the transmittance.
+    QCPRange xRange = spec.hasXRange ? spec.xRange : (transmittance ? QCPRange(300, 2000) : QCPRange(0.3, 1.0));
+    QCPRange yRange = spec.hasYRange ? spec.yRange : (transmittance ? QCPRange(0.0, 1.2)  : QCPRange(0.9, 2.1));
+
+    constexpr int sampleCount = 200;
+    QVector<double> vLambda(sampleCount), vLambdamicron(sampleCount);
+    for(int i = 0; i < sampleCount; i++){
+        vLambda[i] = xRange.lower + (xRange.upper - xRange.lower)*i/(sampleCount - 1);
+        vLambdamicron[i] = transmittance ? vLambda[i]/1000.0 : vLambda[i];
+    }
+
+    QCPColorGradient colorgrad;
+    colorgrad.loadPreset(QCPColorGradient::gpHues);
+
+    for(int i = 0; i < spec.glasses.size(); i++){
+        Glass* glass = snapshot->find(spec.glasses[i]);
+        if(!glass){
+            errorMessage = "Glass not found: " + spec.glasses[i];
+            return false;
+        }
+
+        QCPGraph* graph = customPlot->addGraph();
+        graph->setName(glass->fullName());
+        graph->setData(vLambda, transmittance ? glass->transmittance(vLambdamicron, spec.thickness) : glass->refractiveIndex(vLambdamicron));
+        graph->setPen(QPen(colorgrad.color(i, QCPRange(0, spec.glasses.size()))));
+    }
+
+    if(spec.glasses.isEmpty()){
+        errorMessage = "No glasses to plot";
+        return false;
+    }
+
+    customPlot->xAxis->setLabel(transmittance ? "Wavelength(nm)" : "Wavelength(um)");
+    customPlot->yAxis->setLabel(transmittance ? "Internal Transmittance" : "Refractive Index");
+    customPlot->xAxis->setRange(xRange);
+    customPlot->yAxis->setRange(yRange);
+
+    return true;
+}
@@ -0,0 +1,86 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef BATCH_RENDERER_H
+#define BATCH_RENDERER_H
+
+#include <QStringList>
+#include <QList>
+
+#include "qcustomplot.h"
+#include "qcpscatterchart.h"
+
+/**
+ * @brief Headless renderer of glass maps and property plots listed in a spec file
+ * @details The application run with "--render specs.ini" renders the plots without display on the offscreen platform.
+ *          Each group of the spec file is a plot, and the [General] group gives the catalog files.
+ *          The plots are distributed to the worker processes of the application, each of which loads the catalogs once
+ *          and renders its plots in the order of the temperature to reuse the table.
+ */
+class BatchRenderer
+{
+public:
+    /** Returns true if the arguments request batch rendering.  Called before QApplication is created. */
+    static bool isRequested(int argc, char *argv[]);
+
+    /**
+     * @brief Render the plots
+     * @param arguments command line arguments of the application
+     * @return exit code, 0 if all the plots were rendered
+     */
+    static int exec(const QStringList& arguments);
+
+private:
+    struct PlotSpec{
+        QString     name;        // group name
+        QString     type;        // "glassmap", "dispersion" or "transmittance"
+        QString     xProperty;   // glassmap only
+        QString     yProperty;
+        QCPRange    xRange;
+        QCPRange    yRange;
+        bool        hasXRange;
+        bool        hasYRange;
+        bool        xReversed;
+        QStringList suppliers;   // glassmap only, empty for all the catalogs
+        QStringList glasses;     // full names, property plots only
+        bool        labels;
+        bool        legend;
+        double      temperature;
+        double      thickness;   // mm, transmittance only
+        int         width;
+        int         height;
+        double      scale;       // resolution factor of the raster image
+        QString     outputPath;
+    };
+
+    static bool readSpecFile(const QString& specFilePath, QStringList& catalogFilePaths, QList<PlotSpec>& specs, QString& errorMessage);
+    static int  runWorkers(const QString& specFilePath, int jobCount);
+    static int  render(const QStringList& catalogFilePaths, const QList<PlotSpec>& specs);
+
+    static bool renderPlot(const PlotSpec& spec, QString& errorMessage);
+    static bool plotGlassmap(QCustomPlot* customPlot, const PlotSpec& spec, QList<QCPScatterChart*>& glassmaps, QString& errorMessage);
+    static bool plotProperty(QCustomPlot* customPlot, const PlotSpec& spec, QString& errorMessage);
+};
+
+#endif // BATCH_RENDERER_H
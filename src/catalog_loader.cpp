@@ -0,0 +1,105 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "catalog_loader.h"
+
+#include <QFileInfo>
+#include <QMutexLocker>
+
+#include "glass_catalog_manager.h"
+
+CatalogLoader::CatalogLoader(const QStringList &catalogFilePaths, QObject *parent) :
+    QObject(parent),
+    m_catalogFilePaths(catalogFilePaths),
+    m_canceled(0)
+{
+
+}
+
+CatalogLoader::~CatalogLoader()
+{
+    // catalogs which have not been taken
+    for(auto &cat : m_catalogs){
+        delete cat;
+    }
+    m_catalogs.clear();
+}
+
+void CatalogLoader::cancel()
+{
+    m_canceled.storeRelease(1);
+}
+
+bool CatalogLoader::isCanceled() const
+{
+    return (m_canceled.loadAcquire() != 0);
+}
+
+QList<GlassCatalog*> CatalogLoader::takeCatalogs(QStringList &filePaths)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QList<GlassCatalog*> catalogs = m_catalogs;
+    filePaths = m_loadedFilePaths;
+    m_catalogs.clear();
+    m_loadedFilePaths.clear();
+    return catalogs;
+}
+
+const ParseDiagnostics &CatalogLoader::diagnostics() const
+{
+    return m_diagnostics;
+}
+
+void CatalogLoader::run()
+{
+    const int fileCount = m_catalogFilePaths.size();
+
+    for(int i = 0; i < fileCount; i++)
+    {
+        // canceled between files
+        if(isCanceled()){
+            break;
+        }
+
+        emit progressChanged(i, fileCount, m_catalogFilePaths[i]);
+
+        GlassCatalog* catalog = GlassCatalogManager::loadCatalogFile(m_catalogFilePaths[i], m_diagnostics);
+
+        if(catalog){
+            QMutexLocker locker(&m_mutex);
+            m_catalogs.append(catalog);
+            m_loadedFilePaths.append(m_catalogFilePaths[i]);
+            locker.unlock();
+
+            emit catalogLoaded();
+        }
+    }
+
+    if(!isCanceled()){
+        emit progressChanged(fileCount, fileCount, QString());
+    }
+
+    emit finished();
+}
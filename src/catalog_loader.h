@@ -0,0 +1,79 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef CATALOG_LOADER_H
+#define CATALOG_LOADER_H
+
+#include <QObject>
+#include <QList>
+#include <QStringList>
+#include <QAtomicInt>
+#include <QMutex>
+
+#include "glass_catalog.h"
+
+/**
+ * @brief Worker to load catalog files in a background thread
+ * @details The loaded catalogs are kept in this object until they are taken by takeCatalogs(),
+ *          so that they can be published to GlassCatalogManager in the GUI thread while the other files are being loaded.
+ */
+class CatalogLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    CatalogLoader(const QStringList& catalogFilePaths, QObject* parent = nullptr);
+    ~CatalogLoader();
+
+    /** Request to stop loading.  This function is thread-safe. */
+    void cancel();
+    bool isCanceled() const;
+
+    /**
+     * @brief Take the ownership of the catalogs loaded since the last call.  This function is thread-safe.
+     * @param filePaths file path of each catalog taken
+     */
+    QList<GlassCatalog*> takeCatalogs(QStringList& filePaths);
+
+    /** Notable parse results of all the files.  Call after finished() has been emitted. */
+    const ParseDiagnostics& diagnostics() const;
+
+public slots:
+    void run();
+
+signals:
+    void progressChanged(int loadedCount, int totalCount, const QString& filePath);
+    void catalogLoaded();
+    void finished();
+
+private:
+    QStringList          m_catalogFilePaths;
+    QStringList          m_loadedFilePaths;
+    QList<GlassCatalog*> m_catalogs;
+    ParseDiagnostics     m_diagnostics;
+    QAtomicInt           m_canceled;
+    QMutex               m_mutex; // guards the catalogs not taken yet
+};
+
+#endif // CATALOG_LOADER_H
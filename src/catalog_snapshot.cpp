@@ -0,0 +1,78 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "catalog_snapshot.h"
+
+#include <atomic>
+
+namespace {
+
+std::atomic<quint64> lastSnapshotId(0);
+
+}
+
+CatalogSnapshot::CatalogSnapshot()
+{
+    m_id          = ++lastSnapshotId;
+    m_temperature = 25.0;
+    m_table       = GlassTable::build(m_catalogs, m_temperature, NormalLine::ReferenceK7F2);
+}
+
+CatalogSnapshot::CatalogSnapshot(const QList<std::shared_ptr<const GlassCatalog>> &catalogs, const QStringList &catalogFilePaths, double temperature, NormalLine::Reference normalLineReference)
+{
+    Q_ASSERT(catalogs.size() == catalogFilePaths.size());
+
+    m_id               = ++lastSnapshotId;
+    m_sharedCatalogs   = catalogs;
+    m_catalogFilePaths = catalogFilePaths;
+    m_temperature      = temperature;
+
+    m_catalogs.reserve(catalogs.size());
+    for(auto &cat : catalogs){
+        m_catalogs.append(cat.get());
+    }
+
+    m_table = GlassTable::build(m_catalogs, m_temperature, normalLineReference);
+}
+
+CatalogSnapshot::CatalogSnapshot(const CatalogSnapshot &base, NormalLine::Reference normalLineReference)
+{
+    m_id               = ++lastSnapshotId;
+    m_sharedCatalogs   = base.m_sharedCatalogs;
+    m_catalogs         = base.m_catalogs;
+    m_catalogFilePaths = base.m_catalogFilePaths;
+    m_temperature      = base.m_temperature;
+
+    // The refractive indices do not change, so that only the deviations are recomputed.
+    m_table = base.m_table->withNormalLineReference(normalLineReference);
+}
+
+Glass* CatalogSnapshot::find(const QString& fullName) const
+{
+    int row = m_table->findRow(fullName);
+    if(row < 0){
+        return nullptr;
+    }
+    return m_table->glass(row);
+}
@@ -0,0 +1,141 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef CATALOG_SNAPSHOT_H
+#define CATALOG_SNAPSHOT_H
+
+#include <memory>
+
+#include <QList>
+#include <QStringList>
+#include <QSharedPointer>
+
+#include "glass_catalog.h"
+#include "glass_table.h"
+
+/**
+ * @brief Immutable set of the catalogs published by GlassCatalogManager
+ * @details A snapshot is never modified after it is created.  A reload creates a new snapshot which shares the unchanged catalogs with the old one,
+ *          and the manager swaps the current snapshot atomically.  A reader holding a snapshot can use the catalogs, glasses and table in it
+ *          from any thread until it releases the snapshot.
+ */
+class CatalogSnapshot
+{
+public:
+    CatalogSnapshot();
+
+    /**
+     * @brief Create a snapshot and build the table.  This can be called from any thread.
+     * @param catalogs catalogs, which must not be modified after this call
+     * @param catalogFilePaths file path of each catalog
+     * @param temperature current temperature
+     * @param normalLineReference reference of the normal lines
+     */
+    CatalogSnapshot(const QList<std::shared_ptr<const GlassCatalog>>& catalogs, const QStringList& catalogFilePaths, double temperature, NormalLine::Reference normalLineReference);
+
+    /** Snapshot of the same catalogs whose deviation columns are recomputed from the other normal lines */
+    CatalogSnapshot(const CatalogSnapshot& base, NormalLine::Reference normalLineReference);
+
+    /** Serial number to identify the snapshot, which increases every time a snapshot is created */
+    inline quint64 id() const;
+
+    inline int           catalogCount() const;
+    inline bool          isEmpty() const;
+    inline const GlassCatalog* catalog(int catalogIndex) const;
+    inline const QList<const GlassCatalog*>& catalogList() const;
+    inline const std::shared_ptr<const GlassCatalog>& sharedCatalog(int catalogIndex) const;
+
+    inline QString            catalogFilePath(int catalogIndex) const;
+    inline const QStringList& catalogFilePaths() const;
+
+    inline QSharedPointer<const GlassTable> table() const;
+    inline double temperature() const;
+
+    /** Returns the glass of the name "productName_supplier", or nullptr if not found */
+    Glass* find(const QString& fullName) const;
+
+private:
+    quint64 m_id;
+    QList<std::shared_ptr<const GlassCatalog>> m_sharedCatalogs;
+    QList<const GlassCatalog*>                 m_catalogs;
+    QStringList                                m_catalogFilePaths;
+    QSharedPointer<const GlassTable>           m_table;
+    double                                     m_temperature;
+};
+
+
+quint64 CatalogSnapshot::id() const
+{
+    return m_id;
+}
+
+int CatalogSnapshot::catalogCount() const
+{
+    return m_catalogs.size();
+}
+
+bool CatalogSnapshot::isEmpty() const
+{
+    return m_catalogs.isEmpty();
+}
+
+const GlassCatalog* CatalogSnapshot::catalog(int catalogIndex) const
+{
+    return m_catalogs[catalogIndex];
+}
+
+const QList<const GlassCatalog*>& CatalogSnapshot::catalogList() const
+{
+    return m_catalogs;
+}
+
+const std::shared_ptr<const GlassCatalog>& CatalogSnapshot::sharedCatalog(int catalogIndex) const
+{
+    return m_sharedCatalogs[catalogIndex];
+}
+
+QString CatalogSnapshot::catalogFilePath(int catalogIndex) const
+{
+    if(catalogIndex < m_catalogFilePaths.size()){
+        return m_catalogFilePaths[catalogIndex];
+    }
+    return QString();
+}
+
+const QStringList& CatalogSnapshot::catalogFilePaths() const
+{
+    return m_catalogFilePaths;
+}
+
+QSharedPointer<const GlassTable> CatalogSnapshot::table() const
+{
+    return m_table;
+}
+
+double CatalogSnapshot::temperature() const
+{
+    return m_temperature;
+}
+
+#endif // CATALOG_SNAPSHOT_H
@@ -28,12 +28,14 @@
 #include <QListWidget>
 #include <QDialog>
 #include <QMenu>
+#include <QMdiSubWindow>
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QDebug>
 
 #include "glass_catalog_manager.h"
 #include "glass_datasheet_form.h"
+#include "glassmap_form.h"
 #include "catalog_view_setting_dialog.h"
 
 CatalogViewForm::CatalogViewForm(QMdiArea *parent) :
@@ -45,16 +47,27 @@ CatalogViewForm::CatalogViewForm(QMdiArea *parent) :
 
     m_parentMdiArea = parent;
 
+    // The catalogs are followed by "All Catalogs".
     m_comboBox = ui->comboBox_Supplyer;
-    for(int i = 0; i < GlassCatalogManager::catalogList().size(); i++){
-        m_comboBox->addItem(GlassCatalogManager::catalogList().at(i)->supplier());
-    }
+    updateCatalogList();
 
     QObject::connect(m_comboBox,                  SIGNAL(currentIndexChanged(int)), this, SLOT(update()));
     QObject::connect(ui->pushButton_showDatasheet,SIGNAL(clicked()),                this, SLOT(showDatasheet()));
     QObject::connect(ui->pushButton_Setting,      SIGNAL(clicked()),                this, SLOT(showSettingDlg()));
-
+    QObject::connect(ui->lineEdit_Filter,         SIGNAL(editingFinished()),        this, SLOT(update()));
+    QObject::connect(ui->lineEdit_Column,         SIGNAL(editingFinished()),        this, SLOT(update()));
+    QObject::connect(ui->checkBox_ShowOnMaps,     SIGNAL(toggled(bool)),            this, SLOT(update()));
+
+    m_overlayShown = false;
+    QString identifiers = "Identifiers: " + GlassExpression::identifiers().join(", ");
+    ui->lineEdit_Filter->setPlaceholderText("e.g. nd > 1.75 && vd < 30 && T(0.4um, 10mm) > 0.95");
+    ui->lineEdit_Filter->setToolTip(identifiers);
+    ui->lineEdit_Column->setPlaceholderText("e.g. (n(0.4) - n(0.7))/(nd - 1)");
+    ui->lineEdit_Column->setToolTip(identifiers);
+
+    m_model = new CatalogViewModel(this);
     m_table = ui->tableWidget;
+    m_table->setModel(m_model);
     m_table->setSortingEnabled(true);
 
     m_allPropertyList = QStringList({"nd",
@@ -63,6 +76,10 @@ CatalogViewForm::CatalogViewForm(QMdiArea *parent) :
                                      "ve",
                                      "PgF",
                                      "PCt_",
+                                     "PgF_",
+                                     "dPgF",
+                                     "dPCt_",
+                                     "dPgF_",
                                      "status",
                                      "individual comment",
                                      "MIL",
@@ -85,215 +102,135 @@ CatalogViewForm::CatalogViewForm(QMdiArea *parent) :
     m_table->setContextMenuPolicy(Qt::CustomContextMenu);
     QObject::connect(m_table, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(showContextMenuOnTable()));
 
+    // catalog files modified on disk
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(tableUpdated()), this, SLOT(onTableUpdated()));
+    }
+
     this->update();
 }
 
 CatalogViewForm::~CatalogViewForm()
 {
-    m_table->clear();
+    if(m_overlayShown){
+        setOverlayToGlassMaps(QStringList());
+    }
 
     delete ui;
 }
 
 void CatalogViewForm::update()
 {
-    setUpTable(m_currentPropertyList, GlassCatalogManager::catalogList().at( m_comboBox->currentIndex() ), m_currentDigit);
+    // The snapshot is held while the expressions evaluate n() and T() of the glasses.
+    std::shared_ptr<const CatalogSnapshot> snapshot = GlassCatalogManager::snapshot();
+    evaluateExpressions(snapshot);
+
+    // "All Catalogs" is placed after the catalogs.
+    int catalogIndex = m_comboBox->currentIndex();
+    if(catalogIndex >= snapshot->catalogCount()){
+        catalogIndex = -1;
+    }
+
+    QString columnLabel = m_columnExpression.isValid() ? m_columnExpression.text() : QString();
+    m_model->setUp(snapshot, catalogIndex, m_currentPropertyList, m_currentDigit, m_filterMask, columnLabel, m_columnValues);
 }
 
-void CatalogViewForm::addTableItem(int row, int col, QString str)
+void CatalogViewForm::updateCatalogList()
 {
-    QTableWidgetItem* item = new QTableWidgetItem();
-    item->setText(str);
-    m_table->setItem(row,col,item);
-}
+    QSharedPointer<const GlassTable> table = GlassCatalogManager::table();
+    if(!table){
+        return;
+    }
+
+    // keep the current selection
+    QString currentText = m_comboBox->currentText();
 
+    m_comboBox->blockSignals(true);
+    m_comboBox->clear();
+    for(int ci = 0; ci < table->catalogCount(); ci++){
+        m_comboBox->addItem(table->supplier(ci));
+    }
+    m_comboBox->addItem("All Catalogs");
+    m_comboBox->setCurrentIndex(qMax(0, m_comboBox->findText(currentText)));
+    m_comboBox->blockSignals(false);
+}
 
-void CatalogViewForm::setUpTable(QStringList properties, GlassCatalog* catalog, int digit)
+void CatalogViewForm::onTableUpdated()
 {
+    updateCatalogList();
+    update();
+}
 
-    /***************************************
-     *
-     * set table row, col, header labels
-     *
-     ***************************************/
-    QStringList headerLabels;
-    headerLabels.append("name");
-    for(int j = 0; j < properties.size(); j++)
-    {
-        if("status" == properties[j]){
-            headerLabels.append("status");
-        }
-        else if("individual comment" == properties[j]){
-            headerLabels.append("Individual Comment");
-        }
-        else if("MIL" == properties[j]){
-            headerLabels.append("MIL");
-        }
-        else if("nd" == properties[j]){
-            headerLabels.append("nd");
-        }
-        else if("ne" == properties[j]){
-            headerLabels.append("ne");
-        }
-        else if("vd" == properties[j]){
-            headerLabels.append("vd");
-        }
-        else if("ve" == properties[j]){
-            headerLabels.append("ve");
-        }
-        else if("PgF" == properties[j]){
-            headerLabels.append("PgF");
-        }
-        else if("PCt_" == properties[j]){
-            headerLabels.append("PCt_");
-        }
-        else if("Dispersion Formula" == properties[j]){
-            headerLabels.append("Dispersion Formula");
-        }
-        else if("Dispersion Coefficients" == properties[j]){
-            for (int ci = 0; ci<12 ;ci++ ) {
-                headerLabels.append("C" + QString::number(ci));
-            }
-        }
-        else if("Thermal Coefficients" == properties[j]){
-            headerLabels.append("D0");
-            headerLabels.append("D1");
-            headerLabels.append("E0");
-            headerLabels.append("E1");
-            headerLabels.append("Ltk");
-            headerLabels.append("T0");
-        }
-        else if("Low TCE" == properties[j]){
-            headerLabels.append("Low TCE");
-        }
-        else if("High TCE" == properties[j]){
-            headerLabels.append("High TCE");
-        }
-        else if("Relative Cost" == properties[j]){
-            headerLabels.append("Relative Cost");
-        }
-        else if("Climate Resist" == properties[j]){
-            headerLabels.append("Climate Resist");
-        }
-        else if("Acid Resist" == properties[j]){
-            headerLabels.append("Acid Resist");
-        }
-        else if("Alkali Resist" == properties[j]){
-            headerLabels.append("Alkali Resist");
+void CatalogViewForm::evaluateExpressions(const std::shared_ptr<const CatalogSnapshot>& snapshot)
+{
+    const GlassTable& table = *snapshot->table();
+    QStringList errors;
+
+    // The values are shared with the other forms through the manager.
+    m_filterMask.clear();
+    QString filterText = ui->lineEdit_Filter->text().trimmed();
+    if(!filterText.isEmpty()){
+        if(m_filter.compile(filterText)){
+            m_filterMask = GlassExpression::filter(*GlassCatalogManager::derivedColumn(snapshot, filterText));
         }
-        else if("Phosphate Resist" == properties[j]){
-            headerLabels.append("Phosphate Resist");
+        else{
+            errors.append("Filter: " + m_filter.errorMessage());
         }
     }
 
-    int rowCount    = catalog->glassCount();
-    int columnCount = headerLabels.size();
-    m_table->clear();
-    m_table->setSortingEnabled(false);
-    m_table->setColumnCount(columnCount);
-    m_table->setRowCount(rowCount);
-    m_table->setHorizontalHeaderLabels(headerLabels);
-
-
-    /*********************************
-     *
-     * fill in glass properties
-     *
-     *********************************/
-    Glass* glass;
-    int row, col;
-    for(int i = 0; i < rowCount; i++)
-    {
-        row = i;
-        glass = catalog->glass(i);
-
-        // glass name should be at the first column.
-        addTableItem(i,0,glass->productName());
-
-        // properties
-        col = 1;
-        for(int j = 0; j < properties.size(); j++)
-        {
-            if("status" == properties[j]){
-                addTableItem(row,col,glass->status());
-            }
-            else if("individual comment" == properties[j]){
-                addTableItem(row,col,glass->comment());
-            }
-            else if("MIL" == properties[j]){
-                addTableItem(row,col,glass->MIL());
-            }
-            else if("nd" == properties[j]){
-                addTableItem(row,col,numToQString(glass->getValue("nd"), 'f', digit));
-            }
-            else if("ne" == properties[j]){
-                addTableItem(row,col,numToQString(glass->getValue("ne"), 'f', digit));
-            }
-            else if("vd" == properties[j]){
-                addTableItem(row,col,numToQString(glass->getValue("vd"), 'f', digit));
-            }
-            else if("ve" == properties[j]){
-                addTableItem(row,col,numToQString(glass->getValue("ve"), 'f', digit));
-            }
-            else if("PgF" == properties[j]){
-                addTableItem(row,col,numToQString(glass->getValue("PgF"), 'f', digit));
-            }
-            else if("PCt_" == properties[j]){
-                addTableItem(row,col,numToQString(glass->getValue("PCt_"), 'f', digit));
-            }
-            else if("Dispersion Formula" == properties[j]){
-                addTableItem(row,col,glass->formulaName());
-            }
-            else if("Dispersion Coefficients" == properties[j]){
-                for (int ci = 0; ci<12 ;ci++ ) {
-                    addTableItem(row,col,numToQString(glass->dispersionCoef(ci), 'e', digit));
-                    col++;
-                }
-                col--;
-            }
-            else if("Thermal Coefficients" == properties[j]){
-                addTableItem(row, col,   numToQString(glass->D0(),'g',digit));
-                addTableItem(row, ++col, numToQString(glass->D1(),'g',digit));
-                addTableItem(row, ++col, numToQString(glass->E0(),'g',digit));
-                addTableItem(row, ++col, numToQString(glass->E1(),'g',digit));
-                addTableItem(row, ++col, numToQString(glass->Ltk(),'g',digit));
-                addTableItem(row, ++col, numToQString(glass->Tref(),'f',digit));
-            }
-            else if("Low TCE" == properties[j]){
-                addTableItem(row, col, numToQString(glass->lowTCE(), 'f', digit));
-            }
-            else if("High TCE" == properties[j]){
-                addTableItem(row, col, numToQString(glass->highTCE(), 'f', digit));
-            }
-            else if("Relative Cost" == properties[j]){
-                addTableItem(row, col, numToQString(glass->relCost(), 'f', digit));
-            }
-            else if("Climate Resist" == properties[j]){
-                addTableItem(row, col, numToQString(glass->climateResist(), 'f', digit));
-            }
-            else if("Acid Resist" == properties[j]){
-                addTableItem(row, col, numToQString(glass->acidResist(), 'f', digit));
-            }
-            else if("Alkali Resist" == properties[j]){
-                addTableItem(row, col, numToQString(glass->alkaliResist(), 'f', digit));
-            }
-            else if("Phosphate Resist" == properties[j]){
-                addTableItem(row, col, numToQString(glass->phosphateResist(), 'f', digit));
+    m_columnValues.reset();
+    QString columnText = ui->lineEdit_Column->text().trimmed();
+    if(columnText.isEmpty()){
+        m_columnExpression = GlassExpression();
+    }
+    else if(m_columnExpression.compile(columnText)){
+        m_columnValues = GlassCatalogManager::derivedColumn(snapshot, columnText);
+    }
+    else{
+        errors.append("Computed Column: " + m_columnExpression.errorMessage());
+    }
+
+    ui->label_ExpressionError->setText(errors.join("  "));
+
+    // the glasses passing the filter in all the catalogs
+    if(ui->checkBox_ShowOnMaps->isChecked() && !m_filterMask.isEmpty()){
+        QStringList fullNames;
+        for(int row = 0; row < m_filterMask.size(); row++){
+            if(m_filterMask[row]){
+                fullNames.append(table.fullName(row));
             }
-            col++;
         }
+        setOverlayToGlassMaps(fullNames);
+        m_overlayShown = true;
+    }
+    else if(m_overlayShown){
+        setOverlayToGlassMaps(QStringList());
+        m_overlayShown = false;
     }
+}
 
-    m_table->setSortingEnabled(true);
-    m_table->update();
+void CatalogViewForm::setOverlayToGlassMaps(const QStringList &fullNames)
+{
+    if(!m_parentMdiArea){
+        return;
+    }
+
+    for(auto subwindow : m_parentMdiArea->subWindowList()){
+        GlassMapForm* glassMapForm = qobject_cast<GlassMapForm*>(subwindow->widget());
+        if(glassMapForm){
+            glassMapForm->setOverlay("Filter", fullNames);
+        }
+    }
 }
 
 void CatalogViewForm::showDatasheet()
 {
-    // get catalog name and glass name of the current row
-    QString supplyername = m_comboBox->currentText();
-    QString productname    = m_table->item(m_table->currentRow(),0)->text();
-    QString fullname = productname + "_" + supplyername;
+    // get full name of the current row, which may be in any catalog
+    QString fullname = m_model->fullName(m_table->currentIndex().row());
+    if(fullname.isEmpty()){
+        return;
+    }
 
     // show glass datasheet form
     GlassDataSheetForm* subwindow = new GlassDataSheetForm(GlassCatalogManager::find(fullname), m_parentMdiArea);
@@ -30,10 +30,13 @@
 #include <QMdiArea>
 #include <QList>
 #include <QComboBox>
-#include <QtMath>
 
 #include "glass_catalog.h"
-#include "qcustomtablewidget.h"
+#include "glass_table.h"
+#include "catalog_snapshot.h"
+#include "glass_expression.h"
+#include "catalog_view_model.h"
+#include "qcustomtableview.h"
 
 namespace Ui {
 class CatalogViewForm;
@@ -49,36 +52,36 @@ public:
 
 private slots:
     void update();
-    void setUpTable(QStringList properties,GlassCatalog* catalog, int digit=6);
+    void updateCatalogList();
     void showDatasheet();
     void showSettingDlg();
     void showContextMenuOnTable();
     void exportCSV();
 
+    /** The rows are rebuilt from the new snapshot, which is cheap since no cell is created. */
+    void onTableUpdated();
+
 private:
     Ui::CatalogViewForm *ui;
 
-    QMdiArea*           m_parentMdiArea;
-    QCustomTableWidget* m_table;
-    QComboBox*          m_comboBox;
+    QMdiArea*         m_parentMdiArea;
+    QCustomTableView* m_table;
+    CatalogViewModel* m_model;
+    QComboBox*        m_comboBox;
 
     QStringList m_allPropertyList;
     QStringList m_currentPropertyList;
     int         m_currentDigit;
 
-    void addTableItem(int row, int col, QString str);
-    inline QString numToQString(double val, char fmt='f', int digit=6);
-};
-
+    // filter and computed column, evaluated over all the catalogs
+    GlassExpression m_filter;
+    GlassExpression m_columnExpression;
+    QVector<bool>   m_filterMask;   // empty if no filter
+    DerivedColumnCache::Column m_columnValues;
+    bool            m_overlayShown;
 
-QString CatalogViewForm::numToQString(double val, char fmt, int digit)
-{
-    if(qIsNaN(val)){
-        return "-";
-    }
-    else{
-        return QString::number(val,fmt,digit);
-    }
-}
+    void evaluateExpressions(const std::shared_ptr<const CatalogSnapshot>& snapshot);
+    void setOverlayToGlassMaps(const QStringList& fullNames);
+};
 
 #endif // CATALOG_VIEW_FORM_H
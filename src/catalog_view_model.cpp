@@ -0,0 +1,343 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "catalog_view_model.h"
+
+#include <algorithm>
+#include <QtMath>
+
+#include "glass.h"
+#include "glass_table.h"
+
+CatalogViewModel::CatalogViewModel(QObject *parent) :
+    QAbstractTableModel(parent),
+    m_digit(6),
+    m_sortColumn(-1),
+    m_sortOrder(Qt::AscendingOrder)
+{
+
+}
+
+void CatalogViewModel::setUp(const std::shared_ptr<const CatalogSnapshot> &snapshot, int catalogIndex,
+                             const QStringList &properties, int digit,
+                             const QVector<bool> &filterMask,
+                             const QString &computedLabel, const DerivedColumnCache::Column &computedValues)
+{
+    beginResetModel();
+
+    // The values read from the glasses are valid only for the same snapshot.
+    if(snapshot != m_snapshot){
+        m_glassNumbers.clear();
+        m_glassTexts.clear();
+    }
+
+    m_snapshot       = snapshot;
+    m_table          = snapshot->table();
+    m_computedValues = computedValues;
+    m_digit          = digit;
+
+    // The catalog is shown only if the rows come from all the catalogs.
+    int firstRow, lastRow;
+    if(catalogIndex < 0 || catalogIndex >= m_table->catalogCount()){
+        firstRow = 0;
+        lastRow  = m_table->rowCount();
+        setUpColumns(properties, true, computedLabel);
+    }
+    else{
+        firstRow = m_table->firstRow(catalogIndex);
+        lastRow  = firstRow + m_table->rowCount(catalogIndex);
+        setUpColumns(properties, false, computedLabel);
+    }
+
+    m_rows.clear();
+    m_rows.reserve(lastRow - firstRow);
+    for(int row = firstRow; row < lastRow; row++){
+        if(filterMask.isEmpty() || filterMask[row]){
+            m_rows.append(row);
+        }
+    }
+
+    sortRows();
+
+    endResetModel();
+}
+
+void CatalogViewModel::setUpColumns(const QStringList &properties, bool showCatalog, const QString &computedLabel)
+{
+    m_columns.clear();
+
+    // glass name should be at the first column.
+    m_columns.append({"name", KindName, 0, 0});
+    if(showCatalog){
+        m_columns.append({"catalog", KindCatalog, 0, 0});
+    }
+
+    for(auto &property : properties)
+    {
+        // numeric properties are read from the table
+        int tableColumn = GlassTable::columnIndex(property);
+        if(tableColumn >= 0){
+            m_columns.append({property, KindTable, tableColumn, 'f'});
+        }
+        else if("status" == property){
+            m_columns.append({"status", KindText, FieldStatus, 0});
+        }
+        else if("individual comment" == property){
+            m_columns.append({"Individual Comment", KindText, FieldComment, 0});
+        }
+        else if("MIL" == property){
+            m_columns.append({"MIL", KindText, FieldMIL, 0});
+        }
+        else if("Dispersion Formula" == property){
+            m_columns.append({"Dispersion Formula", KindText, FieldFormula, 0});
+        }
+        else if("Dispersion Coefficients" == property){
+            for(int ci = 0; ci < 12; ci++){
+                m_columns.append({"C" + QString::number(ci), KindNumber, FieldCoef0 + ci, 'e'});
+            }
+        }
+        else if("Thermal Coefficients" == property){
+            m_columns.append({"D0",  KindNumber, FieldD0,   'g'});
+            m_columns.append({"D1",  KindNumber, FieldD1,   'g'});
+            m_columns.append({"E0",  KindNumber, FieldE0,   'g'});
+            m_columns.append({"E1",  KindNumber, FieldE1,   'g'});
+            m_columns.append({"Ltk", KindNumber, FieldLtk,  'g'});
+            m_columns.append({"T0",  KindNumber, FieldTref, 'f'});
+        }
+    }
+
+    if(!computedLabel.isEmpty()){
+        m_columns.append({computedLabel, KindComputed, 0, 'g'});
+    }
+}
+
+int CatalogViewModel::tableRow(int row) const
+{
+    return m_rows.value(row, -1);
+}
+
+QString CatalogViewModel::fullName(int row) const
+{
+    if(row < 0 || row >= m_rows.size()){
+        return QString();
+    }
+    return m_table->fullName(m_rows[row]);
+}
+
+const QVector<double>* CatalogViewModel::numbers(const Column &column) const
+{
+    switch (column.kind) {
+    case KindTable:
+        return &m_table->column(column.index);
+    case KindComputed:
+        return m_computedValues.data();
+    case KindNumber:
+        break;
+    default:
+        return nullptr;
+    }
+
+    auto it = m_glassNumbers.find(column.index);
+    if(it == m_glassNumbers.end()){
+        QVector<double> values(m_table->rowCount(), NAN);
+        for(int row = 0; row < values.size(); row++){
+            Glass* glass = m_table->glass(row);
+            switch (column.index) {
+            case FieldD0:   values[row] = glass->D0();   break;
+            case FieldD1:   values[row] = glass->D1();   break;
+            case FieldE0:   values[row] = glass->E0();   break;
+            case FieldE1:   values[row] = glass->E1();   break;
+            case FieldLtk:  values[row] = glass->Ltk();  break;
+            case FieldTref: values[row] = glass->Tref(); break;
+            default:        values[row] = glass->dispersionCoef(column.index - FieldCoef0); break;
+            }
+        }
+        it = m_glassNumbers.insert(column.index, values);
+    }
+    return &it.value();
+}
+
+const QVector<QString>* CatalogViewModel::texts(const Column &column) const
+{
+    if(KindText != column.kind){
+        return nullptr;
+    }
+
+    auto it = m_glassTexts.find(column.index);
+    if(it == m_glassTexts.end()){
+        QVector<QString> values(m_table->rowCount());
+        for(int row = 0; row < values.size(); row++){
+            Glass* glass = m_table->glass(row);
+            switch (column.index) {
+            case FieldStatus:  values[row] = glass->status();      break;
+            case FieldComment: values[row] = glass->comment();     break;
+            case FieldMIL:     values[row] = glass->MIL();         break;
+            default:           values[row] = glass->formulaName(); break;
+            }
+        }
+        it = m_glassTexts.insert(column.index, values);
+    }
+    return &it.value();
+}
+
+QString CatalogViewModel::text(const Column &column, int tableRow) const
+{
+    switch (column.kind) {
+    case KindName:
+        return m_table->productName(tableRow);
+    case KindCatalog:
+        return m_table->supplier(m_table->catalogIndex(tableRow));
+    case KindText:
+        return texts(column)->at(tableRow);
+    default:
+        break;
+    }
+
+    const QVector<double>* values = numbers(column);
+    double val = values ? values->value(tableRow, NAN) : NAN;
+    if(qIsNaN(val)){
+        return "-";
+    }
+    return QString::number(val, column.format, m_digit);
+}
+
+void CatalogViewModel::sortRows()
+{
+    if(m_sortColumn < 0 || m_sortColumn >= m_columns.size()){
+        return;
+    }
+
+    const Column& column = m_columns[m_sortColumn];
+    const bool ascending = (Qt::AscendingOrder == m_sortOrder);
+
+    const QVector<double>* values = numbers(column);
+    if(values){
+        // NaN is placed at the end in both orders.
+        std::stable_sort(m_rows.begin(), m_rows.end(), [values, ascending](int a, int b){
+            double va = values->value(a, NAN);
+            double vb = values->value(b, NAN);
+            if(qIsNaN(va) || qIsNaN(vb)){
+                return !qIsNaN(va) && qIsNaN(vb);
+            }
+            return ascending ? (va < vb) : (va > vb);
+        });
+    }
+    else{
+        std::stable_sort(m_rows.begin(), m_rows.end(), [this, &column, ascending](int a, int b){
+            int c = QString::compare(text(column, a), text(column, b), Qt::CaseInsensitive);
+            return ascending ? (c < 0) : (c > 0);
+        });
+    }
+}
+
+void CatalogViewModel::sort(int column, Qt::SortOrder order)
+{
+    if(column < 0){
+        return;
+    }
+
+    // The view may request the sort before the columns are set up.
+    if(column >= m_columns.size()){
+        m_sortColumn = column;
+        m_sortOrder  = order;
+        return;
+    }
+
+    emit layoutAboutToBeChanged();
+
+    // The selection follows the glasses.
+    QModelIndexList oldIndexes = persistentIndexList();
+    QVector<int> oldTableRows;
+    for(auto &index : oldIndexes){
+        oldTableRows.append(m_rows.value(index.row(), -1));
+    }
+
+    m_sortColumn = column;
+    m_sortOrder  = order;
+    sortRows();
+
+    QVector<int> viewRows(m_table ? m_table->rowCount() : 0, -1);
+    for(int row = 0; row < m_rows.size(); row++){
+        viewRows[m_rows[row]] = row;
+    }
+
+    QModelIndexList newIndexes;
+    for(int i = 0; i < oldIndexes.size(); i++){
+        int row = (oldTableRows[i] < 0) ? -1 : viewRows[oldTableRows[i]];
+        newIndexes.append(row < 0 ? QModelIndex() : index(row, oldIndexes[i].column()));
+    }
+    changePersistentIndexList(oldIndexes, newIndexes);
+
+    emit layoutChanged();
+}
+
+int CatalogViewModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid()){
+        return 0;
+    }
+    return m_rows.size();
+}
+
+int CatalogViewModel::columnCount(const QModelIndex &parent) const
+{
+    if(parent.isValid()){
+        return 0;
+    }
+    return m_columns.size();
+}
+
+QVariant CatalogViewModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid() || index.row() >= m_rows.size() || index.column() >= m_columns.size()){
+        return QVariant();
+    }
+
+    const Column& column = m_columns[index.column()];
+
+    if(Qt::DisplayRole == role){
+        return text(column, m_rows[index.row()]);
+    }
+    else if(Qt::TextAlignmentRole == role){
+        if(KindTable == column.kind || KindNumber == column.kind || KindComputed == column.kind){
+            return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+        }
+    }
+
+    return QVariant();
+}
+
+QVariant CatalogViewModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(Qt::DisplayRole != role){
+        return QVariant();
+    }
+
+    if(Qt::Horizontal == orientation){
+        return (section < m_columns.size()) ? m_columns[section].label : QVariant();
+    }
+    else{
+        return section + 1;
+    }
+}
@@ -0,0 +1,130 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef CATALOG_VIEW_MODEL_H
+#define CATALOG_VIEW_MODEL_H
+
+#include <memory>
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+#include "catalog_snapshot.h"
+#include "derived_column_cache.h"
+
+/**
+ * @brief Table model of the glass properties listed in the catalog view
+ * @details The model refers to the columns of GlassTable and keeps only the table rows in the view order.
+ *          Columns which are not in the table, such as the dispersion coefficients, are read from the glasses when they are first shown or sorted.
+ *          Sorting permutes the row array by the numeric values, so the cells are formatted only when they are painted.
+ */
+class CatalogViewModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    CatalogViewModel(QObject* parent = nullptr);
+
+    /**
+     * @brief Rebuild the rows and columns.  The current sort order is kept.
+     * @param snapshot snapshot to be shown, which is held by the model
+     * @param catalogIndex index of the catalog, or -1 to show all the catalogs
+     * @param properties property names listed in the setting dialog
+     * @param digit number of the digits
+     * @param filterMask table rows passing the filter, empty if no filter
+     * @param computedLabel header label of the computed column, empty if none
+     * @param computedValues values of the computed column for all the table rows
+     */
+    void setUp(const std::shared_ptr<const CatalogSnapshot>& snapshot, int catalogIndex,
+               const QStringList& properties, int digit,
+               const QVector<bool>& filterMask,
+               const QString& computedLabel = QString(), const DerivedColumnCache::Column& computedValues = DerivedColumnCache::Column());
+
+    /** Row of the GlassTable shown at the row */
+    int tableRow(int row) const;
+
+    /** Full name of the glass shown at the row, such as "N-BK7_SCHOTT" */
+    QString fullName(int row) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+private:
+    enum Kind{
+        KindName,
+        KindCatalog,
+        KindTable,      // column of GlassTable
+        KindText,       // string read from the glass
+        KindNumber,     // number read from the glass
+        KindComputed    // computed column given by the expression
+    };
+
+    enum Field{
+        FieldStatus,
+        FieldComment,
+        FieldMIL,
+        FieldFormula,
+        FieldCoef0,
+        FieldD0 = FieldCoef0 + 12,
+        FieldD1,
+        FieldE0,
+        FieldE1,
+        FieldLtk,
+        FieldTref
+    };
+
+    struct Column{
+        QString label;
+        Kind    kind;
+        int     index;  // column of GlassTable or Field
+        char    format;
+    };
+
+    void setUpColumns(const QStringList& properties, bool showCatalog, const QString& computedLabel);
+    void sortRows();
+    const QVector<double>* numbers(const Column& column) const;
+    const QVector<QString>* texts(const Column& column) const;
+    QString text(const Column& column, int tableRow) const;
+
+    std::shared_ptr<const CatalogSnapshot> m_snapshot;
+    QSharedPointer<const GlassTable>       m_table;
+    DerivedColumnCache::Column             m_computedValues;
+
+    QVector<Column> m_columns;
+    QVector<int>    m_rows; // table rows in the view order
+    int             m_digit;
+
+    int           m_sortColumn;
+    Qt::SortOrder m_sortOrder;
+
+    // values read from the glasses for all the table rows, keyed by Field
+    mutable QHash<int, QVector<double>>  m_glassNumbers;
+    mutable QHash<int, QVector<QString>> m_glassTexts;
+};
+
+#endif // CATALOG_VIEW_MODEL_H
@@ -108,10 +108,15 @@ void CurveFittingDialog::addGlassForNewRow()
         if("Unknown" == glass->formulaName()){
             QMessageBox::warning(this,tr("Error"), "Could not get coordinates due to unknown dispersion formula");
         }
-        // add glass property for new row
+        // add glass property for new row.  Deviations from the normal lines are read from the table.
         else{
-            QString s1 = QString::number(glass->getValue(m_xDataName));
-            QString s2 = QString::number(glass->getValue(m_yDataName));
+            QSharedPointer<const GlassTable> table = GlassCatalogManager::table();
+            int row = table->findRow(glass->fullName());
+            const QVector<double>* xColumn = table->column(m_xDataName);
+            const QVector<double>* yColumn = table->column(m_yDataName);
+
+            QString s1 = QString::number((xColumn && row >= 0) ? xColumn->at(row) : glass->getValue(m_xDataName));
+            QString s2 = QString::number((yColumn && row >= 0) ? yColumn->at(row) : glass->getValue(m_yDataName));
             QString s3 = glass->fullName();
             addNewRow(s1, s2, s3);
         }
@@ -168,10 +173,8 @@ bool CurveFittingDialog::getFittingResult(QList<double>& result)
         y(i) = m_table->item(i,1)->text().toDouble();
     }
 
-    MatrixXd A = X.transpose()*X;
-    VectorXd b = (X.transpose())*y;
-    VectorXd beta = A.bdcSvd(ComputeThinU | ComputeThinV).solve(b);
-    //VectorXd beta = (X.transpose()*X).inverse()*(X.transpose())*y;
+    // QR of X itself, whose condition number is the square root of that of X^T X
+    VectorXd beta = X.colPivHouseholderQr().solve(y);
 
     // return fitting result
     result = {0.0, 0.0, 0.0, 0.0};
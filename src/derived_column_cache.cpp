@@ -0,0 +1,110 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "derived_column_cache.h"
+
+#include <cmath>
+
+#include <QMutexLocker>
+
+#include "glass_expression.h"
+
+DerivedColumnCache::DerivedColumnCache() :
+    m_snapshotId(0),
+    m_temperature(NAN)
+{
+}
+
+DerivedColumnCache::Column DerivedColumnCache::column(const std::shared_ptr<const CatalogSnapshot> &snapshot, const QString &property, QString *errorMessage)
+{
+    if(!snapshot){
+        return Column();
+    }
+
+    // Expressions differing only in the white spaces between the tokens share the column.
+    const QString key = GlassExpression::normalized(property);
+    const quint64 id  = snapshot->id();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        if(id == m_snapshotId && snapshot->temperature() == m_temperature){
+            auto it = m_columns.constFind(key);
+            if(it != m_columns.constEnd()){
+                if(errorMessage){
+                    *errorMessage = m_errors.value(key);
+                }
+                return it.value();
+            }
+        }
+    }
+
+    // computed out of the lock, since an expression may take a while
+    QString error;
+    Column values = compute(snapshot->table(), property, &error);
+    if(errorMessage){
+        *errorMessage = error;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if(id > m_snapshotId){
+        m_columns.clear();
+        m_errors.clear();
+        m_snapshotId  = id;
+        m_temperature = snapshot->temperature();
+    }
+    if(id == m_snapshotId){
+        m_columns.insert(key, values);
+        m_errors.insert(key, error);
+    }
+
+    return values;
+}
+
+void DerivedColumnCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_columns.clear();
+    m_errors.clear();
+}
+
+DerivedColumnCache::Column DerivedColumnCache::compute(const QSharedPointer<const GlassTable> &table, const QString &property, QString *errorMessage)
+{
+    if(!table){
+        return Column();
+    }
+
+    // A column of the table is shared without copy.  The deleter holds the table.
+    int c = GlassTable::columnIndex(property.simplified());
+    if(c >= 0){
+        return Column(&table->column(c), [table](const QVector<double>*){});
+    }
+
+    GlassExpression expression;
+    if(!expression.compile(property)){
+        *errorMessage = expression.errorMessage();
+        return Column();
+    }
+
+    return Column(new QVector<double>(expression.evaluate(*table)));
+}
@@ -0,0 +1,71 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef DERIVED_COLUMN_CACHE_H
+#define DERIVED_COLUMN_CACHE_H
+
+#include <memory>
+
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "catalog_snapshot.h"
+
+/**
+ * @brief Cache of the property columns derived from the table of a snapshot
+ * @details A column is keyed by the property, the temperature and the snapshot, and is computed on first use.
+ *          Only the columns of the newest snapshot requested are kept, and the columns of an older snapshot are computed without caching.
+ *          The functions are thread-safe.
+ */
+class DerivedColumnCache
+{
+public:
+    typedef QSharedPointer<const QVector<double>> Column;
+
+    DerivedColumnCache();
+
+    /**
+     * @brief Get the column of the property
+     * @param snapshot snapshot of the table.  The returned column keeps its table alive.
+     * @param property column name of the table, or expression of GlassExpression
+     * @param errorMessage message of the syntax error of the expression
+     * @return value of each row, or null if the property is invalid
+     */
+    Column column(const std::shared_ptr<const CatalogSnapshot>& snapshot, const QString& property, QString* errorMessage = nullptr);
+
+    void clear();
+
+private:
+    static Column compute(const QSharedPointer<const GlassTable>& table, const QString& property, QString* errorMessage);
+
+    QMutex                 m_mutex;
+    quint64                m_snapshotId;
+    double                 m_temperature;
+    QHash<QString, Column> m_columns;
+    QHash<QString, QString> m_errors;
+};
+
+#endif // DERIVED_COLUMN_CACHE_H
@@ -0,0 +1,508 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "dispersion_fitter.h"
+
+#include <QtConcurrent>
+#include <QtMath>
+#include <QtNumeric>
+
+#include "Eigen/Dense"
+
+using namespace Eigen;
+
+namespace {
+
+enum FormulaType{
+    PowerSeries,  // n^2 = sum c_i * L^p_i
+    Sellmeier,    // n^2 = offset + c_0 + sum B_k*L^2/(L^2 - C_k), with or without the constant term
+    Linear,       // n   = sum c_i * f_i(L)
+    Nonlinear     // others
+};
+
+struct FormulaModel{
+    int         index;
+    const char* name;
+    int         coefCount;
+    FormulaType type;
+};
+
+// same indices as Glass::setDispForm()
+const FormulaModel formulaModels[] = {
+    {1,   "Schott",                       6,  PowerSeries},
+    {2,   "Sellmeier1",                   6,  Sellmeier},
+    {3,   "Herzberger",                   6,  Linear},
+    {4,   "Sellmeier2",                   5,  Sellmeier},
+    {5,   "Conrady",                      3,  Linear},
+    {6,   "Sellmeier3",                   8,  Sellmeier},
+    {7,   "Handbook of Optics1",          4,  Nonlinear},
+    {8,   "Handbook of Optics2",          4,  Nonlinear},
+    {9,   "Sellmeier4",                   5,  Sellmeier},
+    {10,  "Extended1",                    8,  PowerSeries},
+    {11,  "Sellmeier5",                   10, Sellmeier},
+    {12,  "Extended2",                    8,  PowerSeries},
+    {13,  "Nikon Hikari",                 9,  PowerSeries},
+    {101, "Laurent",                      12, PowerSeries},
+    {102, "Glass Manufacturer Laurent",   7,  PowerSeries},
+    {103, "Glass Manufacturer Sellmeier", 12, Sellmeier},
+    {104, "Standard Sellmeier",           12, Sellmeier},
+    {105, "Cauchy",                       3,  Linear},
+    {106, "Hartman",                      3,  Nonlinear}
+};
+
+const FormulaModel* findModel(int formulaIndex)
+{
+    for(auto &m : formulaModels){
+        if(m.index == formulaIndex){
+            return &m;
+        }
+    }
+    return nullptr;
+}
+
+/** Exponents of the wavelength in the power series formulas */
+QVector<int> powerSeriesExponents(int formulaIndex)
+{
+    switch (formulaIndex) {
+    case 1:   return {0, 2, -2, -4, -6, -8};
+    case 10:  return {0, 2, -2, -4, -6, -8, -10, -12};
+    case 12:  return {0, 2, -2, -4, -6, -8, 4, 6};
+    case 13:  return {0, 2, 4, -2, -4, -6, -8, -10, -12};
+    case 101: return {0, 2, -2, -4, -6, -8, -10, -12, -14, -16, -18, -20};
+    case 102: return {0, 2, -2, -4, -6, -8, 4};
+    default:  return {};
+    }
+}
+
+/**
+ * Layout of the Sellmeier formulas
+ * offset: 1 or 0 added to n^2
+ * constant: true if c_0 is a constant term
+ * squaredC: true if the resonance wavelength is squared (Standard Sellmeier)
+ */
+void sellmeierLayout(int formulaIndex, double& offset, bool& constant, bool& squaredC)
+{
+    offset   = 1.0;
+    constant = false;
+    squaredC = false;
+
+    switch (formulaIndex) {
+    case 4:   constant = true;                 break; // Sellmeier2
+    case 9:   constant = true;  offset = 0.0;  break; // Sellmeier4
+    case 104: squaredC = true;                 break; // Standard Sellmeier
+    default:                                   break;
+    }
+}
+
+/** Basis functions of the formulas linear in the coefficients */
+void linearBasis(int formulaIndex, double L, double* f)
+{
+    switch (formulaIndex) {
+    case 3: // Herzberger
+    {
+        double H = 1/(L*L - 0.028);
+        f[0] = 1; f[1] = H; f[2] = H*H; f[3] = pow(L,2); f[4] = pow(L,4); f[5] = pow(L,6);
+        break;
+    }
+    case 5: // Conrady
+        f[0] = 1; f[1] = 1/L; f[2] = 1/pow(L,3.5);
+        break;
+    case 105: // Cauchy
+        f[0] = 1; f[1] = pow(L,-2); f[2] = pow(L,-4);
+        break;
+    default:
+        break;
+    }
+}
+
+/** Typical coefficients for the nonlinear formulas, close to an ordinary crown glass */
+QVector<double> typicalCoefficients(int formulaIndex)
+{
+    switch (formulaIndex) {
+    case 2:   return {1.04, 0.0060, 0.232, 0.0200, 1.01, 103.6};
+    case 4:   return {0.0, 1.27, 0.0090, 1.01, 103.6};
+    case 6:   return {1.04, 0.0060, 0.232, 0.0200, 1.01, 103.6, 0.0, 0.05};
+    case 7:   return {2.27, 0.0110, 0.0136, 0.0100};
+    case 8:   return {1.27, 1.01, 0.0090, 0.0100};
+    case 9:   return {1.0, 1.27, 0.0090, 1.01, 103.6};
+    case 11:  return {1.04, 0.0060, 0.232, 0.0200, 1.01, 103.6, 0.0, 0.05, 0.0, 0.002};
+    case 103: return {1.04, 0.0060, 0.232, 0.0200, 1.01, 103.6, 0.0, 0.05, 0.0, 0.002, 0.0, 200.0};
+    case 104: return {1.04, 0.0775, 0.232, 0.1414, 1.01, 10.18, 0.0, 0.2236, 0.0, 0.0447, 0.0, 14.14};
+    default:  return {};
+    }
+}
+
+}
+
+const QList<int>& DispersionFitter::formulaIndices()
+{
+    static QList<int> indices;
+    if(indices.isEmpty()){
+        for(auto &m : formulaModels){
+            indices.append(m.index);
+        }
+    }
+    return indices;
+}
+
+QString DispersionFitter::formulaName(int formulaIndex)
+{
+    const FormulaModel* m = findModel(formulaIndex);
+    return m ? QString(m->name) : QString("Unknown");
+}
+
+int DispersionFitter::coefficientCount(int formulaIndex)
+{
+    const FormulaModel* m = findModel(formulaIndex);
+    return m ? m->coefCount : 0;
+}
+
+double DispersionFitter::evaluate(int formulaIndex, double lambdamicron, const double *c, double *grad)
+{
+    const FormulaModel* m = findModel(formulaIndex);
+    if(!m){
+        return NAN;
+    }
+
+    const double L  = lambdamicron;
+    const double L2 = L*L;
+
+    switch (m->type) {
+    case PowerSeries:
+    {
+        const QVector<int> exps = powerSeriesExponents(formulaIndex);
+        double S = 0;
+        for(int i = 0; i < exps.size(); i++){
+            S += c[i]*pow(L, exps[i]);
+        }
+        double n = sqrt(S);
+        if(grad){
+            for(int i = 0; i < exps.size(); i++){
+                grad[i] = pow(L, exps[i])/(2*n);
+            }
+        }
+        return n;
+    }
+    case Sellmeier:
+    {
+        double offset;
+        bool   constant, squaredC;
+        sellmeierLayout(formulaIndex, offset, constant, squaredC);
+
+        double S = offset;
+        int    first = 0;
+        if(constant){
+            S += c[0];
+            if(grad) grad[0] = 1;
+            first = 1;
+        }
+        for(int i = first; i + 1 < m->coefCount; i += 2){
+            double B = c[i];
+            double C = squaredC ? c[i+1]*c[i+1] : c[i+1];
+            double d = L2 - C;
+            S += B*L2/d;
+            if(grad){
+                grad[i]   = L2/d;
+                grad[i+1] = B*L2/(d*d)*(squaredC ? 2*c[i+1] : 1.0);
+            }
+        }
+        double n = sqrt(S);
+        if(grad){
+            for(int i = 0; i < m->coefCount; i++){
+                grad[i] /= (2*n);
+            }
+        }
+        return n;
+    }
+    case Linear:
+    {
+        double f[6];
+        linearBasis(formulaIndex, L, f);
+        double n = 0;
+        for(int i = 0; i < m->coefCount; i++){
+            n += c[i]*f[i];
+            if(grad) grad[i] = f[i];
+        }
+        return n;
+    }
+    case Nonlinear:
+        if(7 == formulaIndex){ // Handbook of Optics1: n^2 = c0 + c1/(L^2 - c2) - c3*L^2
+            double d = L2 - c[2];
+            double n = sqrt(c[0] + c[1]/d - c[3]*L2);
+            if(grad){
+                grad[0] = 1/(2*n);
+                grad[1] = 1/d/(2*n);
+                grad[2] = c[1]/(d*d)/(2*n);
+                grad[3] = -L2/(2*n);
+            }
+            return n;
+        }
+        else if(8 == formulaIndex){ // Handbook of Optics2: n^2 = c0 + c1*L^2/(L^2 - c2) - c3*L^2
+            double d = L2 - c[2];
+            double n = sqrt(c[0] + c[1]*L2/d - c[3]*L2);
+            if(grad){
+                grad[0] = 1/(2*n);
+                grad[1] = L2/d/(2*n);
+                grad[2] = c[1]*L2/(d*d)/(2*n);
+                grad[3] = -L2/(2*n);
+            }
+            return n;
+        }
+        else if(106 == formulaIndex){ // Hartman: n = c0 + c1/(c2 - L)^1.2
+            double d = c[2] - L;
+            double n = c[0] + c[1]*pow(d, -1.2);
+            if(grad){
+                grad[0] = 1;
+                grad[1] = pow(d, -1.2);
+                grad[2] = -1.2*c[1]*pow(d, -2.2);
+            }
+            return n;
+        }
+        break;
+    }
+
+    return NAN;
+}
+
+QVector<double> DispersionFitter::initialCoefficients(int formulaIndex, const QVector<Sample> &samples)
+{
+    const FormulaModel* m = findModel(formulaIndex);
+    const int N = samples.size();
+    const int M = m->coefCount;
+
+    if(PowerSeries == m->type || Linear == m->type){
+        // linear least squares of n^2 (power series) or n (linear)
+        MatrixXd A(N, M);
+        VectorXd b(N);
+        const QVector<int> exps = powerSeriesExponents(formulaIndex);
+        for(int i = 0; i < N; i++){
+            double L = samples[i].lambdamicron;
+            if(PowerSeries == m->type){
+                for(int j = 0; j < M; j++){
+                    A(i, j) = pow(L, exps[j]);
+                }
+                b(i) = samples[i].index*samples[i].index;
+            }
+            else{
+                double f[6];
+                linearBasis(formulaIndex, L, f);
+                for(int j = 0; j < M; j++){
+                    A(i, j) = f[j];
+                }
+                b(i) = samples[i].index;
+            }
+        }
+        VectorXd x = A.bdcSvd(ComputeThinU | ComputeThinV).solve(b);
+
+        QVector<double> coefs(M);
+        for(int j = 0; j < M; j++){
+            coefs[j] = x(j);
+        }
+        return coefs;
+    }
+
+    if(106 == formulaIndex){
+        // Hartman is linear in c0 and c1 for a fixed c2, which must be larger than the wavelengths.
+        double lambdaMax = 0;
+        for(auto &s : samples){
+            lambdaMax = qMax(lambdaMax, s.lambdamicron);
+        }
+
+        QVector<double> best;
+        double bestCost = qInf();
+        for(int k = 0; k < 80; k++){
+            double c2 = lambdaMax + 0.01*pow(10.0, k/20.0);
+            MatrixXd A(N, 2);
+            VectorXd b(N);
+            for(int i = 0; i < N; i++){
+                A(i, 0) = 1;
+                A(i, 1) = pow(c2 - samples[i].lambdamicron, -1.2);
+                b(i)    = samples[i].index;
+            }
+            VectorXd x = A.colPivHouseholderQr().solve(b);
+            double cost = (A*x - b).squaredNorm();
+            if(cost < bestCost){
+                bestCost = cost;
+                best = {x(0), x(1), c2};
+            }
+        }
+        return best;
+    }
+
+    return typicalCoefficients(formulaIndex);
+}
+
+DispersionFitter::Result DispersionFitter::fit(int formulaIndex, const QVector<Sample> &samples, const QVector<double> &initialCoefs, int maxIterations)
+{
+    Result result;
+    result.ok             = false;
+    result.iterations     = 0;
+    result.rms            = NAN;
+    result.maxAbsResidual = NAN;
+
+    const FormulaModel* m = findModel(formulaIndex);
+    if(!m){
+        result.message = "Unsupported formula";
+        return result;
+    }
+
+    const int N = samples.size();
+    const int M = m->coefCount;
+    if(N < M){
+        result.message = QString("At least %1 samples are required").arg(M);
+        return result;
+    }
+
+    QVector<double> initial = (initialCoefs.size() >= M) ? initialCoefs.mid(0, M) : initialCoefficients(formulaIndex, samples);
+    VectorXd p(M);
+    for(int j = 0; j < M; j++){
+        p(j) = initial[j];
+    }
+
+    // residuals and Jacobian at p, returns the cost
+    VectorXd r(N);
+    MatrixXd J(N, M);
+    auto evaluateAll = [&](const VectorXd& params, VectorXd& res, MatrixXd* jac){
+        double g[12];
+        for(int i = 0; i < N; i++){
+            res(i) = evaluate(formulaIndex, samples[i].lambdamicron, params.data(), jac ? g : nullptr) - samples[i].index;
+            if(jac){
+                for(int j = 0; j < M; j++){
+                    (*jac)(i, j) = g[j];
+                }
+            }
+        }
+        return res.allFinite() ? 0.5*res.squaredNorm() : qInf();
+    };
+
+    double cost = evaluateAll(p, r, &J);
+    if(!qIsFinite(cost)){
+        result.message = "Invalid initial coefficients";
+        return result;
+    }
+
+    // Levenberg-Marquardt with Marquardt's diagonal scaling and Nielsen's damping update
+    constexpr double gradTolerance = 1e-15;
+    constexpr double stepTolerance = 1e-12;
+    constexpr double costTolerance = 1e-10;
+
+    MatrixXd A = J.transpose()*J;
+    VectorXd g = J.transpose()*r;
+    double   mu = 1e-3;
+    double   nu = 2.0;
+
+    VectorXd rNew(N);
+    MatrixXd JNew(N, M);
+
+    bool converged = false;
+    int  iter = 0;
+    for(; iter < maxIterations; iter++){
+        if(g.lpNorm<Infinity>() < gradTolerance){
+            converged = true;
+            break;
+        }
+
+        // The damped normal equations (A + mu*D)*step = -g are solved as the least squares of [J; sqrt(mu*D)]*step = [-r; 0],
+        // since A is ill-conditioned for the Sellmeier formulas with a far infrared term.
+        MatrixXd Jd(N + M, M);
+        VectorXd rd = VectorXd::Zero(N + M);
+        Jd.topRows(N) = J;
+        Jd.bottomRows(M).setZero();
+        for(int j = 0; j < M; j++){
+            Jd(N + j, j) = sqrt(mu*qMax(A(j, j), 1e-30));
+        }
+        rd.head(N) = -r;
+        VectorXd step = Jd.colPivHouseholderQr().solve(rd);
+
+        if(step.norm() <= stepTolerance*(p.norm() + stepTolerance)){
+            converged = true;
+            break;
+        }
+
+        VectorXd pNew    = p + step;
+        double   costNew = evaluateAll(pNew, rNew, &JNew);
+
+        // gain ratio of the actual and predicted reduction
+        double predicted = 0.5*step.dot(mu*A.diagonal().cwiseMax(1e-30).cwiseProduct(step) - g);
+        double rho = (predicted > 0) ? (cost - costNew)/predicted : -1;
+
+        if(qIsFinite(costNew) && rho > 0){
+            p = pNew;
+            r = rNew;
+            J = JNew;
+            A = J.transpose()*J;
+            g = J.transpose()*r;
+
+            bool small = (cost - costNew) <= costTolerance*cost;
+            cost = costNew;
+            mu  *= qMax(1.0/3.0, 1 - pow(2*rho - 1, 3));
+            nu   = 2.0;
+
+            if(small){
+                converged = true;
+                iter++;
+                break;
+            }
+        }
+        else{
+            mu *= nu;
+            nu *= 2.0;
+        }
+    }
+
+    result.ok         = true;
+    result.iterations = iter;
+    result.message    = converged ? "Converged" : "Reached maximum iterations";
+    result.coefs.resize(M);
+    for(int j = 0; j < M; j++){
+        result.coefs[j] = p(j);
+    }
+
+    result.residuals.resize(N);
+    result.maxAbsResidual = 0;
+    for(int i = 0; i < N; i++){
+        result.residuals[i]   = r(i);
+        result.maxAbsResidual = qMax(result.maxAbsResidual, qAbs(r(i)));
+    }
+    result.rms = sqrt(r.squaredNorm()/N);
+
+    return result;
+}
+
+QVector<DispersionFitter::Result> DispersionFitter::fitBatch(int formulaIndex, const QVector< QVector<Sample> > &lots, const QVector<double> &initialCoefs, int maxIterations)
+{
+    QVector<Result> results(lots.size());
+
+    QVector<int> indices(lots.size());
+    for(int i = 0; i < indices.size(); i++){
+        indices[i] = i;
+    }
+
+    Result* out = results.data();
+    QtConcurrent::blockingMap(indices, [&](int i){
+        out[i] = fit(formulaIndex, lots.at(i), initialCoefs, maxIterations);
+    });
+
+    return results;
+}
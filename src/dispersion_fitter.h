@@ -0,0 +1,81 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef DISPERSION_FITTER_H
+#define DISPERSION_FITTER_H
+
+#include <QString>
+#include <QList>
+#include <QVector>
+
+/**
+ * @brief Nonlinear least squares fitting of dispersion formulas to measured refractive indices
+ * @details The coefficients are fitted by Levenberg-Marquardt with the analytic Jacobian of each formula.
+ *          Formulas are identified by the same index as Glass::setDispForm().
+ *          Formulas linear in the coefficients (or in the squared index) are initialized by linear least squares,
+ *          and the others by the given coefficients or typical values.
+ */
+class DispersionFitter
+{
+public:
+    struct Sample{
+        double lambdamicron;
+        double index;
+    };
+
+    struct Result{
+        bool            ok;
+        QString         message;
+        int             iterations;
+        QVector<double> coefs;
+        QVector<double> residuals; // fitted minus measured, for each sample
+        double          rms;
+        double          maxAbsResidual;
+    };
+
+    /** Indices of the formulas which can be fitted */
+    static const QList<int>& formulaIndices();
+    static QString formulaName(int formulaIndex);
+    static int     coefficientCount(int formulaIndex);
+
+    /**
+     * @brief Refractive index and its derivatives with respect to the coefficients
+     * @param grad derivatives, whose size is coefficientCount().  Not computed if nullptr.
+     */
+    static double evaluate(int formulaIndex, double lambdamicron, const double* coefs, double* grad = nullptr);
+
+    /**
+     * @brief Fit a formula to the samples
+     * @param initialCoefs initial coefficients, empty to use the default
+     */
+    static Result fit(int formulaIndex, const QVector<Sample>& samples, const QVector<double>& initialCoefs = QVector<double>(), int maxIterations = 200);
+
+    /** Fit a formula to each set of samples in parallel */
+    static QVector<Result> fitBatch(int formulaIndex, const QVector< QVector<Sample> >& lots, const QVector<double>& initialCoefs = QVector<double>(), int maxIterations = 200);
+
+private:
+    static QVector<double> initialCoefficients(int formulaIndex, const QVector<Sample>& samples);
+};
+
+#endif // DISPERSION_FITTER_H
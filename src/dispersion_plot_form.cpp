@@ -123,6 +123,14 @@ DispersionPlotForm::DispersionPlotForm(QWidget *parent) :
     m_editYmax = ui->lineEdit_Ymax;
     m_defaultXrange = QCPRange(0.3, 1.0);
     m_defaultYrange = QCPRange(0.9, 2.1);
+
+    // catalog files modified on disk
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(glassesRemoved(int,QStringList)), this, SLOT(onGlassesRemoved(int,QStringList)));
+        QObject::connect(manager, SIGNAL(glassesChanged(int,QStringList)), this, SLOT(onGlassesChanged(int,QStringList)));
+    }
+
     setDefault();
 }
 
@@ -132,7 +140,7 @@ DispersionPlotForm::~DispersionPlotForm()
     m_customPlot->clearGraphs();
     m_customPlot->clearItems();
     m_customPlot = nullptr;
-    m_plotDataTable->clear();
+    m_plotDataModel->clear();
     m_tableCoefs->clear();
 
     delete ui;
@@ -230,21 +238,12 @@ void DispersionPlotForm::on_comboBoxChanged()
     updateAll();
 }
 
-QVector<double> DispersionPlotForm::computeUserDefinedCurve(const QVector<double>& xdata)
+QVector<double> DispersionPlotForm::computeUserDefinedCurve(int formulaNumber, const QVector<double>& coefs, const QVector<double>& xdata, double temperature)
 {
-    // get coefficients
-    QVector<double> coefs(12);
-    for(int i = 0; i < 12; i++){
-        coefs[i] = m_tableCoefs->item(i,0)->text().toDouble();
-    }
-
-
     // compute y data
     int npts = xdata.size();
     QVector<double> ydata(npts);
 
-    int formulaNumber = m_comboBoxFormula->currentIndex();
-
     if(formulaNumber == 0) // polynomial
     {
         double x,y;
@@ -271,21 +270,21 @@ QVector<double> DispersionPlotForm::computeUserDefinedCurve(const QVector<double
 
         Glass dummyGlass;
         dummyGlass.setDispForm(formulaNumber);
-        for(int i = 0; i < m_tableCoefs->rowCount(); i++) {
-            dummyGlass.setDispCoef(i,m_tableCoefs->item(i,0)->text().toDouble());
+        for(int i = 0; i < coefs.size(); i++) {
+            dummyGlass.setDispCoef(i,coefs[i]);
         }
 
-        ydata = dummyGlass.refractiveIndex(xdata);
+        ydata = dummyGlass.refractiveIndex(xdata, temperature);
     }
     else // formula in CODEV format
     {
         Glass dummyGlass;
         dummyGlass.setDispForm(formulaNumber - 12 + 100 );
-        for(int i = 0; i < m_tableCoefs->rowCount(); i++) {
-            dummyGlass.setDispCoef(i,m_tableCoefs->item(i,0)->text().toDouble());
+        for(int i = 0; i < coefs.size(); i++) {
+            dummyGlass.setDispCoef(i,coefs[i]);
         }
 
-        ydata = dummyGlass.refractiveIndex(xdata);
+        ydata = dummyGlass.refractiveIndex(xdata, temperature);
     }
 
     return ydata;
@@ -326,69 +325,66 @@ void DispersionPlotForm::addGraph()
 void DispersionPlotForm::updateAll()
 {
     m_customPlot->clearGraphs();
-    m_plotDataTable->clear();
 
-    double          plotStep      = ui->lineEdit_PlotStep->text().toDouble();
-    QVector<double> vLambdamicron = getVectorFromRange(m_customPlot->xAxis->range(), plotStep);
-    int             dataCount     = vLambdamicron.size();
-    QVector<double> ydata;
-    QCPGraph*       graph;
+    // The glasses are held by the snapshot while the curves are sampled in the background.
+    // The samplers use the temperature of the snapshot, since the current temperature may be changed by the GUI thread.
+    std::shared_ptr<const CatalogSnapshot> snapshot = GlassCatalogManager::snapshot();
+    double temperature = snapshot->temperature();
 
-    Glass* currentGlass;
+    QList<QCPGraph*>    graphs;
+    QList<CurveSampler> samplers;
+    QCPGraph*           graph;
 
-    int rowCount    = dataCount;
-    int columnCount = m_glassList.size() + 1+1; // wvl + glasses + curve
-    m_plotDataTable->setRowCount(rowCount);
-    m_plotDataTable->setColumnCount(columnCount);
+    Glass* currentGlass;
 
+    // columns of the table: wvl + glasses + curve
     QStringList header = QStringList() << "Wavelength(um)";
 
-
-    // replot all graphs and recreate tables
     int digit = ui->spinBox_Digit->value();
 
-    int i,j;
+    int i;
     for(i = 0; i < m_glassList.size(); i++)
     {
         currentGlass = m_glassList[i];
 
         // graphs
-        ydata = currentGlass->refractiveIndex(vLambdamicron);
         graph = m_customPlot->addGraph();
         graph->setName(currentGlass->fullName());
-        graph->setData(vLambdamicron, ydata);
         graph->setPen( QPen(getColorFromIndex(i, m_maxGraphCount)) );
         graph->setVisible(true);
+        graphs.append(graph);
+
+        // refractive index
+        samplers.append([currentGlass, snapshot, temperature](const QVector<double>& vLambdamicron){
+            return currentGlass->refractiveIndex(vLambdamicron, temperature);
+        });
 
         // table
         header << currentGlass->productName();
-        for(j = 0; j< rowCount; j++)
-        {
-            setValueToCell(j, 0,   vLambdamicron[j], digit );  // wavelength
-            setValueToCell(j, i+1, ydata[j],         digit );  // refractive index
-        }
     }
 
     // user defined curve
     header << "curve";
     if(m_chkCurve->checkState())
     {
-        ydata = computeUserDefinedCurve(vLambdamicron);
         graph = m_customPlot->addGraph();
         graph->setName("User Defined Curve");
-        graph->setData(vLambdamicron, ydata);
         graph->setVisible(true);
         graph->setPen(QPen(Qt::black));
+        graphs.append(graph);
 
-        for(i = 0; i < dataCount; i++)
-        {
-            setValueToCell(i, columnCount-1, ydata[i], digit );
+        // coefficients are read here since the sampler does not touch the widgets
+        int formulaNumber = m_comboBoxFormula->currentIndex();
+        QVector<double> coefs(12);
+        for(i = 0; i < 12; i++){
+            coefs[i] = m_tableCoefs->item(i,0)->text().toDouble();
         }
+        samplers.append([formulaNumber, coefs, temperature](const QVector<double>& vLambdamicron){
+            return computeUserDefinedCurve(formulaNumber, coefs, vLambdamicron, temperature);
+        });
     }
 
-    m_plotDataTable->setHorizontalHeaderLabels(header);
-
-    m_customPlot->replot();
+    startSampling(graphs, samplers, header, digit);
 }
 
 void DispersionPlotForm::deleteGraph()
@@ -416,12 +412,13 @@ void DispersionPlotForm::deleteGraph()
 
 void DispersionPlotForm::clearAll()
 {
+    cancelSampling();
     m_glassList.clear();
     m_customPlot->clearGraphs();
     m_customPlot->clearItems();
     m_customPlot->clearPlottables();
     m_customPlot->replot();
-    m_plotDataTable->clear();
+    m_plotDataModel->clear();
 
     m_chkCurve->setCheckState(Qt::Unchecked);
     for(int i = 0;i < m_tableCoefs->rowCount(); i++){
@@ -431,3 +428,34 @@ void DispersionPlotForm::clearAll()
     }
 }
 
+
+void DispersionPlotForm::onGlassesRemoved(int catalogIndex, const QStringList& glassNames)
+{
+    bool found = false;
+    for(int i = m_glassList.size()-1; i >= 0; i--){
+        if(GlassCatalogManager::isListed(m_glassList[i], catalogIndex, glassNames)){
+            m_glassList.removeAt(i);
+            found = true;
+        }
+    }
+
+    if(found){
+        updateAll();
+    }
+}
+
+void DispersionPlotForm::onGlassesChanged(int catalogIndex, const QStringList& glassNames)
+{
+    // The modified glasses are new objects in the new snapshot.
+    bool found = false;
+    for(auto &g : m_glassList){
+        if(GlassCatalogManager::isListed(g, catalogIndex, glassNames)){
+            g = GlassCatalogManager::find(g->fullName());
+            found = true;
+        }
+    }
+
+    if(found){
+        updateAll();
+    }
+}
@@ -52,6 +52,8 @@ private slots:
     void deleteGraph() override;
     void updateAll() override;
     void clearAll() override;
+    void onGlassesRemoved(int catalogIndex, const QStringList& glassNames);
+    void onGlassesChanged(int catalogIndex, const QStringList& glassNames);
 
 private:
     Ui::DispersionPlotForm *ui;
@@ -62,7 +64,14 @@ private:
 
     QList<Glass*>  m_glassList;
 
-    QVector<double> computeUserDefinedCurve(const QVector<double>& xdata);
+    /**
+     * @brief Compute the user defined curve.  This can be called from any thread.
+     * @param formulaNumber index of the formula in the combobox
+     * @param coefs coefficients
+     * @param xdata wavelengths in micron
+     * @param temperature temperature at which the indices are computed
+     */
+    static QVector<double> computeUserDefinedCurve(int formulaNumber, const QVector<double>& coefs, const QVector<double>& xdata, double temperature);
 
 };
 
@@ -0,0 +1,225 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "dispersion_similarity_engine.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include <QtConcurrent>
+
+#include "glass.h"
+
+#include "Eigen/Dense"
+
+using namespace Eigen;
+
+DispersionSimilarityEngine::DispersionSimilarityEngine()
+{
+    m_settings = Settings{0.4, 0.7, 32, 6};
+    m_explainedVariance = 0.0;
+}
+
+QSharedPointer<const GlassTable> DispersionSimilarityEngine::table() const
+{
+    return m_snapshot ? m_snapshot->table() : QSharedPointer<const GlassTable>();
+}
+
+void DispersionSimilarityEngine::prepare(const std::shared_ptr<const CatalogSnapshot> &snapshot, const Settings &settings)
+{
+    if(snapshot == m_snapshot &&
+            settings.lambdaMin      == m_settings.lambdaMin &&
+            settings.lambdaMax      == m_settings.lambdaMax &&
+            settings.sampleCount    == m_settings.sampleCount &&
+            settings.componentCount == m_settings.componentCount){
+        return;
+    }
+
+    m_snapshot = snapshot;
+    m_settings = settings;
+    rebuild();
+}
+
+void DispersionSimilarityEngine::rebuild()
+{
+    m_curveIndices.clear();
+    m_curveRows.clear();
+    m_curves.clear();
+    m_coords.clear();
+    m_tree.clear();
+    m_explainedVariance = 0.0;
+
+    const GlassTable* table = m_snapshot ? m_snapshot->table().data() : nullptr;
+    const int S = qMax(2, m_settings.sampleCount);
+    if(!table || !(m_settings.lambdaMin < m_settings.lambdaMax)){
+        return;
+    }
+
+    m_wavelengths.resize(S);
+    for(int j = 0; j < S; j++){
+        m_wavelengths[j] = m_settings.lambdaMin + (m_settings.lambdaMax - m_settings.lambdaMin)*j/(S - 1);
+    }
+
+    const int rowCount = table->rowCount();
+    m_curveIndices.fill(-1, rowCount);
+    for(int row = 0; row < rowCount; row++){
+        if(table->isValid(row)){
+            m_curveIndices[row] = m_curveRows.size();
+            m_curveRows.append(row);
+        }
+    }
+
+    // Every glass is sampled once, in parallel.
+    const int N = m_curveRows.size();
+    m_curves.resize(N*S);
+    {
+        QVector<int> indices(N);
+        for(int i = 0; i < N; i++){
+            indices[i] = i;
+        }
+        double*        curves      = m_curves.data();
+        const double*  wavelengths = m_wavelengths.constData();
+        const int*     rows        = m_curveRows.constData();
+        const double   temperature = table->temperature(); // not the current one, which may change while sampling
+        QtConcurrent::blockingMap(indices, [&](int i){
+            const Glass* g = table->glass(rows[i]);
+            for(int j = 0; j < S; j++){
+                curves[i*S + j] = g->refractiveIndex(wavelengths[j], temperature);
+            }
+        });
+    }
+
+    // Curves diverging in the band (e.g. a pole of the formula) cannot be indexed.
+    for(int i = N - 1; i >= 0; i--){
+        if(!std::all_of(m_curves.constBegin() + i*S, m_curves.constBegin() + (i + 1)*S, [](double n){ return std::isfinite(n); })){
+            m_curveIndices[m_curveRows[i]] = -1;
+            m_curveRows.removeAt(i);
+            m_curves.remove(i*S, S);
+        }
+    }
+    for(int i = 0; i < m_curveRows.size(); i++){
+        m_curveIndices[m_curveRows[i]] = i;
+    }
+
+    const int n = m_curveRows.size();
+    if(n < 2){
+        return;
+    }
+
+    // principal components of the centered curves
+    Map<const Matrix<double, Dynamic, Dynamic, RowMajor>> X(m_curves.constData(), n, S);
+    RowVectorXd mean = X.colwise().mean();
+    MatrixXd centered = X.rowwise() - mean;
+    BDCSVD<MatrixXd> svd(centered, ComputeThinV);
+
+    const int M = qBound(1, m_settings.componentCount, static_cast<int>(svd.singularValues().size()));
+    const VectorXd& sigma = svd.singularValues();
+    double totalVariance = sigma.squaredNorm();
+    m_explainedVariance = (totalVariance > 0.0) ? sigma.head(M).squaredNorm()/totalVariance : 1.0;
+
+    // Centering does not change the differences, so that the curves are projected as they are.
+    MatrixXd coords = X*svd.matrixV().leftCols(M);
+    m_coords.resize(n*M);
+    for(int i = 0; i < n; i++){
+        for(int c = 0; c < M; c++){
+            m_coords[i*M + c] = coords(i, c);
+        }
+    }
+
+    m_tree.build(m_coords, M, m_curveRows);
+}
+
+bool DispersionSimilarityEngine::canQuery(int row) const
+{
+    return (row >= 0 && row < m_curveIndices.size() && m_curveIndices[row] >= 0);
+}
+
+QVector<DispersionSimilarityEngine::Match> DispersionSimilarityEngine::find(int row, int k, const Filter &filter) const
+{
+    QVector<Match> matches;
+    if(!canQuery(row) || k <= 0){
+        return matches;
+    }
+
+    const GlassTable* table = m_snapshot->table().data();
+    const int S = m_wavelengths.size();
+    const int M = m_tree.dimension();
+    const int queryIndex = m_curveIndices[row];
+    const double* queryCurve  = m_curves.constData() + queryIndex*S;
+    const double* queryCoords = m_coords.constData() + queryIndex*M;
+
+    const QVector<quint8>& status = table->statusColumn();
+    auto accept = [&](int r){
+        if(r == row){
+            return false;
+        }
+        int ci = table->catalogIndex(r);
+        if(!filter.catalogs.isEmpty() && (ci >= filter.catalogs.size() || !filter.catalogs[ci])){
+            return false;
+        }
+        return !(filter.excludeObsolete && GlassTable::StatusObsolete == status[r]);
+    };
+
+    // Widen the candidates until no glass out of them can be closer than the k-th exact distance.
+    int candidateCount = qMax(2*k, k + 16);
+    while(true){
+        QVector<VpTree::Neighbor> neighbors = m_tree.kNearest(queryCoords, candidateCount, accept);
+
+        matches.clear();
+        for(auto &nb : neighbors){
+            const double* curve = m_curves.constData() + m_curveIndices[nb.id]*S;
+            Match m{nb.id, 0.0, 0.0, m_wavelengths[0]};
+            double sum = 0.0;
+            for(int j = 0; j < S; j++){
+                double d = curve[j] - queryCurve[j];
+                sum += d*d;
+                if(std::fabs(d) > m.maxAbsDelta){
+                    m.maxAbsDelta = std::fabs(d);
+                    m.lambdaAtMax = m_wavelengths[j];
+                }
+            }
+            m.rms = std::sqrt(sum/S);
+            matches.append(m);
+        }
+
+        std::sort(matches.begin(), matches.end(), [](const Match& a, const Match& b){
+            return (a.rms < b.rms) || (a.rms == b.rms && a.row < b.row);
+        });
+
+        if(neighbors.size() < candidateCount || matches.size() < k){
+            break; // all the accepted glasses were examined
+        }
+
+        double kthDistance = matches[k - 1].rms*std::sqrt(static_cast<double>(S));
+        if(neighbors.last().distance >= kthDistance){
+            break;
+        }
+        candidateCount *= 2;
+    }
+
+    if(matches.size() > k){
+        matches.resize(k);
+    }
+    return matches;
+}
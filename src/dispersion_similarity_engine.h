@@ -0,0 +1,103 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef DISPERSION_SIMILARITY_ENGINE_H
+#define DISPERSION_SIMILARITY_ENGINE_H
+
+#include <memory>
+
+#include <QVector>
+
+#include "catalog_snapshot.h"
+#include "vp_tree.h"
+
+/**
+ * @brief Engine to find the glasses whose dispersion curves n(lambda) match that of a glass over a wavelength band
+ * @details Every glass is sampled once on a common wavelength grid, and the curves are projected onto the first principal components over the catalogs.
+ *          The projected coordinates are indexed by a VP-tree. Since the projection does not increase the distance,
+ *          the candidates found in the projected space are re-ranked by the distance over the full grid,
+ *          and the search is widened until the k-th exact distance is closer than the farthest candidate.
+ */
+class DispersionSimilarityEngine
+{
+public:
+    struct Settings{
+        double lambdaMin;      // micron
+        double lambdaMax;      // micron
+        int    sampleCount;
+        int    componentCount;
+    };
+
+    struct Filter{
+        QVector<bool> catalogs;        // accepted catalogs indexed by the catalog index, empty to accept all
+        bool          excludeObsolete;
+    };
+
+    struct Match{
+        int    row;          // row in the table
+        double rms;          // RMS of n - n_query over the grid
+        double maxAbsDelta;  // worst-case |n - n_query|
+        double lambdaAtMax;  // micron
+    };
+
+    DispersionSimilarityEngine();
+
+    /** Sample the curves and build the index.  Nothing is done if the snapshot and the settings are not changed. */
+    void prepare(const std::shared_ptr<const CatalogSnapshot>& snapshot, const Settings& settings);
+
+    QSharedPointer<const GlassTable> table() const;
+    const Settings& settings() const { return m_settings; }
+
+    /** @return number of the glasses indexed */
+    int indexedCount() const { return m_tree.size(); }
+
+    /** @return fraction of the variance of the curves explained by the principal components */
+    double explainedVariance() const { return m_explainedVariance; }
+
+    bool canQuery(int row) const;
+
+    /**
+     * @brief Find the glasses whose curves are closest to that of the glass
+     * @param row row of the query glass
+     * @param k maximum number of the results
+     * @return matches sorted by the RMS difference.  The query glass itself is excluded.
+     */
+    QVector<Match> find(int row, int k, const Filter& filter) const;
+
+private:
+    void rebuild();
+
+    std::shared_ptr<const CatalogSnapshot> m_snapshot;
+    Settings                               m_settings;
+
+    QVector<double> m_wavelengths;
+    QVector<int>    m_curveIndices; // index of the curve of each row, -1 if not sampled
+    QVector<int>    m_curveRows;
+    QVector<double> m_curves;       // (curve count) x (sample count)
+    QVector<double> m_coords;       // (curve count) x (component count)
+    double          m_explainedVariance;
+    VpTree          m_tree;
+};
+
+#endif // DISPERSION_SIMILARITY_ENGINE_H
@@ -0,0 +1,217 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "dispersion_similarity_form.h"
+#include "ui_dispersion_similarity_form.h"
+
+#include <QDoubleValidator>
+#include <QIntValidator>
+#include <QListWidgetItem>
+#include <QElapsedTimer>
+
+#include "glass.h"
+#include "glass_catalog_manager.h"
+#include "glass_selection_dialog.h"
+
+DispersionSimilarityForm::DispersionSimilarityForm(QMdiArea *parent) :
+    QWidget(parent),
+    ui(new Ui::DispersionSimilarityForm),
+    m_parentMdiArea(parent)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Dispersion Similarity");
+
+    ui->label_QueryGlass->setText("-");
+
+    ui->lineEdit_LambdaMin->setValidator(new QDoubleValidator(100.0, 100000.0, 2, this));
+    ui->lineEdit_LambdaMin->setText("400");
+    ui->lineEdit_LambdaMax->setValidator(new QDoubleValidator(100.0, 100000.0, 2, this));
+    ui->lineEdit_LambdaMax->setText("700");
+
+    ui->lineEdit_OutputCount->setValidator(new QIntValidator(1, 1000, this));
+    ui->lineEdit_OutputCount->setText("10");
+
+    ui->checkBox_ExcludeObsolete->setChecked(true);
+
+    updateCatalogList();
+
+    QObject::connect(ui->pushButton_Select, SIGNAL(clicked()), this, SLOT(selectQueryGlass()));
+    QObject::connect(ui->pushButton_Search, SIGNAL(clicked()), this, SLOT(showSearchResult()));
+
+    // live update
+    QObject::connect(ui->listWidget_Catalogs,      SIGNAL(itemChanged(QListWidgetItem*)), this, SLOT(showSearchResult()));
+    QObject::connect(ui->checkBox_ExcludeObsolete, SIGNAL(toggled(bool)),                 this, SLOT(showSearchResult()));
+    QObject::connect(ui->lineEdit_OutputCount,     SIGNAL(textEdited(QString)),           this, SLOT(showSearchResult()));
+
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(tableUpdated()), this, SLOT(updateCatalogList()));
+        QObject::connect(manager, SIGNAL(tableUpdated()), this, SLOT(showSearchResult()));
+    }
+}
+
+DispersionSimilarityForm::~DispersionSimilarityForm()
+{
+    delete ui;
+}
+
+void DispersionSimilarityForm::selectQueryGlass()
+{
+    GlassSelectionDialog *dlg = new GlassSelectionDialog(this);
+    if(dlg->exec() == QDialog::Accepted)
+    {
+        Glass* glass = dlg->getSelectedGlass();
+        if(glass){
+            m_queryGlass = glass->fullName();
+            ui->label_QueryGlass->setText(m_queryGlass);
+            showSearchResult();
+        }
+    }
+
+    delete dlg;
+}
+
+void DispersionSimilarityForm::updateCatalogList()
+{
+    QSharedPointer<const GlassTable> table = GlassCatalogManager::table();
+    if(!table){
+        return;
+    }
+
+    // keep unchecked suppliers unchecked
+    QStringList uncheckedSuppliers;
+    for(int i = 0; i < ui->listWidget_Catalogs->count(); i++){
+        QListWidgetItem* item = ui->listWidget_Catalogs->item(i);
+        if(Qt::Unchecked == item->checkState()){
+            uncheckedSuppliers.append(item->text());
+        }
+    }
+
+    ui->listWidget_Catalogs->blockSignals(true);
+    ui->listWidget_Catalogs->clear();
+    for(int ci = 0; ci < table->catalogCount(); ci++){
+        QListWidgetItem* item = new QListWidgetItem(table->supplier(ci), ui->listWidget_Catalogs);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(uncheckedSuppliers.contains(table->supplier(ci)) ? Qt::Unchecked : Qt::Checked);
+    }
+    ui->listWidget_Catalogs->blockSignals(false);
+}
+
+DispersionSimilarityEngine::Settings DispersionSimilarityForm::getSettings() const
+{
+    DispersionSimilarityEngine::Settings settings = m_engine.settings();
+    settings.lambdaMin = ui->lineEdit_LambdaMin->text().toDouble()/1000.0;
+    settings.lambdaMax = ui->lineEdit_LambdaMax->text().toDouble()/1000.0;
+
+    if(settings.lambdaMin > settings.lambdaMax){
+        std::swap(settings.lambdaMin, settings.lambdaMax);
+    }
+
+    return settings;
+}
+
+DispersionSimilarityEngine::Filter DispersionSimilarityForm::getFilter() const
+{
+    DispersionSimilarityEngine::Filter filter;
+    filter.excludeObsolete = ui->checkBox_ExcludeObsolete->isChecked();
+
+    // The list is in the catalog order of the table.
+    for(int i = 0; i < ui->listWidget_Catalogs->count(); i++){
+        filter.catalogs.append(Qt::Checked == ui->listWidget_Catalogs->item(i)->checkState());
+    }
+
+    return filter;
+}
+
+void DispersionSimilarityForm::showSearchResult()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // The curves are sampled only when the catalogs or the band are changed.
+    m_engine.prepare(GlassCatalogManager::snapshot(), getSettings());
+
+    QSharedPointer<const GlassTable> table = m_engine.table();
+    if(!table){
+        return;
+    }
+
+    int queryRow    = table->findRow(m_queryGlass);
+    int resultCount = ui->lineEdit_OutputCount->text().toInt();
+    QVector<DispersionSimilarityEngine::Match> matches = m_engine.find(queryRow, resultCount, getFilter());
+
+    const DispersionSimilarityEngine::Settings& settings = m_engine.settings();
+
+    QStringList hHeaderLabels({"Rank", "Glass", "Catalog", "RMS dn", "Max |dn|", "at (nm)", "dnd", "dvd", "In Range"});
+    ui->tableWidget_Result->clear();
+    ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
+    ui->tableWidget_Result->setRowCount(matches.size());
+
+    const QVector<double>& nd = table->column(GlassTable::ColumnNd);
+    const QVector<double>& vd = table->column(GlassTable::ColumnVd);
+    const QVector<double>& lambdaMin = table->column(GlassTable::ColumnLambdaMin);
+    const QVector<double>& lambdaMax = table->column(GlassTable::ColumnLambdaMax);
+
+    for(int i = 0; i < matches.size(); i++){
+        const DispersionSimilarityEngine::Match& m = matches[i];
+        const int row = m.row;
+
+        // whether the band is in the wavelength range of the dispersion data
+        QString inRange = "-";
+        if(lambdaMin[row] > 0.0 && lambdaMax[row] > 0.0){
+            inRange = (lambdaMin[row] <= settings.lambdaMin && settings.lambdaMax <= lambdaMax[row]) ? "Yes" : "No";
+        }
+
+        setCellValue(ui->tableWidget_Result, i, 0, QString::number(i + 1));
+        setCellValue(ui->tableWidget_Result, i, 1, table->productName(row));
+        setCellValue(ui->tableWidget_Result, i, 2, table->supplier(table->catalogIndex(row)));
+        setCellValue(ui->tableWidget_Result, i, 3, numToQString(m.rms, 'e', 2));
+        setCellValue(ui->tableWidget_Result, i, 4, numToQString(m.maxAbsDelta, 'e', 2));
+        setCellValue(ui->tableWidget_Result, i, 5, numToQString(m.lambdaAtMax*1000.0, 'f', 1));
+        setCellValue(ui->tableWidget_Result, i, 6, numToQString(nd[row] - nd[queryRow], 'f', 5));
+        setCellValue(ui->tableWidget_Result, i, 7, numToQString(vd[row] - vd[queryRow], 'f', 2));
+        setCellValue(ui->tableWidget_Result, i, 8, inRange);
+    }
+
+    QString status = QString("Indexed glasses: %1, explained variance: %2%, %3 msec")
+            .arg(m_engine.indexedCount())
+            .arg(m_engine.explainedVariance()*100.0, 0, 'f', 4)
+            .arg(timer.elapsed());
+    if(!m_queryGlass.isEmpty() && !m_engine.canQuery(queryRow)){
+        status.prepend("The query glass is not available.  ");
+    }
+    ui->label_Status->setText(status);
+}
+
+void DispersionSimilarityForm::setCellValue(QTableWidget* table, int row, int col, QString str)
+{
+    QTableWidgetItem *item = table->item(row, col);
+    if(!item){
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+    }
+    item->setTextAlignment(Qt::AlignRight);
+    item->setText(str);
+}
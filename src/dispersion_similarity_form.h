@@ -0,0 +1,80 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef DISPERSION_SIMILARITY_FORM_H
+#define DISPERSION_SIMILARITY_FORM_H
+
+#include <QWidget>
+#include <QMdiArea>
+#include <QTableWidget>
+
+#include "dispersion_similarity_engine.h"
+
+namespace Ui {
+class DispersionSimilarityForm;
+}
+
+/** Form to find the glasses whose dispersion curves match that of a glass over a wavelength band */
+class DispersionSimilarityForm : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DispersionSimilarityForm(QMdiArea *parent = nullptr);
+    ~DispersionSimilarityForm();
+
+private slots:
+    /** Execute search and show result */
+    void showSearchResult();
+
+    void selectQueryGlass();
+
+    /** Update the catalog list keeping the check states */
+    void updateCatalogList();
+
+private:
+    DispersionSimilarityEngine::Settings getSettings() const;
+    DispersionSimilarityEngine::Filter   getFilter() const;
+    void setCellValue(QTableWidget* table, int row, int col, QString str);
+
+    inline QString numToQString(double val, char fmt='f', int digit=6);
+
+    Ui::DispersionSimilarityForm *ui;
+    QMdiArea* m_parentMdiArea;
+    QString   m_queryGlass; // full name
+
+    DispersionSimilarityEngine m_engine;
+};
+
+QString DispersionSimilarityForm::numToQString(double val, char fmt, int digit)
+{
+    if(qIsNaN(val)){
+        return "-";
+    }
+    else{
+        return QString::number(val, fmt, digit);
+    }
+}
+
+#endif // DISPERSION_SIMILARITY_FORM_H
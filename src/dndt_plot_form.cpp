@@ -80,6 +80,14 @@ DnDtPlotForm::DnDtPlotForm(QWidget *parent) :
     m_defaultXrange = QCPRange(-100, 140);
     m_defaultYrange = QCPRange(0.0, 23.0);
 
+
+    // catalog files modified on disk
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(glassesRemoved(int,QStringList)), this, SLOT(onGlassesRemoved(int,QStringList)));
+        QObject::connect(manager, SIGNAL(glassesChanged(int,QStringList)), this, SLOT(onGlassesChanged(int,QStringList)));
+    }
+
     setDefault();
 }
 
@@ -87,7 +95,7 @@ DnDtPlotForm::~DnDtPlotForm()
 {
     m_currentGlass = nullptr;
     m_wvlList.clear();
-    m_plotDataTable->clear();
+    m_plotDataModel->clear();
     m_customPlot->clearGraphs();
     m_customPlot->clearItems();
     m_customPlot->clearPlottables();
@@ -185,21 +193,19 @@ void DnDtPlotForm::updateAll()
     m_customPlot->clearGraphs();
     m_customPlot->clearItems();
     m_customPlot->clearPlottables();
-    m_plotDataTable->clear();
 
-    const double    plotStep = m_editPlotStep->text().toDouble();
-    QVector<double> xdata    = getVectorFromRange(m_customPlot->xAxis->range(), plotStep);
-    QVector<double> ydata;
-    QCPGraph*       graph;
+    // The glass is held by the snapshot while the curves are sampled in the background.
+    std::shared_ptr<const CatalogSnapshot> snapshot = GlassCatalogManager::snapshot();
+    Glass* currentGlass = m_currentGlass;
 
-    int i,j;
-    int rowCount    = xdata.size();
-    int columnCount = m_wvlList.size() + 1; // temperature + wavelengths
-    m_plotDataTable->setRowCount(rowCount);
-    m_plotDataTable->setColumnCount(columnCount);
+    QList<QCPGraph*>    graphs;
+    QList<CurveSampler> samplers;
+    QCPGraph*           graph;
 
+    int i;
     int digit = ui->spinBox_Digit->value();
 
+    // columns of the table: temperature + wavelengths
     QStringList header = QStringList() << "Temperature";
 
     // replot all graphs and recreate tables
@@ -209,27 +215,27 @@ void DnDtPlotForm::updateAll()
         currentWvl = m_wvlList[i]; // unit:nm
 
         // graphs
-        ydata = scaleVector(m_currentGlass->dn_dt_abs(xdata, currentWvl/1000.0), pow(10,6)); //unit:micron
         graph = m_customPlot->addGraph();
         graph->setName(QString::number(currentWvl));
-        graph->setData(xdata, ydata);
         graph->setPen(QPen(getColorFromIndex(i,m_maxGraphCount)));
         graph->setVisible(true);
+        graphs.append(graph);
+
+        // dn/dt(abs)
+        samplers.append([currentGlass, snapshot, currentWvl](const QVector<double>& xdata){
+            return scaleVector(currentGlass->dn_dt_abs(xdata, currentWvl/1000.0), pow(10,6)); //unit:micron
+        });
 
         // table
         header << QString::number(currentWvl) + "nm";
-        for(j = 0; j< rowCount; j++)
-        {
-            setValueToCell(j, 0,   xdata[j], digit);  // temperature
-            setValueToCell(j, i+1, ydata[j], digit);  // dn/dt(abs)
-        }
     }
-    m_customPlot->replot();
-    m_plotDataTable->setHorizontalHeaderLabels(header);
+
+    startSampling(graphs, samplers, header, digit);
 }
 
 void DnDtPlotForm::clearAll()
 {
+    cancelSampling();
     m_wvlList.clear();
 
     m_customPlot->clearGraphs();
@@ -237,6 +243,23 @@ void DnDtPlotForm::clearAll()
     m_customPlot->clearPlottables();
     m_customPlot->replot();
 
-    m_plotDataTable->clear();
-    m_plotDataTable->update();
+    m_plotDataModel->clear();
+}
+
+void DnDtPlotForm::onGlassesRemoved(int catalogIndex, const QStringList& glassNames)
+{
+    if(GlassCatalogManager::isListed(m_currentGlass, catalogIndex, glassNames)){
+        clearAll();
+        m_currentGlass = nullptr;
+        ui->label_GlassName->clear();
+    }
+}
+
+void DnDtPlotForm::onGlassesChanged(int catalogIndex, const QStringList& glassNames)
+{
+    if(GlassCatalogManager::isListed(m_currentGlass, catalogIndex, glassNames)){
+        // The modified glass is a new object in the new snapshot.
+        m_currentGlass = GlassCatalogManager::find(m_currentGlass->fullName());
+        updateAll();
+    }
 }
@@ -49,6 +49,8 @@ private slots:
     void deleteGraph() override;
     void clearAll() override;
     void updateAll() override;
+    void onGlassesRemoved(int catalogIndex, const QStringList& glassNames);
+    void onGlassesChanged(int catalogIndex, const QStringList& glassNames);
 
 private:
     Ui::DnDtPlotForm *ui;
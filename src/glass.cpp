@@ -23,6 +23,7 @@
  *****************************************************************************/
 
 #include <QDebug>
+#include <algorithm>
 #include "glass.h"
 
 #include "spline.h" // c++ cubic spline library, Tino Kluge (ttk448 at gmail.com), https://github.com/ttk592/spline
@@ -52,6 +53,7 @@ Glass::Glass()
     phosphate_resist_ = NAN;
 
     formula_index_ = 1;
+    formula_func_ptr_ = nullptr;
     dispersion_data_ = QVector<double>(dispersion_data_size_, 0.0);
 
     hasThermalData_ = false;
@@ -81,9 +83,14 @@ void Glass::setCurrentTemperature(double t)
 }
 
 double Glass::relative_wavelength(double lambdainput) const
+{
+    return relative_wavelength(lambdainput, T_);
+}
+
+double Glass::relative_wavelength(double lambdainput, double T) const
 {
     constexpr double P = 101325.0;
-    double n_air_system = Air::refractive_index_abs(lambdainput, T_, P);
+    double n_air_system = Air::refractive_index_abs(lambdainput, T, P);
     double n_air_ref    = Air::refractive_index_abs(lambdainput, Tref_, P);
     double lambda_rel   = lambdainput*(n_air_system/n_air_ref);
 
@@ -144,9 +151,14 @@ double Glass::Pxy_(const QString& x, const QString& y) const
 
 double Glass::refractiveIndex(double lambdamicron) const
 {
-    double lambda_rel = relative_wavelength(lambdamicron);
-    return refractiveIndex_rel(lambda_rel, T_);
-    //return refractiveIndex_rel(lambdamicron, T_);
+    return refractiveIndex(lambdamicron, T_);
+}
+
+double Glass::refractiveIndex(double lambdamicron, double T) const
+{
+    double lambda_rel = relative_wavelength(lambdamicron, T);
+    return refractiveIndex_rel(lambda_rel, T);
+    //return refractiveIndex_rel(lambdamicron, T);
 }
 
 double Glass::refractiveIndex(const QString& spectral) const
@@ -156,7 +168,12 @@ double Glass::refractiveIndex(const QString& spectral) const
 
 QVector<double> Glass::refractiveIndex(const QVector<double> &vLambdamicron) const
 {
-    return refractiveIndex_rel(vLambdamicron, T_);
+    return refractiveIndex(vLambdamicron, T_);
+}
+
+QVector<double> Glass::refractiveIndex(const QVector<double> &vLambdamicron, double T) const
+{
+    return refractiveIndex_rel(vLambdamicron, T);
 }
 
 double Glass::refractiveIndex_rel_Tref(double lambdamicron) const
@@ -227,15 +244,20 @@ QVector<double> Glass::refractiveIndex_rel(const QVector<double> &vLambdamicron,
 }
 
 double Glass::BuchdahlDispCoef(int n) const
+{
+    return BuchdahlDispCoef(n, T_);
+}
+
+double Glass::BuchdahlDispCoef(int n, double T) const
 {
     Q_ASSERT(n <= 1);
 
     double wd = SpectralLine::d/1000.0;
     double wF = SpectralLine::F/1000.0;
     double wC = SpectralLine::C/1000.0;
-    double nd = refractiveIndex(wd);
-    double nF = refractiveIndex(wF);
-    double nC = refractiveIndex(wC);
+    double nd = refractiveIndex(wd, T);
+    double nF = refractiveIndex(wF, T);
+    double nC = refractiveIndex(wC, T);
 
     double omegaF = ( wF-wd )/( 1 + 2.5*(wF-wd) );
     double omegaC = ( wC-wd )/( 1 + 2.5*(wC-wd) );
@@ -263,19 +285,19 @@ void Glass::setStatus(int n)
     switch(n)
     {
     case 1:
-        status_ = "Preferred";
+        status_ = QStringLiteral("Preferred");
         break;
     case 2:
-        status_ = "Obsolete";
+        status_ = QStringLiteral("Obsolete");
         break;
     case 3:
-        status_ = "Special";
+        status_ = QStringLiteral("Special");
         break;
     case 4:
-        status_ = "Melt";
+        status_ = QStringLiteral("Melt");
         break;
     default:
-        status_ = "-";
+        status_ = QStringLiteral("-");
     }
 }
 
@@ -298,91 +320,91 @@ void Glass::setDispForm(int n)
     // -----> Zemax AGF
     case 1:
         formula_func_ptr_ = &(DispersionFormula::Schott);
-        formula_name_ = "Schott";
+        formula_name_ = QStringLiteral("Schott");
         break;
     case 2:
         formula_func_ptr_ = &(DispersionFormula::Sellmeier1);
-        formula_name_ = "Sellmeier1";
+        formula_name_ = QStringLiteral("Sellmeier1");
         break;
     case 3:
         formula_func_ptr_ = &(DispersionFormula::Herzberger);
-        formula_name_ = "Herzberger";
+        formula_name_ = QStringLiteral("Herzberger");
         break;
     case 4:
         formula_func_ptr_ = &(DispersionFormula::Sellmeier2);
-        formula_name_ = "Sellmeier2";
+        formula_name_ = QStringLiteral("Sellmeier2");
         break;
     case 5:
         formula_func_ptr_ = &(DispersionFormula::Conrady);
-        formula_name_ = "Conrady";
+        formula_name_ = QStringLiteral("Conrady");
         break;
     case 6:
         formula_func_ptr_ = &(DispersionFormula::Sellmeier3);
-        formula_name_ = "Sellmeier3";
+        formula_name_ = QStringLiteral("Sellmeier3");
         break;
     case 7:
         formula_func_ptr_ = &(DispersionFormula::HandbookOfOptics1);
-        formula_name_ = "Handbook of Optics1";
+        formula_name_ = QStringLiteral("Handbook of Optics1");
         break;
     case 8:
         formula_func_ptr_ = &(DispersionFormula::HandbookOfOptics2);
-        formula_name_ = "Handbook of Optics2";
+        formula_name_ = QStringLiteral("Handbook of Optics2");
         break;
     case 9:
         formula_func_ptr_ = &(DispersionFormula::Sellmeier4);
-        formula_name_ = "Sellmeier4";
+        formula_name_ = QStringLiteral("Sellmeier4");
         break;
     case 10:
         formula_func_ptr_ = &(DispersionFormula::Extended1);
-        formula_name_ = "Extended1";
+        formula_name_ = QStringLiteral("Extended1");
         break;
     case 11:
         formula_func_ptr_ = &(DispersionFormula::Sellmeier5);
-        formula_name_ = "Sellmeier5";
+        formula_name_ = QStringLiteral("Sellmeier5");
         break;
     case 12:
         formula_func_ptr_ = &(DispersionFormula::Extended2);
-        formula_name_ = "Extended2";
+        formula_name_ = QStringLiteral("Extended2");
         break;
     case 13: // Unknown
         if(supplier_.contains("hikari", Qt::CaseInsensitive)){
             formula_func_ptr_ = &(DispersionFormula::Nikon_Hikari);
-            formula_name_ = "Nikon Hikari";
+            formula_name_ = QStringLiteral("Nikon Hikari");
         }else{
             formula_func_ptr_ = nullptr;
-            formula_name_ = "Unknown";
+            formula_name_ = QStringLiteral("Unknown");
         }
         break;
 
     // -----> CodeV XML
     case 101:
         formula_func_ptr_ = &(DispersionFormula::Laurent);
-        formula_name_ = "Laurent";
+        formula_name_ = QStringLiteral("Laurent");
         break;
     case 102:
         formula_func_ptr_ = &(DispersionFormula::GlassManufacturerLaurent);
-        formula_name_ = "Glass Manufacturer Laurent";
+        formula_name_ = QStringLiteral("Glass Manufacturer Laurent");
         break;
     case 103:
         formula_func_ptr_ = &(DispersionFormula::GlassManufacturerSellmeier);
-        formula_name_ = "Glass Manufacturer Sellmeier";
+        formula_name_ = QStringLiteral("Glass Manufacturer Sellmeier");
         break;
     case 104:
         formula_func_ptr_ = &(DispersionFormula::StandardSellmeier);
-        formula_name_ = "Standard Sellmeier";
+        formula_name_ = QStringLiteral("Standard Sellmeier");
         break;
     case 105:
         formula_func_ptr_ = &(DispersionFormula::Cauchy);
-        formula_name_ = "Cauchy";
+        formula_name_ = QStringLiteral("Cauchy");
         break;
     case 106:
         formula_func_ptr_ = &(DispersionFormula::Hartman);
-        formula_name_ = "Hartman";
+        formula_name_ = QStringLiteral("Hartman");
         break;
 
     default:
         formula_func_ptr_ = nullptr;
-        formula_name_ = "Unknown";
+        formula_name_ = QStringLiteral("Unknown");
     }
 
 }
@@ -444,6 +466,17 @@ QVector<double> Glass::transmittance(const QVector<double>& vLambdamicron, doubl
     return y;
 }
 
+bool Glass::hasTransmittanceAt(double lambdamicron) const
+{
+    // spline interpolation requires 3 points at least
+    if(wavelength_data_.size() < 3 || transmittance_data_.size() != wavelength_data_.size() || thickness_data_.isEmpty()){
+        return false;
+    }
+
+    auto minmax = std::minmax_element(wavelength_data_.begin(), wavelength_data_.end());
+    return (*minmax.first <= lambdamicron && lambdamicron <= *minmax.second);
+}
+
 void Glass::getTransmittanceData(QList<double>& pvLambdamicron, QList<double>& pvTransmittance, QList<double>& pvThickness)
 {
     pvLambdamicron  = wavelength_data_;
@@ -506,3 +539,57 @@ void Glass::setThermalData(int n, double val)
     }
 }
 
+
+bool Glass::hasSameData(const Glass& other) const
+{
+    // NaN is used as "no data", so two NaNs are regarded as the same value.
+    auto isSame = [](double a, double b){
+        return (a == b) || (qIsNaN(a) && qIsNaN(b));
+    };
+
+    auto isSameList = [&isSame](const QList<double>& a, const QList<double>& b){
+        if(a.size() != b.size()){
+            return false;
+        }
+        for(int i = 0; i < a.size(); i++){
+            if(!isSame(a[i], b[i])) return false;
+        }
+        return true;
+    };
+
+    if( product_name_ != other.product_name_ ||
+        supplier_     != other.supplier_     ||
+        status_       != other.status_       ||
+        MIL_          != other.MIL_          ||
+        comment_      != other.comment_      ||
+        formula_index_  != other.formula_index_ ||
+        hasThermalData_ != other.hasThermalData_ )
+    {
+        return false;
+    }
+
+    if( !isSameList(dispersion_data_.toList(), other.dispersion_data_.toList()) ||
+        !isSameList(thermal_data_.toList(),    other.thermal_data_.toList()) )
+    {
+        return false;
+    }
+
+    if( !isSame(lowTCE_,           other.lowTCE_)           ||
+        !isSame(highTCE_,          other.highTCE_)          ||
+        !isSame(Tref_,             other.Tref_)             ||
+        !isSame(rel_cost_,         other.rel_cost_)         ||
+        !isSame(climate_resist_,   other.climate_resist_)   ||
+        !isSame(stain_resist_,     other.stain_resist_)     ||
+        !isSame(acid_resist_,      other.acid_resist_)      ||
+        !isSame(alkali_resist_,    other.alkali_resist_)    ||
+        !isSame(phosphate_resist_, other.phosphate_resist_) ||
+        !isSame(lambda_min_,       other.lambda_min_)       ||
+        !isSame(lambda_max_,       other.lambda_max_) )
+    {
+        return false;
+    }
+
+    return ( isSameList(wavelength_data_,    other.wavelength_data_)    &&
+             isSameList(transmittance_data_, other.transmittance_data_) &&
+             isSameList(thickness_data_,     other.thickness_data_) );
+}
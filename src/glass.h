@@ -40,12 +40,17 @@ public:
     static void setCurrentTemperature(double t);
 
     double relative_wavelength(double lambdainput) const;
+    double relative_wavelength(double lambdainput, double T) const;
 
     // fundamental data
     double          refractiveIndex(double lambdamicron) const;
     double          refractiveIndex(const QString& spectral) const;
     QVector<double> refractiveIndex(const QVector<double>& vLambdamicron) const;
 
+    // The same at the given temperature instead of the current one, which can be called from any thread.
+    double          refractiveIndex(double lambdamicron, double T) const;
+    QVector<double> refractiveIndex(const QVector<double>& vLambdamicron, double T) const;
+
     inline QString  fullName() const;
     inline QString  productName() const;
     inline QString  supplier() const;
@@ -61,6 +66,7 @@ public:
     double getValue(const QString& dname) const;
 
     double BuchdahlDispCoef(int n) const;
+    double BuchdahlDispCoef(int n, double T) const;
 
     inline void setName(const QString& str);
     inline void setSupplier(const QString& str);
@@ -126,6 +132,9 @@ public:
     double          transmittance(double lambdamicron, double thi = 25) const;
     QVector<double> transmittance(const QVector<double>& vLambdamicron, double thi = 25) const;
 
+    /** Returns true if the transmittance data can be interpolated at the wavelength */
+    bool hasTransmittanceAt(double lambdamicron) const;
+
     inline double  lambdaMin() const;
     inline double  lambdaMax() const;
     void   getTransmittanceData(QList<double>& pvLambdamicron, QList<double>& pvTransmittance, QList<double>& pvThickness);
@@ -134,6 +143,9 @@ public:
     inline void  setLambdaMin(double val);
     inline void  setLambdaMax(double val);
 
+    /** Returns true if all the catalog data (names, dispersion, thermal, transmittance etc.) equal to the other */
+    bool hasSameData(const Glass& other) const;
+
 
 private:
     double          refractiveIndex_abs_Tref(double lambdamicron) const;
@@ -157,7 +169,7 @@ private:
     double highTCE_;
 
     // dispersion data
-    const int       dispersion_data_size_ = 12;
+    static constexpr int dispersion_data_size_ = 12;
     QVector<double> dispersion_data_;
     int             formula_index_;
     QString         formula_name_;
@@ -165,7 +177,7 @@ private:
 
     // thermal data
     bool            hasThermalData_;
-    const int       thermal_data_size_ = 7;
+    static constexpr int thermal_data_size_ = 7;
     QVector<double> thermal_data_; //<D0> <D1> <D2> <E0> <E1> <Ltk> <temp>
     double          Tref_;
 
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_arena.h"
+
+#include <new>
+
+#include "glass.h"
+
+namespace {
+
+constexpr int firstBlockCapacity = 64;
+constexpr int maxBlockCapacity   = 4096;
+
+}
+
+GlassArena::GlassArena()
+{
+    m_count = 0;
+}
+
+GlassArena::~GlassArena()
+{
+    clear();
+}
+
+void* GlassArena::allocate()
+{
+    if(m_blocks.isEmpty() || m_blocks.last().used == m_blocks.last().capacity){
+        // Each block is twice as large as the previous one, so that a catalog of thousands of glasses needs only a few blocks.
+        int capacity = m_blocks.isEmpty() ? firstBlockCapacity : qMin(2*m_blocks.last().capacity, maxBlockCapacity);
+
+        Block block;
+        block.data     = static_cast<Glass*>(::operator new(sizeof(Glass)*capacity));
+        block.capacity = capacity;
+        block.used     = 0;
+        m_blocks.append(block);
+    }
+
+    Block& block = m_blocks.last();
+    m_count += 1;
+
+    return block.data + (block.used++);
+}
+
+Glass* GlassArena::create()
+{
+    return new (allocate()) Glass;
+}
+
+Glass* GlassArena::create(const Glass &other)
+{
+    return new (allocate()) Glass(other);
+}
+
+void GlassArena::clear()
+{
+    for(auto &block : m_blocks){
+        for(int i = 0; i < block.used; i++){
+            block.data[i].~Glass();
+        }
+        ::operator delete(block.data);
+    }
+    m_blocks.clear();
+    m_count = 0;
+}
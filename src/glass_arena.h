@@ -0,0 +1,73 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_ARENA_H
+#define GLASS_ARENA_H
+
+#include <QVector>
+
+class Glass;
+
+/**
+ * @brief Monotonic memory pool of Glass objects owned by a catalog
+ * @details Glasses are constructed in large blocks instead of being allocated one by one.
+ *          Memory is never returned to the system until clear(), which frees the blocks at once.
+ *          Only the Glass objects are pooled. The names, the coefficient vectors and the transmittance lists
+ *          of each glass keep their own heap storage, so that clear() still runs the destructor of every glass.
+ */
+class GlassArena
+{
+public:
+    GlassArena();
+    ~GlassArena();
+
+    /** Construct a new glass in the arena */
+    Glass* create();
+
+    /** Construct a copy of the glass in the arena */
+    Glass* create(const Glass& other);
+
+    /** Destroy all the glasses one by one and free all the blocks */
+    void clear();
+
+    /** Number of glasses */
+    int count() const { return m_count; }
+
+private:
+    Q_DISABLE_COPY(GlassArena)
+
+    struct Block{
+        Glass* data;
+        int    capacity;
+        int    used;
+    };
+
+    /** Returns uninitialized memory for one glass */
+    void* allocate();
+
+    QVector<Block> m_blocks;
+    int            m_count;
+};
+
+#endif // GLASS_ARENA_H
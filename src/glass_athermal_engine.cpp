@@ -0,0 +1,272 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_athermal_engine.h"
+
+#include <algorithm>
+#include <QtConcurrent>
+#include <QtNumeric>
+#include <QThread>
+
+namespace {
+
+bool residualLess(const GlassAthermalEngine::Result& a, const GlassAthermalEngine::Result& b)
+{
+    return qAbs(a.residual) < qAbs(b.residual);
+}
+
+}
+
+GlassAthermalEngine::GlassAthermalEngine()
+{
+    m_settings.mode            = Pair;
+    m_settings.wavelength      = 587.562;
+    m_settings.temperatureMin  = -20;
+    m_settings.temperatureMax  = 60;
+    m_settings.housingCTE      = 23.6;
+    m_settings.maxPowerSum     = 5.0;
+    m_settings.excludeObsolete = true;
+}
+
+QSharedPointer<const GlassTable> GlassAthermalEngine::table() const
+{
+    return m_snapshot ? m_snapshot->table() : QSharedPointer<const GlassTable>();
+}
+
+void GlassAthermalEngine::prepare(const std::shared_ptr<const CatalogSnapshot> &snapshot, const Settings &settings)
+{
+    m_snapshot = snapshot;
+    m_settings = settings;
+    m_candidates.clear();
+
+    QSharedPointer<const GlassTable> table = this->table();
+    if(!table){
+        return;
+    }
+
+    const GlassTable* t = table.data();
+    const QVector<quint8>& status = t->statusColumn();
+    const QVector<double>& vd     = t->column(GlassTable::ColumnVd);
+    const QVector<double>& tce    = t->column(GlassTable::ColumnLowTCE);
+
+    QVector<int> rows;
+    for(int row = 0; row < t->rowCount(); row++){
+        if(!t->isValid(row) || !t->glass(row)->hasThermalData()){
+            continue;
+        }
+        if(m_settings.excludeObsolete && GlassTable::StatusObsolete == status[row]){
+            continue;
+        }
+        if(!m_settings.catalogs.isEmpty()){
+            int ci = t->catalogIndex(row);
+            if(ci >= m_settings.catalogs.size() || !m_settings.catalogs[ci]){
+                continue;
+            }
+        }
+        rows.append(row);
+    }
+
+    // gamma of all candidates in one pass
+    const double lambdamicron = m_settings.wavelength/1000.0;
+    const double T1      = m_settings.temperatureMin;
+    const double T2      = m_settings.temperatureMax;
+    const double alphaH  = m_settings.housingCTE*1e-6;
+    const double Ttable  = t->temperature(); // n at the temperature of the snapshot
+
+    QVector<Candidate> candidates(rows.size());
+    QVector<int>       indices(rows.size());
+    for(int i = 0; i < indices.size(); i++){
+        indices[i] = i;
+    }
+
+    Candidate* out = candidates.data();
+    QtConcurrent::blockingMap(indices, [&](int i){
+        const int    row = rows.at(i);
+        const Glass* g   = t->glass(row);
+
+        // mean dn/dT over the temperature range
+        double dndt;
+        if(T2 > T1){
+            dndt = (g->delta_n_abs(T2, lambdamicron) - g->delta_n_abs(T1, lambdamicron))/(T2 - T1);
+        }
+        else{
+            dndt = g->dn_dt_abs(T1, lambdamicron);
+        }
+
+        double n = g->refractiveIndex(lambdamicron, Ttable);
+
+        Candidate& c = out[i];
+        c.row   = row;
+        c.vd    = vd[row];
+        c.gamma = dndt/(n - 1) - tce[row]*1e-6;
+        c.u     = c.vd*(c.gamma + alphaH);
+    });
+
+    for(auto &c : candidates){
+        if(qIsFinite(c.gamma) && qIsFinite(c.vd) && c.vd > 0){
+            m_candidates.append(c);
+        }
+    }
+
+    std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate& a, const Candidate& b){
+        return a.u < b.u;
+    });
+}
+
+QVector<GlassAthermalEngine::Result> GlassAthermalEngine::search(int k) const
+{
+    if(k <= 0 || m_candidates.isEmpty()){
+        return QVector<Result>();
+    }
+
+    return (Singlet == m_settings.mode) ? searchSinglets(k) : searchPairs(k);
+}
+
+QVector<GlassAthermalEngine::Result> GlassAthermalEngine::searchSinglets(int k) const
+{
+    const double alphaH = m_settings.housingCTE*1e-6;
+
+    QVector<Result> results;
+    results.reserve(m_candidates.size());
+    for(auto &c : m_candidates){
+        Result r;
+        r.count     = 1;
+        r.rows[0]   = c.row;
+        r.rows[1]   = -1;
+        r.powers[0] = 1.0;
+        r.powers[1] = 0.0;
+        r.gammas[0] = c.gamma;
+        r.gammas[1] = 0.0;
+        r.powerSum  = 1.0;
+        r.residual  = c.gamma + alphaH;
+        results.append(r);
+    }
+
+    int count = qMin(k, results.size());
+    std::partial_sort(results.begin(), results.begin() + count, results.end(), residualLess);
+    results.resize(count);
+
+    return results;
+}
+
+QVector<GlassAthermalEngine::Result> GlassAthermalEngine::searchPairs(int k) const
+{
+    const double M = m_settings.maxPowerSum;
+    if(M <= 1.0){
+        return QVector<Result>();
+    }
+
+    const int N = m_candidates.size();
+
+    double vMin = qInf();
+    for(auto &c : m_candidates){
+        vMin = qMin(vMin, c.vd);
+    }
+
+    QVector<double> u(N);
+    for(int i = 0; i < N; i++){
+        u[i] = m_candidates[i].u;
+    }
+
+    // Glass a is the positive element, whose vd is larger than that of b.
+    // The chunks of a are searched in parallel and each keeps its best k pairs in a max-heap.
+    auto searchRange = [&](int aBegin, int aEnd){
+        QVector<Result> heap;
+        heap.reserve(k + 1);
+        double bound = qInf();
+
+        for(int a = aBegin; a < aEnd; a++){
+            const Candidate& ca = m_candidates[a];
+            const double vbMax = ca.vd*(M - 1)/(M + 1);
+            if(vbMax < vMin){
+                continue;
+            }
+
+            // |ua - ub| < bound*(va - vb) <= bound*(va - vMin)
+            int first = 0, last = N;
+            if(qIsFinite(bound)){
+                double window = bound*(ca.vd - vMin);
+                first = std::lower_bound(u.constBegin(), u.constEnd(), ca.u - window) - u.constBegin();
+                last  = std::upper_bound(u.constBegin(), u.constEnd(), ca.u + window) - u.constBegin();
+            }
+
+            for(int b = first; b < last; b++){
+                const Candidate& cb = m_candidates[b];
+                if(cb.vd > vbMax){
+                    continue;
+                }
+
+                double dv       = ca.vd - cb.vd;
+                double residual = (ca.u - cb.u)/dv;
+                if(qAbs(residual) >= bound){
+                    continue;
+                }
+
+                Result r;
+                r.count     = 2;
+                r.rows[0]   = ca.row;
+                r.rows[1]   = cb.row;
+                r.powers[0] =  ca.vd/dv;
+                r.powers[1] = -cb.vd/dv;
+                r.gammas[0] = ca.gamma;
+                r.gammas[1] = cb.gamma;
+                r.powerSum  = (ca.vd + cb.vd)/dv;
+                r.residual  = residual;
+
+                heap.append(r);
+                std::push_heap(heap.begin(), heap.end(), residualLess);
+                if(heap.size() > k){
+                    std::pop_heap(heap.begin(), heap.end(), residualLess);
+                    heap.removeLast();
+                }
+                if(heap.size() == k){
+                    bound = qAbs(heap.first().residual);
+                }
+            }
+        }
+        return heap;
+    };
+
+    int chunkCount = qBound(1, N/256, QThread::idealThreadCount());
+    QVector< QVector<Result> > chunkResults(chunkCount);
+    QVector<int> chunks(chunkCount);
+    for(int i = 0; i < chunkCount; i++){
+        chunks[i] = i;
+    }
+
+    QVector<Result>* out = chunkResults.data();
+    QtConcurrent::blockingMap(chunks, [&](int i){
+        out[i] = searchRange(N*i/chunkCount, N*(i + 1)/chunkCount);
+    });
+
+    QVector<Result> results;
+    for(auto &r : chunkResults){
+        results += r;
+    }
+    int count = qMin(k, results.size());
+    std::partial_sort(results.begin(), results.begin() + count, results.end(), residualLess);
+    results.resize(count);
+
+    return results;
+}
@@ -0,0 +1,106 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_ATHERMAL_ENGINE_H
+#define GLASS_ATHERMAL_ENGINE_H
+
+#include <memory>
+
+#include <QVector>
+
+#include "catalog_snapshot.h"
+
+/**
+ * @brief Search engine of athermal glasses for a housing material
+ * @details The thermo-optic coefficient of a glass is gamma = (dn/dT)/(n - 1) - alpha, with which the focal length changes by df/dT = -gamma*f.
+ *          dn/dT is averaged over the temperature range at the wavelength, and alpha is the low temperature CTE.
+ *          The focal shift matches the housing expansion when the sum of power*gamma is -alpha_h (total power 1).
+ *
+ *          For an achromatic pair of thin lenses in contact, pa = va/(va - vb) and pb = -vb/(va - vb),
+ *          and the residual of the athermal condition is (ua - ub)/(va - vb) where u = v*(gamma + alpha_h).
+ *          The candidates are sorted by u, so that the glasses to be paired with a glass are found in a window by binary search.
+ */
+class GlassAthermalEngine
+{
+public:
+    enum Mode{
+        Singlet, // single glass in the housing
+        Pair     // achromatic pair in the housing
+    };
+
+    struct Settings{
+        Mode          mode;
+        double        wavelength;      // nm
+        double        temperatureMin;
+        double        temperatureMax;
+        double        housingCTE;      // 1e-6/K
+        double        maxPowerSum;     // upper limit of the sum of absolute powers for pairs
+        bool          excludeObsolete;
+        QVector<bool> catalogs;        // accepted catalogs indexed by the catalog index, empty to accept all
+    };
+
+    struct Result{
+        int    count;     // number of glasses
+        int    rows[2];   // rows in the table
+        double powers[2];
+        double gammas[2]; // 1/K
+        double powerSum;
+        double residual;  // sum of power*gamma + alpha_h, 1/K
+    };
+
+    GlassAthermalEngine();
+
+    /** Compute the thermo-optic coefficients of the glasses in the snapshot */
+    void prepare(const std::shared_ptr<const CatalogSnapshot>& snapshot, const Settings& settings);
+
+    QSharedPointer<const GlassTable> table() const;
+    const Settings& settings() const { return m_settings; }
+
+    /** @return number of the glasses having thermal data */
+    int candidateCount() const { return m_candidates.size(); }
+
+    /**
+     * @brief Find the best athermal glasses or pairs
+     * @param k maximum number of the results
+     * @return results sorted by the absolute residual
+     */
+    QVector<Result> search(int k) const;
+
+private:
+    struct Candidate{
+        int    row;
+        double vd;
+        double gamma;
+        double u;     // vd*(gamma + alpha_h)
+    };
+
+    QVector<Result> searchSinglets(int k) const;
+    QVector<Result> searchPairs(int k) const;
+
+    std::shared_ptr<const CatalogSnapshot> m_snapshot;
+    Settings                               m_settings;
+    QVector<Candidate>                     m_candidates; // sorted by u
+};
+
+#endif // GLASS_ATHERMAL_ENGINE_H
@@ -0,0 +1,207 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_athermal_form.h"
+#include "ui_glass_athermal_form.h"
+
+#include <algorithm>
+
+#include <QDoubleValidator>
+#include <QIntValidator>
+#include <QListWidgetItem>
+#include <QElapsedTimer>
+
+#include "glass_catalog_manager.h"
+#include "spectral_line.h"
+
+namespace {
+
+struct HousingMaterial{
+    const char* name;
+    double      cte; // 1e-6/K
+};
+
+const HousingMaterial housingMaterials[] = {
+    {"Aluminum",        23.6},
+    {"Stainless Steel", 17.3},
+    {"Brass",           19.0},
+    {"Titanium",         8.6},
+    {"Invar",            1.2}
+};
+
+}
+
+GlassAthermalForm::GlassAthermalForm(QMdiArea *parent) :
+    QWidget(parent),
+    ui(new Ui::GlassAthermalForm),
+    m_parentMdiArea(parent)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Athermal Glass");
+
+    ui->comboBox_Mode->addItems(QStringList({"Singlet", "Achromatic pair"}));
+    ui->comboBox_Mode->setCurrentIndex(1);
+
+    ui->lineEdit_Wavelength->setValidator(new QDoubleValidator(0.0, 100000.0, 4, this));
+    ui->lineEdit_Wavelength->setText(QString::number(SpectralLine::d));
+
+    ui->lineEdit_TemperatureMin->setValidator(new QDoubleValidator(-273.15, 1000.0, 2, this));
+    ui->lineEdit_TemperatureMin->setText("-20");
+    ui->lineEdit_TemperatureMax->setValidator(new QDoubleValidator(-273.15, 1000.0, 2, this));
+    ui->lineEdit_TemperatureMax->setText("60");
+
+    for(auto &m : housingMaterials){
+        ui->comboBox_Housing->addItem(QString("%1 (%2)").arg(m.name).arg(m.cte));
+    }
+    ui->comboBox_Housing->addItem("Custom");
+    ui->lineEdit_HousingCTE->setValidator(new QDoubleValidator(-1000.0, 1000.0, 3, this));
+    onHousingChanged(0);
+
+    ui->lineEdit_MaxPowerSum->setValidator(new QDoubleValidator(1.0, 1000.0, 3, this));
+    ui->lineEdit_MaxPowerSum->setText("5");
+
+    ui->lineEdit_OutputCount->setValidator(new QIntValidator(1, 1000, this));
+    ui->lineEdit_OutputCount->setText("20");
+
+    ui->checkBox_ExcludeObsolete->setChecked(true);
+
+    updateCatalogList();
+
+    QObject::connect(ui->comboBox_Housing,    SIGNAL(currentIndexChanged(int)), this, SLOT(onHousingChanged(int)));
+    QObject::connect(ui->pushButton_Search,   SIGNAL(clicked()),                this, SLOT(showSearchResult()));
+
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(tableUpdated()), this, SLOT(updateCatalogList()));
+    }
+}
+
+GlassAthermalForm::~GlassAthermalForm()
+{
+    delete ui;
+}
+
+void GlassAthermalForm::onHousingChanged(int index)
+{
+    const int materialCount = sizeof(housingMaterials)/sizeof(housingMaterials[0]);
+
+    if(index >= 0 && index < materialCount){
+        ui->lineEdit_HousingCTE->setText(QString::number(housingMaterials[index].cte));
+        ui->lineEdit_HousingCTE->setEnabled(false);
+    }
+    else{
+        ui->lineEdit_HousingCTE->setEnabled(true);
+    }
+}
+
+void GlassAthermalForm::updateCatalogList()
+{
+    QSharedPointer<const GlassTable> table = GlassCatalogManager::table();
+    if(!table){
+        return;
+    }
+
+    // keep unchecked suppliers unchecked
+    QStringList uncheckedSuppliers;
+    for(int i = 0; i < ui->listWidget_Catalogs->count(); i++){
+        QListWidgetItem* item = ui->listWidget_Catalogs->item(i);
+        if(Qt::Unchecked == item->checkState()){
+            uncheckedSuppliers.append(item->text());
+        }
+    }
+
+    ui->listWidget_Catalogs->clear();
+    for(int ci = 0; ci < table->catalogCount(); ci++){
+        QListWidgetItem* item = new QListWidgetItem(table->supplier(ci), ui->listWidget_Catalogs);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(uncheckedSuppliers.contains(table->supplier(ci)) ? Qt::Unchecked : Qt::Checked);
+    }
+}
+
+GlassAthermalEngine::Settings GlassAthermalForm::getSettings() const
+{
+    GlassAthermalEngine::Settings settings;
+    settings.mode            = (0 == ui->comboBox_Mode->currentIndex()) ? GlassAthermalEngine::Singlet : GlassAthermalEngine::Pair;
+    settings.wavelength      = ui->lineEdit_Wavelength->text().toDouble();
+    settings.temperatureMin  = ui->lineEdit_TemperatureMin->text().toDouble();
+    settings.temperatureMax  = ui->lineEdit_TemperatureMax->text().toDouble();
+    settings.housingCTE      = ui->lineEdit_HousingCTE->text().toDouble();
+    settings.maxPowerSum     = ui->lineEdit_MaxPowerSum->text().toDouble();
+    settings.excludeObsolete = ui->checkBox_ExcludeObsolete->isChecked();
+
+    if(settings.temperatureMin > settings.temperatureMax){
+        std::swap(settings.temperatureMin, settings.temperatureMax);
+    }
+
+    // The list is in the catalog order of the table.
+    for(int i = 0; i < ui->listWidget_Catalogs->count(); i++){
+        settings.catalogs.append(Qt::Checked == ui->listWidget_Catalogs->item(i)->checkState());
+    }
+
+    return settings;
+}
+
+void GlassAthermalForm::showSearchResult()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    m_engine.prepare(GlassCatalogManager::snapshot(), getSettings());
+
+    int resultCount = ui->lineEdit_OutputCount->text().toInt();
+    const QVector<GlassAthermalEngine::Result> results = m_engine.search(resultCount);
+
+    QSharedPointer<const GlassTable> table = m_engine.table();
+
+    // gamma and residual are shown in 1e-6/K
+    QStringList hHeaderLabels({"Glass 1", "Glass 2", "Power 1", "Power 2", "Power Sum", "Gamma 1", "Gamma 2", "Residual"});
+    ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
+    ui->tableWidget_Result->setRowCount(results.size());
+
+    for(int i = 0; i < results.size(); i++){
+        const GlassAthermalEngine::Result& r = results[i];
+        for(int j = 0; j < 2; j++){
+            bool used = (j < r.count);
+            setCellValue(ui->tableWidget_Result, i, j,     used ? table->fullName(r.rows[j])                : "-");
+            setCellValue(ui->tableWidget_Result, i, j + 2, used ? QString::number(r.powers[j], 'f', 4)      : "-");
+            setCellValue(ui->tableWidget_Result, i, j + 5, used ? QString::number(r.gammas[j]*1e6, 'f', 3) : "-");
+        }
+        setCellValue(ui->tableWidget_Result, i, 4, QString::number(r.powerSum, 'f', 4));
+        setCellValue(ui->tableWidget_Result, i, 7, QString::number(r.residual*1e6, 'f', 4));
+    }
+
+    ui->label_Status->setText(QString("%1 glasses with thermal data, %2 msec").arg(m_engine.candidateCount()).arg(timer.elapsed()));
+}
+
+void GlassAthermalForm::setCellValue(QTableWidget* table, int row, int col, QString str)
+{
+    QTableWidgetItem *item = table->item(row, col);
+    if(!item){
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+    }
+    item->setTextAlignment(Qt::AlignRight);
+    item->setText(str);
+}
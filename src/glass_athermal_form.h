@@ -0,0 +1,67 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_ATHERMAL_FORM_H
+#define GLASS_ATHERMAL_FORM_H
+
+#include <QWidget>
+#include <QMdiArea>
+#include <QTableWidget>
+
+#include "glass_athermal_engine.h"
+
+namespace Ui {
+class GlassAthermalForm;
+}
+
+/** Form to search athermal glasses and glass pairs for a housing material */
+class GlassAthermalForm : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit GlassAthermalForm(QMdiArea *parent = nullptr);
+    ~GlassAthermalForm();
+
+private slots:
+    /** Execute search and show result */
+    void showSearchResult();
+
+    /** Set CTE of the selected housing material */
+    void onHousingChanged(int index);
+
+    /** Update the catalog list keeping the check states */
+    void updateCatalogList();
+
+private:
+    GlassAthermalEngine::Settings getSettings() const;
+    void setCellValue(QTableWidget* table, int row, int col, QString str);
+
+    Ui::GlassAthermalForm *ui;
+    QMdiArea* m_parentMdiArea;
+
+    GlassAthermalEngine m_engine;
+};
+
+#endif // GLASS_ATHERMAL_FORM_H
@@ -45,17 +45,10 @@ GlassCatalog::~GlassCatalog()
 
 void GlassCatalog::clear()
 {
-    if(!glasses_.isEmpty()){
-        for(auto &g:glasses_){
-            try {
-                delete g;
-            } catch (...) {
-                g = nullptr;
-            }
-            g = nullptr;
-        }
-        glasses_.clear();
-    }
+    // all the glasses are released with the arena
+    glasses_.clear();
+    arena_.clear();
+
     supplier_ = "";
     name_to_int_map_.clear();
 }
@@ -81,8 +74,23 @@ bool GlassCatalog::hasGlass(const QString& glassname) const
     return name_to_int_map_.contains(glassname);
 }
 
+Glass* GlassCatalog::addGlass(const Glass &glass)
+{
+    if(name_to_int_map_.contains(glass.productName())){
+        return nullptr;
+    }
 
-bool GlassCatalog::loadAGF(const QString& AGFpath, QString& parse_result)
+    Glass* g = arena_.create(glass);
+    g->setSupplier(supplier_);
+
+    glasses_.append(g);
+    name_to_int_map_.insert(g->productName(), glasses_.size() - 1);
+
+    return g;
+}
+
+
+bool GlassCatalog::loadAGF(const QString& AGFpath, ParseDiagnostics& diagnostics)
 {
     QFile file(AGFpath);
     if (! file.open(QIODevice::ReadOnly)) {
@@ -91,7 +99,7 @@ bool GlassCatalog::loadAGF(const QString& AGFpath, QString& parse_result)
 
 
     // parse result
-    QString filename = QFileInfo(AGFpath).fileName();
+    int fileId = diagnostics.addFile(AGFpath);
 
     this->clear();
 
@@ -113,7 +121,7 @@ bool GlassCatalog::loadAGF(const QString& AGFpath, QString& parse_result)
         if(linetext.startsWith("NM"))
         {
             lineparts = linetext.simplified().split(" ");
-            g = new Glass;
+            g = arena_.create();
             glasses_.append(g);
             glasses_.last()->setName(lineparts[1]);
             glasses_.last()->setSupplier(supplier_);
@@ -128,7 +136,7 @@ bool GlassCatalog::loadAGF(const QString& AGFpath, QString& parse_result)
             }
 
             if(glasses_.last()->formulaName() == "Unknown"){
-                parse_result += filename + "(" + QString::number(linecount) + "): " + glasses_.last()->productName() + ": " + "Unknown dispersion formula\n";
+                diagnostics.append(fileId, linecount, glasses_.size()-1, ParseDiagnostics::UnknownDispersionFormula);
             }
         }
 
@@ -166,7 +174,7 @@ bool GlassCatalog::loadAGF(const QString& AGFpath, QString& parse_result)
                 }
             }else{
                 glasses_.last()->setHasThermalData(false);
-                parse_result += filename + "(" + QString::number(linecount) + "): " + glasses_.last()->productName() + ": " + "Thermal Data Not Found\n";
+                diagnostics.append(fileId, linecount, glasses_.size()-1, ParseDiagnostics::ThermalDataNotFound);
             }
         }
 
@@ -213,7 +221,7 @@ bool GlassCatalog::loadAGF(const QString& AGFpath, QString& parse_result)
                 }
             }
             else{
-                parse_result += filename + "(" + QString::number(linecount) + "): " + glasses_.last()->productName() + ": " + "Other Data Not Found\n";
+                diagnostics.append(fileId, linecount, glasses_.size()-1, ParseDiagnostics::OtherDataNotFound);
             }
 
         }
@@ -234,18 +242,25 @@ bool GlassCatalog::loadAGF(const QString& AGFpath, QString& parse_result)
                 glasses_.last()->appendTransmittanceData(lineparts[1].toDouble(), lineparts[2].toDouble(), lineparts[3].toDouble());
             }
             else{
-                parse_result += filename + "(" + QString::number(linecount) + "): " + glasses_.last()->productName() + ": " + "Transmittance Data Not Found\n";
+                diagnostics.append(fileId, linecount, glasses_.size()-1, ParseDiagnostics::TransmittanceDataNotFound);
             }
         }
     }
 
     file.close();
 
+    QStringList glassNames;
+    glassNames.reserve(glasses_.size());
+    for(auto &&glass : glasses_){
+        glassNames.append(glass->productName());
+    }
+    diagnostics.setGlassNames(fileId, glassNames);
+
     return true;
 }
 
 
-bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
+bool GlassCatalog::loadXml(QString xmlpath, ParseDiagnostics& diagnostics)
 {
     pugi::xml_document doc;
     if(!doc.load_file(xmlpath.toUtf8().data())) {
@@ -253,7 +268,7 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
     }
 
     // parse result
-    QString filename = QFileInfo(xmlpath).fileName();
+    int fileId = diagnostics.addFile(xmlpath);
 
     this->clear();
 
@@ -267,7 +282,7 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
 
     for (pugi::xml_node_iterator glass_it = nodeglasses_.begin(); glass_it != nodeglasses_.end(); glass_it++ )
     {
-        g = new Glass;
+        g = arena_.create();
         g->setSupplier(supplier_);
         g->setName(glass_it->child("GlassName").child_value());
         g->setMIL(glass_it->child("NumericName").child_value());
@@ -294,7 +309,7 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
         }
         else{
             g->setDispForm(13); //unknown
-            parse_result += filename + ": " + g->productName() + ": " + "Unknown dispersion formula\n";
+            diagnostics.append(fileId, 0, glassNumber, ParseDiagnostics::UnknownDispersionFormula);
         }
 
 
@@ -311,13 +326,13 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
             g->setLowTCE(glass_it->child("LowCTE").child("Value").text().as_double());
         }
         else{
-            parse_result += filename + ": " + g->productName() + ": " + "Not found LowCTE\n";
+            diagnostics.append(fileId, 0, glassNumber, ParseDiagnostics::LowTCENotFound);
         }
         if(glass_it->child("HighCTE")){
             g->setHighTCE(glass_it->child("HighCTE").child("Value").text().as_double());
         }
         else{
-            parse_result += filename + ": " + g->productName() + ": " + "Not found HighCTE\n";
+            diagnostics.append(fileId, 0, glassNumber, ParseDiagnostics::HighTCENotFound);
         }
 
         // Manufacturer's properties
@@ -347,16 +362,16 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
         }
         // append parse result of manufacturer property
         if(!hasAcidResist){
-            parse_result += filename + ": " + g->productName() + ": " + "Not found Acid Resist\n";
+            diagnostics.append(fileId, 0, glassNumber, ParseDiagnostics::AcidResistNotFound);
         }
         if(!hasClimateResist){
-            parse_result += filename + ": " + g->productName() + ": " + "Not found Climate Resist\n";
+            diagnostics.append(fileId, 0, glassNumber, ParseDiagnostics::ClimateResistNotFound);
         }
         if(!hasStainResist){
-            parse_result += filename + ": " + g->productName() + ": " + "Not found Stain Resist\n";
+            diagnostics.append(fileId, 0, glassNumber, ParseDiagnostics::StainResistNotFound);
         }
         if(!hasAlkaliResist){
-            parse_result += filename + ": " + g->productName() + ": " + "Not found Alkali Resist\n";
+            diagnostics.append(fileId, 0, glassNumber, ParseDiagnostics::AlkaliResistNotFound);
         }
 
         // transmittance
@@ -392,7 +407,7 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
         }
         else{
             g->setHasThermalData(false);
-            parse_result += filename + ": " + g->productName() + ": " + "Not found DnDtConstants\n";
+            diagnostics.append(fileId, 0, glassNumber, ParseDiagnostics::ThermalDataNotFound);
         }
 
         // append to list
@@ -405,5 +420,37 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
 
     g = nullptr;
 
+    QStringList glassNames;
+    glassNames.reserve(glasses_.size());
+    for(auto &&glass : glasses_){
+        glassNames.append(glass->productName());
+    }
+    diagnostics.setGlassNames(fileId, glassNames);
+
     return true;
 }
+
+
+void GlassCatalog::compare(const GlassCatalog& other, QStringList& added, QStringList& removed, QStringList& changed) const
+{
+    added.clear();
+    removed.clear();
+    changed.clear();
+
+    for(auto &g : glasses_){
+        const Glass* newGlass = other.glass(g->productName());
+        if(!newGlass){
+            removed.append(g->productName());
+        }
+        else if(!g->hasSameData(*newGlass)){
+            changed.append(g->productName());
+        }
+    }
+
+    for(int i = 0; i < other.glassCount(); i++){
+        const Glass* newGlass = other.glass(i);
+        if(!hasGlass(newGlass->productName())){
+            added.append(newGlass->productName());
+        }
+    }
+}
@@ -28,8 +28,12 @@
 #include <QString>
 #include <QList>
 #include <QMap>
+#include <QStringList>
+
+#include "parse_diagnostics.h"
 
 #include "glass.h"
+#include "glass_arena.h"
 
 /** GlassCatalog Container Class */
 class GlassCatalog
@@ -48,25 +52,44 @@ public:
     /**
      * @brief Load glass data from Zemax AGF file
      * @param AGFpath AGF file path
-     * @param parse_result Container for notable parse results
+     * @param diagnostics Container for notable parse results
      * @return
      */
-    bool loadAGF(const QString& AGFpath, QString& parse_result);
+    bool loadAGF(const QString& AGFpath, ParseDiagnostics& diagnostics);
 
 
     /**
      * @brief Load glass data from CODEV Xml file
      * @param xmlpath Xml file path
-     * @param parse_result Container for notable parse results
+     * @param diagnostics Container for notable parse results
      * @return
      */
-    bool loadXml(QString xmlpath, QString& parse_result);
+    bool loadXml(QString xmlpath, ParseDiagnostics& diagnostics);
+
+    /** Set supplier name of a catalog built by addGlass() */
+    void setSupplier(const QString& supplier) {supplier_ = supplier;}
+
+    /**
+     * @brief Add a copy of the glass, whose supplier is replaced with that of this catalog
+     * @return the added glass, or nullptr if the name already exists
+     */
+    Glass* addGlass(const Glass& glass);
 
     void clear();
 
+    /**
+     * @brief Compare this catalog with the other one
+     * @param other newly loaded catalog of the same file
+     * @param added names of the glasses contained only in the other
+     * @param removed names of the glasses contained only in this
+     * @param changed names of the glasses whose data are different
+     */
+    void compare(const GlassCatalog& other, QStringList& added, QStringList& removed, QStringList& changed) const;
+
 private:
     QString       supplier_;
     QList<Glass*> glasses_;
+    GlassArena    arena_; // owns all the glasses
 
     QMap<QString, int> name_to_int_map_;
 };
@@ -25,107 +25,458 @@
 #include <QFileInfo>
 #include <QTextCodec>
 #include <QTextStream>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QtConcurrent>
 #include "glass_catalog_manager.h"
 
-QList<GlassCatalog*> GlassCatalogManager::m_catalogList;
+GlassCatalogManager* GlassCatalogManager::m_instance = nullptr;
+std::shared_ptr<const CatalogSnapshot> GlassCatalogManager::m_snapshot = std::make_shared<const CatalogSnapshot>();
+double               GlassCatalogManager::m_temperature = 25.0;
+NormalLine::Reference GlassCatalogManager::m_normalLineReference = NormalLine::ReferenceK7F2;
+DerivedColumnCache    GlassCatalogManager::m_derivedColumns;
 
-GlassCatalogManager::GlassCatalogManager()
+GlassCatalogManager::GlassCatalogManager(QObject* parent) :
+    QObject(parent)
 {
+    m_instance = this;
 
+    m_fileWatcher = nullptr;
+
+    // Editors and generators often write a file in several steps, so the reload is postponed until the file is settled.
+    m_reloadTimer = new QTimer(this);
+    m_reloadTimer->setSingleShot(true);
+    m_reloadTimer->setInterval(500);
+    QObject::connect(m_reloadTimer, SIGNAL(timeout()), this, SLOT(reloadModifiedFiles()));
+
+    m_reloadWatcher = new QFutureWatcher<ReloadResult>(this);
+    QObject::connect(m_reloadWatcher, SIGNAL(finished()), this, SLOT(onReloadFinished()));
 }
 
 GlassCatalogManager::~GlassCatalogManager()
 {
-    if(!m_catalogList.isEmpty())
-    {
-        for (auto &cat: m_catalogList) {
-            delete cat;
-        }
-        m_catalogList.clear();
+    m_reloadWatcher->waitForFinished();
+
+    // Catalogs are deleted when the last reader releases the snapshot.
+    storeSnapshot(std::make_shared<const CatalogSnapshot>());
+
+    if(m_instance == this){
+        m_instance = nullptr;
     }
 }
 
+GlassCatalogManager* GlassCatalogManager::instance()
+{
+    return m_instance;
+}
 
-QList<GlassCatalog*>& GlassCatalogManager::catalogList()
+std::shared_ptr<const CatalogSnapshot> GlassCatalogManager::snapshot()
 {
-    return m_catalogList;
+    return std::atomic_load(&m_snapshot);
+}
+
+void GlassCatalogManager::storeSnapshot(const std::shared_ptr<const CatalogSnapshot> &snapshot)
+{
+    std::atomic_store(&m_snapshot, snapshot);
+
+    // The columns of the old snapshot are released.
+    m_derivedColumns.clear();
+
+    if(m_instance){
+        emit m_instance->tableUpdated();
+    }
+}
+
+DerivedColumnCache::Column GlassCatalogManager::derivedColumn(const std::shared_ptr<const CatalogSnapshot> &snapshot, const QString &property, QString *errorMessage)
+{
+    return m_derivedColumns.column(snapshot, property, errorMessage);
+}
+
+QList<const GlassCatalog*> GlassCatalogManager::catalogList()
+{
+    return snapshot()->catalogList();
 }
 
 bool GlassCatalogManager::isEmpty()
 {
-    return m_catalogList.isEmpty();
+    return snapshot()->isEmpty();
 }
 
-Glass* GlassCatalogManager::find(QString fullName)
+bool GlassCatalogManager::isListed(const Glass *glass, int catalogIndex, const QStringList &glassNames)
 {
-    QStringList splitedText  = fullName.split("_");
-    QString     productName  = splitedText[0];
-    QString     supplierName = splitedText[1];
+    std::shared_ptr<const CatalogSnapshot> current = snapshot();
 
-    int catalogCount = m_catalogList.size();
-    for(int i = 0; i < catalogCount; i++) {
-        if(m_catalogList[i]->supplier() == supplierName){
-            if(m_catalogList[i]->hasGlass(productName)){
-                return m_catalogList[i]->glass(productName);
-            }
-        }
+    if(!glass || catalogIndex >= current->catalogCount()){
+        return false;
     }
 
-    return nullptr;
+    return ( glass->supplier() == current->catalog(catalogIndex)->supplier() && glassNames.contains(glass->productName()) );
 }
 
-void GlassCatalogManager::loadCatalogFiles(const QStringList &catalogFilePaths, QString& parseResult)
+QString GlassCatalogManager::catalogFilePath(int catalogIndex)
 {
-    if(catalogFilePaths.empty()) {
+    return snapshot()->catalogFilePath(catalogIndex);
+}
+
+QSharedPointer<const GlassTable> GlassCatalogManager::table()
+{
+    return snapshot()->table();
+}
+
+void GlassCatalogManager::setTemperature(double temperature)
+{
+    if(temperature == m_temperature){
         return;
     }
 
-    // clear old catalogs
-    if(!m_catalogList.isEmpty())
-    {
-        for (auto &cat: m_catalogList) {
-            delete cat;
-        }
-        m_catalogList.clear();
+    // The current temperature is used only by the GUI thread.  The tables and the background tasks are given the temperature explicitly.
+    m_temperature = temperature;
+    Glass::setCurrentTemperature(temperature);
+
+    // same catalogs with the table at the new temperature
+    std::shared_ptr<const CatalogSnapshot> current = snapshot();
+    QList<std::shared_ptr<const GlassCatalog>> catalogs;
+    for(int i = 0; i < current->catalogCount(); i++){
+        catalogs.append(current->sharedCatalog(i));
     }
+    storeSnapshot(std::make_shared<const CatalogSnapshot>(catalogs, current->catalogFilePaths(), m_temperature, m_normalLineReference));
+}
 
-    // load catalogs
-    GlassCatalog* catalog;
-    QString parse_result, parse_result_all;
+double GlassCatalogManager::temperature()
+{
+    return m_temperature;
+}
+
+void GlassCatalogManager::setNormalLineReference(NormalLine::Reference reference)
+{
+    if(reference == m_normalLineReference){
+        return;
+    }
+
+    m_normalLineReference = reference;
+    storeSnapshot(std::make_shared<const CatalogSnapshot>(*snapshot(), m_normalLineReference));
+}
+
+NormalLine::Reference GlassCatalogManager::normalLineReference()
+{
+    return m_normalLineReference;
+}
+
+Glass* GlassCatalogManager::find(QString fullName)
+{
+    return snapshot()->find(fullName);
+}
+
+void GlassCatalogManager::loadCatalogFiles(const QStringList &catalogFilePaths, ParseDiagnostics& diagnostics)
+{
+    if(catalogFilePaths.empty()) {
+        return;
+    }
 
-    QFileInfo finfo;
-    finfo.setFile(catalogFilePaths.first());
-    QString ext = finfo.suffix().toLower(); // .agf, .xml
+    // load catalogs
+    QList<GlassCatalog*> catalogs;
+    QStringList loadedFilePaths;
 
     for(int i = 0; i < catalogFilePaths.size(); i++){
-        catalog = new GlassCatalog;
-        parse_result.clear();
-
-        bool ok;
-        if(ext == "agf"){
-            ok = catalog->loadAGF(catalogFilePaths[i], parse_result);
-        }else{
-            ok = catalog->loadXml(catalogFilePaths[i], parse_result);
+        GlassCatalog* catalog = loadCatalogFile(catalogFilePaths[i], diagnostics);
+
+        if(catalog){
+            catalogs.append(catalog);
+            loadedFilePaths.append(catalogFilePaths[i]);
         }
+    }
+
+    publishCatalogs(catalogs, loadedFilePaths);
+}
+
+GlassCatalog* GlassCatalogManager::loadCatalogFile(const QString &catalogFilePath, ParseDiagnostics &diagnostics)
+{
+    QString ext = QFileInfo(catalogFilePath).suffix().toLower(); // .agf, .xml
+
+    GlassCatalog* catalog = new GlassCatalog;
+
+    bool ok;
+    if(ext == "agf"){
+        ok = catalog->loadAGF(catalogFilePath, diagnostics);
+    }else{
+        ok = catalog->loadXml(catalogFilePath, diagnostics);
+    }
+
+    if(!ok){
+        int fileId = diagnostics.addFile(catalogFilePath);
+        diagnostics.append(fileId, 0, -1, ParseDiagnostics::CatalogLoadingError);
+        delete catalog;
+        return nullptr;
+    }
+
+    return catalog;
+}
+
+void GlassCatalogManager::publishCatalogs(const QList<GlassCatalog*> &catalogs, const QStringList &catalogFilePaths)
+{
+    publishCatalogs(catalogs, catalogFilePaths, m_temperature, m_normalLineReference);
+}
+
+void GlassCatalogManager::publishCatalogs(const QList<GlassCatalog*> &catalogs, const QStringList &catalogFilePaths, double temperature, NormalLine::Reference normalLineReference)
+{
+    m_temperature         = temperature;
+    m_normalLineReference = normalLineReference;
+    Glass::setCurrentTemperature(temperature);
+
+    Q_ASSERT(catalogs.size() == catalogFilePaths.size());
+
+    QList<std::shared_ptr<const GlassCatalog>> sharedCatalogs;
+    for(auto &cat : catalogs){
+        sharedCatalogs.append(std::shared_ptr<const GlassCatalog>(cat));
+    }
+
+    // The old catalogs are deleted when the last reader releases the old snapshot.
+    storeSnapshot(std::make_shared<const CatalogSnapshot>(sharedCatalogs, catalogFilePaths, m_temperature, m_normalLineReference));
+
+    if(m_instance){
+        m_instance->resetWatchedFiles();
+    }
+}
+
+void GlassCatalogManager::appendCatalogs(const QList<GlassCatalog*> &catalogs, const QStringList &catalogFilePaths)
+{
+    Q_ASSERT(catalogs.size() == catalogFilePaths.size());
+
+    // The current catalogs are shared with the new snapshot.
+    std::shared_ptr<const CatalogSnapshot> current = snapshot();
+    QList<std::shared_ptr<const GlassCatalog>> sharedCatalogs;
+    for(int i = 0; i < current->catalogCount(); i++){
+        sharedCatalogs.append(current->sharedCatalog(i));
+    }
+    for(auto &cat : catalogs){
+        sharedCatalogs.append(std::shared_ptr<const GlassCatalog>(cat));
+    }
+
+    storeSnapshot(std::make_shared<const CatalogSnapshot>(sharedCatalogs, current->catalogFilePaths() + catalogFilePaths, m_temperature, m_normalLineReference));
+
+    if(m_instance){
+        m_instance->resetWatchedFiles();
+    }
+}
+
+int GlassCatalogManager::addMemoryCatalog(GlassCatalog *catalog)
+{
+    std::shared_ptr<const CatalogSnapshot> current = snapshot();
+    std::shared_ptr<const GlassCatalog> newCatalog(catalog);
 
-        if(ok){
-            m_catalogList.append(catalog);
-            parse_result_all += parse_result;
+    // A memory catalog has no file path.
+    QList<std::shared_ptr<const GlassCatalog>> catalogs;
+    QStringList catalogFilePaths = current->catalogFilePaths();
+    int catalogIndex = -1;
+    for(int i = 0; i < current->catalogCount(); i++){
+        if(catalogFilePaths[i].isEmpty() && current->catalog(i)->supplier() == catalog->supplier()){
+            catalogIndex = i;
+            catalogs.append(newCatalog);
         }
         else{
-            parse_result_all += ("Catalog loading error:" + catalogFilePaths[i] + "\n");
-            try {
-                delete catalog;
-            }  catch (...) {
-                return;
-            }
+            catalogs.append(current->sharedCatalog(i));
+        }
+    }
+
+    QStringList added, removed, changed;
+    if(catalogIndex < 0){
+        catalogIndex = catalogs.size();
+        catalogs.append(newCatalog);
+        catalogFilePaths.append(QString());
+        for(int i = 0; i < catalog->glassCount(); i++){
+            added.append(catalog->glass(i)->productName());
+        }
+    }
+    else{
+        current->catalog(catalogIndex)->compare(*catalog, added, removed, changed);
+    }
+
+    storeSnapshot(std::make_shared<const CatalogSnapshot>(catalogs, catalogFilePaths, m_temperature, m_normalLineReference));
+
+    // The old glasses are kept alive by the current snapshot held here.
+    if(m_instance){
+        if(!removed.isEmpty()){
+            emit m_instance->glassesRemoved(catalogIndex, removed);
+        }
+
+        if(!changed.isEmpty()){
+            emit m_instance->glassesChanged(catalogIndex, changed);
+        }
+
+        if(!added.isEmpty()){
+            emit m_instance->glassesAdded(catalogIndex, added);
+        }
+    }
+
+    return catalogIndex;
+}
+
+void GlassCatalogManager::setWatchEnabled(bool state)
+{
+    if(state == isWatchEnabled()){
+        return;
+    }
+
+    if(state){
+        m_fileWatcher = new QFileSystemWatcher(this);
+        QObject::connect(m_fileWatcher, SIGNAL(fileChanged(QString)), this, SLOT(onFileChanged(QString)));
+        resetWatchedFiles();
+    }
+    else{
+        m_reloadTimer->stop();
+        m_modifiedFiles.clear();
+        delete m_fileWatcher;
+        m_fileWatcher = nullptr;
+    }
+}
+
+bool GlassCatalogManager::isWatchEnabled() const
+{
+    return (m_fileWatcher != nullptr);
+}
+
+void GlassCatalogManager::resetWatchedFiles()
+{
+    if(!m_fileWatcher){
+        return;
+    }
+
+    if(!m_fileWatcher->files().isEmpty()){
+        m_fileWatcher->removePaths(m_fileWatcher->files());
+    }
+    m_modifiedFiles.clear();
+
+    // memory catalogs have no file
+    QStringList catalogFilePaths = snapshot()->catalogFilePaths();
+    catalogFilePaths.removeAll(QString());
+    if(!catalogFilePaths.isEmpty()){
+        m_fileWatcher->addPaths(catalogFilePaths);
+    }
+}
+
+void GlassCatalogManager::onFileChanged(const QString &path)
+{
+    m_modifiedFiles.insert(path);
+    m_reloadTimer->start();
+}
+
+void GlassCatalogManager::reloadModifiedFiles()
+{
+    if(!m_fileWatcher){
+        return;
+    }
+
+    // One reload at a time. The files modified meanwhile are reloaded after it.
+    if(m_reloadWatcher->isRunning()){
+        m_reloadTimer->start();
+        return;
+    }
+
+    std::shared_ptr<const CatalogSnapshot> current = snapshot();
+    QList<int> catalogIndices;
+
+    for(auto &path : m_modifiedFiles){
+        int catalogIndex = current->catalogFilePaths().indexOf(path);
+        if(catalogIndex < 0){
             continue;
         }
+
+        // A file replaced by rename is dropped from the watcher, so it is added again.
+        if(QFileInfo::exists(path)){
+            if(!m_fileWatcher->files().contains(path)){
+                m_fileWatcher->addPath(path);
+            }
+            catalogIndices.append(catalogIndex);
+        }
+    }
+
+    m_modifiedFiles.clear();
+
+    if(!catalogIndices.isEmpty()){
+        m_reloadWatcher->setFuture(QtConcurrent::run(&GlassCatalogManager::reloadCatalogFiles, current, catalogIndices, m_temperature, m_normalLineReference));
+    }
+}
+
+GlassCatalogManager::ReloadResult GlassCatalogManager::reloadCatalogFiles(std::shared_ptr<const CatalogSnapshot> baseSnapshot, const QList<int>& catalogIndices, double temperature, NormalLine::Reference normalLineReference)
+{
+    // This function runs in a worker thread and never touches the current snapshot.
+    // The table is built at the given temperature, not at the current one which the GUI thread may be changing.
+    ReloadResult result;
+    result.baseSnapshot = baseSnapshot;
+
+    QList<std::shared_ptr<const GlassCatalog>> catalogs;
+    for(int i = 0; i < baseSnapshot->catalogCount(); i++){
+        catalogs.append(baseSnapshot->sharedCatalog(i));
     }
 
-    catalog = nullptr;
+    for(int catalogIndex : catalogIndices){
+        QString path = baseSnapshot->catalogFilePath(catalogIndex);
+        ParseDiagnostics diagnostics;
+
+        // On failure, the records of the file, including the loading error added by loadCatalogFile(), are reported and the previous catalog is kept.
+        std::shared_ptr<const GlassCatalog> newCatalog(loadCatalogFile(path, diagnostics));
+        if(!newCatalog){
+            result.diagnostics.merge(diagnostics);
+            continue;
+        }
+
+        QStringList added, removed, changed;
+        baseSnapshot->catalog(catalogIndex)->compare(*newCatalog, added, removed, changed);
+        if(added.isEmpty() && removed.isEmpty() && changed.isEmpty()){
+            continue;
+        }
+
+        catalogs[catalogIndex] = newCatalog;
+        result.catalogIndices.append(catalogIndex);
+        result.added.append(added);
+        result.removed.append(removed);
+        result.changed.append(changed);
+    }
 
-    parseResult = parse_result_all;
+    if(!result.catalogIndices.isEmpty()){
+        result.newSnapshot = std::make_shared<const CatalogSnapshot>(catalogs, baseSnapshot->catalogFilePaths(), temperature, normalLineReference);
+    }
 
+    return result;
 }
 
+void GlassCatalogManager::onReloadFinished()
+{
+    ReloadResult result = m_reloadWatcher->result();
+
+    if(!result.diagnostics.isEmpty()){
+        emit reloadFailed(result.diagnostics);
+    }
+
+    if(!result.newSnapshot){
+        return;
+    }
+
+    // The catalogs were replaced or the temperature was changed during the reload, so the result is outdated.
+    if(result.baseSnapshot != snapshot()){
+        for(int catalogIndex : result.catalogIndices){
+            m_modifiedFiles.insert(result.baseSnapshot->catalogFilePath(catalogIndex));
+        }
+        m_reloadTimer->start();
+        return;
+    }
+
+    // The old snapshot is held by the result until the receivers of the signals have released the old glasses.
+    storeSnapshot(result.newSnapshot);
+
+    for(int i = 0; i < result.catalogIndices.size(); i++){
+        int catalogIndex = result.catalogIndices[i];
+
+        if(!result.removed[i].isEmpty()){
+            emit glassesRemoved(catalogIndex, result.removed[i]);
+        }
+
+        if(!result.changed[i].isEmpty()){
+            emit glassesChanged(catalogIndex, result.changed[i]);
+        }
+
+        if(!result.added[i].isEmpty()){
+            emit glassesAdded(catalogIndex, result.added[i]);
+        }
+    }
+}
@@ -26,26 +26,177 @@
 #ifndef GLASSCATALOGMANAGER_H
 #define GLASSCATALOGMANAGER_H
 
+#include <memory>
+
+#include <QObject>
 #include <QString>
 #include <QList>
 #include <QStringList>
+#include <QSet>
+#include <QSharedPointer>
+#include <QFutureWatcher>
 
 #include "glass_catalog.h"
+#include "glass_table.h"
+#include "catalog_snapshot.h"
+#include "derived_column_cache.h"
+
+class QFileSystemWatcher;
+class QTimer;
 
-/** top level management class */
-class GlassCatalogManager
+/**
+ * @brief top level management class
+ * @details The catalogs are published as an immutable CatalogSnapshot. The current snapshot is replaced by an atomic pointer swap,
+ *          so that a reader in any thread can take the snapshot by snapshot() and keep using it without lock while the catalogs are reloaded.
+ *          The static functions other than snapshot() and loadCatalogFile() access the current snapshot and should be called from the GUI thread.
+ */
+class GlassCatalogManager : public QObject
 {
+    Q_OBJECT
+
 public:
-    GlassCatalogManager();
+    GlassCatalogManager(QObject* parent = nullptr);
     ~GlassCatalogManager();
 
-    static QList<GlassCatalog*>& catalogList();
+    /** The instance to which the signals are connected */
+    static GlassCatalogManager* instance();
+
+    /** Current snapshot. This function is thread-safe. */
+    static std::shared_ptr<const CatalogSnapshot> snapshot();
+
+    static QList<const GlassCatalog*> catalogList();
     static bool isEmpty();
     static Glass* find(QString fullName);
-    static void loadCatalogFiles(const QStringList& catalogFilePaths, QString& parseResult);
+    static void loadCatalogFiles(const QStringList& catalogFilePaths, ParseDiagnostics& diagnostics);
+
+    /**
+     * @brief Parse a catalog file (AGF/XML).  This function does not touch the current catalogs, so it can be called from any thread.
+     * @param catalogFilePath file path
+     * @param diagnostics container for notable parse results.  A loading error is also recorded in it.
+     * @return new catalog, or nullptr if failed
+     */
+    static GlassCatalog* loadCatalogFile(const QString& catalogFilePath, ParseDiagnostics& diagnostics);
+
+    /**
+     * @brief Replace all the current catalogs with the new ones at once.  Call from the GUI thread.
+     * @param catalogs new catalogs, whose ownership is transferred to the manager
+     * @param catalogFilePaths file path of each catalog
+     */
+    static void publishCatalogs(const QList<GlassCatalog*>& catalogs, const QStringList& catalogFilePaths);
+
+    /**
+     * @brief Replace all the catalogs, and set the temperature and the normal line reference of the new table.
+     * @details Only one table is built, whereas setTemperature() and setNormalLineReference() would rebuild the table of the old catalogs.
+     */
+    static void publishCatalogs(const QList<GlassCatalog*>& catalogs, const QStringList& catalogFilePaths, double temperature, NormalLine::Reference normalLineReference);
+
+    /**
+     * @brief Append the new catalogs to the current ones, e.g. the files loaded since the last publication.  Call from the GUI thread.
+     * @param catalogs new catalogs, whose ownership is transferred to the manager
+     * @param catalogFilePaths file path of each catalog
+     */
+    static void appendCatalogs(const QList<GlassCatalog*>& catalogs, const QStringList& catalogFilePaths);
+
+    /**
+     * @brief Add a catalog which is not loaded from a file, e.g. fitted melt data.  Call from the GUI thread.
+     * @details A catalog of the same supplier added before is replaced, and the differences are notified by the glass signals.
+     * @param catalog new catalog, whose ownership is transferred to the manager
+     * @return index of the catalog
+     */
+    static int addMemoryCatalog(GlassCatalog* catalog);
+
+    /** Returns true if the glass belongs to the catalog and its name is in the list.  Convenient for the receivers of the signals. */
+    static bool isListed(const Glass* glass, int catalogIndex, const QStringList& glassNames);
+
+    /** File path from which the catalog was loaded */
+    static QString catalogFilePath(int catalogIndex);
+
+    /** Columnar table of the current snapshot.  Hold the returned pointer while reading it. */
+    static QSharedPointer<const GlassTable> table();
+
+    /**
+     * @brief Column of a property derived from the table, which is computed once per snapshot and shared by all the forms.  This function is thread-safe.
+     * @param snapshot snapshot of the table, usually the current one
+     * @param property column name of the table, or expression of GlassExpression
+     * @param errorMessage message of the syntax error of the expression
+     * @return value of each row, or null if the property is invalid
+     */
+    static DerivedColumnCache::Column derivedColumn(const std::shared_ptr<const CatalogSnapshot>& snapshot, const QString& property, QString* errorMessage = nullptr);
+
+    /** Set current temperature of all glasses and rebuild the table */
+    static void setTemperature(double temperature);
+    static double temperature();
+
+    /** Set reference of the normal lines and recompute the deviations of the partial dispersions */
+    static void setNormalLineReference(NormalLine::Reference reference);
+    static NormalLine::Reference normalLineReference();
+
+    /**
+     * @brief Set watching mode on/off
+     * @details In watching mode, a modified catalog file is reparsed in a background thread and a new snapshot is published.
+     */
+    void setWatchEnabled(bool state);
+    bool isWatchEnabled() const;
+
+signals:
+    /**
+     * @brief Emitted after a new snapshot in which the glasses were added has been published.
+     */
+    void glassesAdded(int catalogIndex, const QStringList& glassNames);
+
+    /**
+     * @brief Emitted after a new snapshot without the glasses has been published.
+     * @details The old glasses are kept alive during the emission. Receivers should release the pointers to them.
+     */
+    void glassesRemoved(int catalogIndex, const QStringList& glassNames);
+
+    /**
+     * @brief Emitted after a new snapshot with the modified glasses has been published.
+     * @details The old glasses are kept alive during the emission. Receivers should replace the pointers to them with find().
+     */
+    void glassesChanged(int catalogIndex, const QStringList& glassNames);
+
+    /** Emitted when a new snapshot has been published */
+    void tableUpdated();
+
+    /**
+     * @brief Emitted when modified catalog files could not be reloaded
+     * @details The previous catalogs of the files are kept.  The diagnostics contain the records of the failed files.
+     */
+    void reloadFailed(const ParseDiagnostics& diagnostics);
+
+private slots:
+    void onFileChanged(const QString& path);
+    void reloadModifiedFiles();
+    void onReloadFinished();
 
 private:
-    static QList<GlassCatalog*> m_catalogList;
+    /** Result of the background reload */
+    struct ReloadResult{
+        std::shared_ptr<const CatalogSnapshot> baseSnapshot;
+        std::shared_ptr<const CatalogSnapshot> newSnapshot;
+        QList<int>         catalogIndices;
+        QList<QStringList> added;
+        QList<QStringList> removed;
+        QList<QStringList> changed;
+        ParseDiagnostics   diagnostics; // records of the files which failed to load
+    };
+
+    static ReloadResult reloadCatalogFiles(std::shared_ptr<const CatalogSnapshot> baseSnapshot, const QList<int>& catalogIndices, double temperature, NormalLine::Reference normalLineReference);
+    static void storeSnapshot(const std::shared_ptr<const CatalogSnapshot>& snapshot);
+
+    void resetWatchedFiles();
+
+    static GlassCatalogManager* m_instance;
+    static std::shared_ptr<const CatalogSnapshot> m_snapshot; // accessed only by std::atomic_load/atomic_store
+    static double               m_temperature;
+    static NormalLine::Reference m_normalLineReference;
+    static DerivedColumnCache    m_derivedColumns;
+
+    QFileSystemWatcher* m_fileWatcher;
+    QTimer*             m_reloadTimer;
+    QSet<QString>       m_modifiedFiles;
+    QFutureWatcher<ReloadResult>* m_reloadWatcher;
 };
 
 #endif
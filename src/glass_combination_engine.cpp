@@ -0,0 +1,300 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_combination_engine.h"
+
+#include <algorithm>
+#include <QtNumeric>
+
+namespace {
+
+bool meritLess(const GlassCombinationEngine::Combination& a, const GlassCombinationEngine::Combination& b)
+{
+    return a.merit < b.merit;
+}
+
+/** Push the combination into the max-heap of size k, and return the k-th merit if the heap is full */
+double pushResult(QVector<GlassCombinationEngine::Combination>& heap, const GlassCombinationEngine::Combination& c, int k, double bound)
+{
+    heap.append(c);
+    std::push_heap(heap.begin(), heap.end(), meritLess);
+    if(heap.size() > k){
+        std::pop_heap(heap.begin(), heap.end(), meritLess);
+        heap.removeLast();
+    }
+    if(heap.size() == k){
+        return qMin(bound, heap.first().merit);
+    }
+    return bound;
+}
+
+}
+
+GlassCombinationEngine::GlassCombinationEngine()
+{
+    m_settings.mode            = Pair;
+    m_settings.maxPowerSum     = 5.0;
+    m_settings.excludeObsolete = true;
+
+    m_xmin = m_xmax = m_ymin = m_ymax = 0.0;
+}
+
+void GlassCombinationEngine::prepare(const QSharedPointer<const GlassTable> &table, const Settings &settings)
+{
+    m_table    = table;
+    m_settings = settings;
+    m_candidates.clear();
+    m_kdTree.clear();
+    m_xyTree.clear();
+
+    if(!m_table){
+        return;
+    }
+
+    const GlassTable* t = m_table.data();
+    const QVector<quint8>& status = t->statusColumn();
+    const QVector<double>& vd  = t->column(GlassTable::ColumnVd);
+    const QVector<double>& PgF = t->column(GlassTable::ColumnPgF);
+    const QVector<double>& nh  = t->refractiveIndices(GlassTable::spectralLineIndex("h"));
+    const QVector<double>& nF  = t->refractiveIndices(GlassTable::spectralLineIndex("F"));
+    const QVector<double>& nC  = t->refractiveIndices(GlassTable::spectralLineIndex("C"));
+
+    for(int row = 0; row < t->rowCount(); row++){
+        if(!t->isValid(row)){
+            continue;
+        }
+        if(m_settings.excludeObsolete && GlassTable::StatusObsolete == status[row]){
+            continue;
+        }
+        if(!m_settings.catalogs.isEmpty()){
+            int ci = t->catalogIndex(row);
+            if(ci >= m_settings.catalogs.size() || !m_settings.catalogs[ci]){
+                continue;
+            }
+        }
+
+        Candidate c;
+        c.row = row;
+        c.vd  = vd[row];
+        c.PgF = PgF[row];
+        c.PhF = (nh[row] - nF[row])/(nF[row] - nC[row]);
+        if(!qIsFinite(c.vd) || !qIsFinite(c.PgF) || !qIsFinite(c.PhF) || c.vd <= 0){
+            continue;
+        }
+        c.x = 1.0/c.vd;
+        c.y = c.PgF/c.vd;
+        m_candidates.append(c);
+    }
+
+    std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate& a, const Candidate& b){
+        return a.vd < b.vd;
+    });
+
+    QVector<KdTree2D::Point> points(m_candidates.size());
+    QVector<KdTree2D::Point> xyPoints(m_candidates.size());
+    m_xmin = m_ymin =  qInf();
+    m_xmax = m_ymax = -qInf();
+    for(int i = 0; i < m_candidates.size(); i++){
+        const Candidate& c = m_candidates[i];
+        points[i]   = KdTree2D::Point{c.vd, c.PgF, i};
+        xyPoints[i] = KdTree2D::Point{c.x, c.y, i};
+        m_xmin = qMin(m_xmin, c.x);
+        m_xmax = qMax(m_xmax, c.x);
+        m_ymin = qMin(m_ymin, c.y);
+        m_ymax = qMax(m_ymax, c.y);
+    }
+    m_kdTree.build(points);
+    m_xyTree.build(xyPoints);
+}
+
+QVector<GlassCombinationEngine::Combination> GlassCombinationEngine::runTask(int task, int k) const
+{
+    if(task < 0 || task >= m_candidates.size() || k <= 0){
+        return QVector<Combination>();
+    }
+
+    QVector<Combination> results = (Triplet == m_settings.mode) ? runTripletTask(task, k) : runPairTask(task, k);
+    std::sort(results.begin(), results.end(), meritLess);
+    return results;
+}
+
+QVector<GlassCombinationEngine::Combination> GlassCombinationEngine::runPairTask(int a, int k) const
+{
+    // The first glass is the positive (crown) element, whose vd is larger than the second.
+    // powers: pa = va/(va - vb), pb = -vb/(va - vb)
+    // sum of absolute powers (va + vb)/(va - vb) <= M  <=>  vb <= va*(M - 1)/(M + 1)
+    // secondary spectrum: (Pa - Pb)/(va - vb)
+    QVector<Combination> heap;
+    heap.reserve(k + 1);
+
+    const double M = m_settings.maxPowerSum;
+    if(M <= 1.0 || m_candidates.isEmpty()){
+        return heap;
+    }
+
+    const Candidate& ca = m_candidates[a];
+    const double vbMax = ca.vd*(M - 1)/(M + 1);
+    const double vMin  = m_candidates.first().vd;
+    if(vbMax < vMin){
+        return heap;
+    }
+
+    // Until k pairs are found, all of the partial dispersions are accepted.
+    double bound = qInf();
+
+    auto evaluate = [&](int b){
+        const Candidate& cb = m_candidates[b];
+        if(cb.vd > vbMax){
+            return;
+        }
+        double dv       = ca.vd - cb.vd;
+        double residual = (ca.PgF - cb.PgF)/dv;
+        if(qAbs(residual) >= bound){
+            return;
+        }
+
+        Combination c;
+        c.count     = 2;
+        c.rows[0]   = ca.row;
+        c.rows[1]   = cb.row;
+        c.rows[2]   = -1;
+        c.powers[0] =  ca.vd/dv;
+        c.powers[1] = -cb.vd/dv;
+        c.powers[2] = 0.0;
+        c.powerSum  = (ca.vd + cb.vd)/dv;
+        c.residual  = residual;
+        c.merit     = qAbs(residual);
+        bound = pushResult(heap, c, k, bound);
+    };
+
+    // The candidates are sorted by vd.  Scan the first k to obtain the bound, then query the rest in the PgF window.
+    int b = 0;
+    for(; b < m_candidates.size() && heap.size() < k && m_candidates[b].vd <= vbMax; b++){
+        evaluate(b);
+    }
+    if(b < m_candidates.size() && m_candidates[b].vd <= vbMax){
+        // |Pb - Pa| < bound*(va - vb) <= bound*(va - vMin)
+        double window = bound*(ca.vd - vMin);
+        const QVector<int> ids = m_kdTree.rectangle(m_candidates[b].vd, vbMax, ca.PgF - window, ca.PgF + window);
+        for(int id : ids){
+            if(id >= b){
+                evaluate(id);
+            }
+        }
+    }
+
+    return heap;
+}
+
+QVector<GlassCombinationEngine::Combination> GlassCombinationEngine::runTripletTask(int i, int k) const
+{
+    // With (x, y) = (1/vd, PgF/vd), the powers are solved from
+    //   p1 + p2 + p3 = 1, p1*x1 + p2*x2 + p3*x3 = 0, p1*y1 + p2*y2 + p3*y3 = 0
+    // Let D be twice the signed area of the triangle of the glasses.
+    // Since p3 = (x1*y2 - x2*y1)/D, |p3| is the distance of the origin from the line of glass 1 and 2 divided by that of glass 3,
+    // so glass 3 must be far from the line for the powers to be small.
+    QVector<Combination> heap;
+    heap.reserve(k + 1);
+
+    const double M = m_settings.maxPowerSum;
+    const int    N = m_candidates.size();
+    if(M <= 1.0){
+        return heap;
+    }
+
+    const Candidate& c1 = m_candidates[i];
+
+    // The merit is the sum of absolute powers, which is at least |p3|.
+    double bound = M;
+
+    for(int j = i + 1; j < N; j++){
+        const Candidate& c2 = m_candidates[j];
+
+        // D = nx*x3 + ny*y3 - c
+        const double nx  = -(c2.y - c1.y);
+        const double ny  =   c2.x - c1.x;
+        const double c   = nx*c1.x + ny*c1.y;
+        const double num3 = -c; // x1*y2 - x2*y1
+
+        // upper bound of |D| over the bounding box, the corners of which give the extremes
+        double dmax = 0.0;
+        dmax = qMax(dmax, qAbs(nx*m_xmin + ny*m_ymin - c));
+        dmax = qMax(dmax, qAbs(nx*m_xmin + ny*m_ymax - c));
+        dmax = qMax(dmax, qAbs(nx*m_xmax + ny*m_ymin - c));
+        dmax = qMax(dmax, qAbs(nx*m_xmax + ny*m_ymax - c));
+        if(qAbs(num3) >= bound*dmax){
+            continue;
+        }
+
+        // |D| > |num3|/bound, so that glass 3 is on either side outside the strip along the line.
+        const double threshold = qAbs(num3)/bound;
+        QVector<int> ids = m_xyTree.halfPlane( nx,  ny,  c + threshold);
+        ids += m_xyTree.halfPlane(-nx, -ny, -c + threshold);
+        std::sort(ids.begin(), ids.end());
+
+        for(int l : ids){
+            if(l <= j){
+                continue;
+            }
+            const Candidate& c3 = m_candidates[l];
+
+            const double D = nx*c3.x + ny*c3.y - c;
+            if(qAbs(num3) >= bound*qAbs(D)){
+                continue;
+            }
+
+            const double p1 = (c2.x*c3.y - c3.x*c2.y)/D;
+            const double p2 = (c3.x*c1.y - c1.x*c3.y)/D;
+            const double p3 = num3/D;
+            const double powerSum = qAbs(p1) + qAbs(p2) + qAbs(p3);
+            if(powerSum >= bound){
+                continue;
+            }
+
+            Combination comb;
+            comb.count     = 3;
+            comb.rows[0]   = c1.row;
+            comb.rows[1]   = c2.row;
+            comb.rows[2]   = c3.row;
+            comb.powers[0] = p1;
+            comb.powers[1] = p2;
+            comb.powers[2] = p3;
+            comb.powerSum  = powerSum;
+            comb.residual  = p1*c1.PhF/c1.vd + p2*c2.PhF/c2.vd + p3*c3.PhF/c3.vd;
+            comb.merit     = powerSum;
+            bound = pushResult(heap, comb, k, bound);
+        }
+    }
+
+    return heap;
+}
+
+void GlassCombinationEngine::merge(QVector<Combination> &best, const QVector<Combination> &results, int k)
+{
+    best += results;
+    std::sort(best.begin(), best.end(), meritLess);
+    if(best.size() > k){
+        best.resize(k);
+    }
+}
@@ -0,0 +1,119 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_COMBINATION_ENGINE_H
+#define GLASS_COMBINATION_ENGINE_H
+
+#include <QVector>
+#include <QSharedPointer>
+
+#include "glass_table.h"
+#include "kd_tree_2d.h"
+
+/**
+ * @brief Search engine of achromatic pairs and apochromatic triplets of thin lenses in contact
+ * @details Powers are normalized so that the total power is 1.
+ *          A pair is corrected for C and F lines and ranked by the residual secondary spectrum (g-F).
+ *          A triplet is also corrected for the secondary spectrum and ranked by the sum of absolute powers,
+ *          whose residual is the tertiary spectrum (h-F).
+ *
+ *          The search is divided into tasks, each of which evaluates the combinations whose first glass is fixed,
+ *          so that the tasks can be run in parallel and the results can be shown as they are found.
+ *          Each task keeps its best k combinations and prunes the others by the k-th merit:
+ *          pairs by a rectangle query in (vd, PgF) space, and triplets by half-plane queries for the third glass
+ *          far enough from the line of the first two glasses in (1/vd, PgF/vd) space.
+ */
+class GlassCombinationEngine
+{
+public:
+    enum Mode{
+        Pair,
+        Triplet
+    };
+
+    struct Settings{
+        Mode          mode;
+        double        maxPowerSum;     // upper limit of the sum of absolute powers
+        bool          excludeObsolete;
+        QVector<bool> catalogs;        // accepted catalogs indexed by the catalog index, empty to accept all
+    };
+
+    struct Combination{
+        int    count;     // number of glasses
+        int    rows[3];   // rows in the table
+        double powers[3];
+        double powerSum;  // sum of absolute powers
+        double residual;  // secondary spectrum for pairs, tertiary spectrum for triplets
+        double merit;     // smaller is better
+    };
+
+    GlassCombinationEngine();
+
+    /** Set the table and the settings, and index the candidate glasses */
+    void prepare(const QSharedPointer<const GlassTable>& table, const Settings& settings);
+
+    const QSharedPointer<const GlassTable>& table() const { return m_table; }
+    const Settings& settings() const { return m_settings; }
+
+    /** @return number of the candidate glasses */
+    int candidateCount() const { return m_candidates.size(); }
+
+    /** @return number of the tasks */
+    int taskCount() const { return m_candidates.size(); }
+
+    /**
+     * @brief Evaluate the combinations of a task.  Thread-safe.
+     * @param task task index
+     * @param k maximum number of the results
+     * @return best combinations sorted by the merit
+     */
+    QVector<Combination> runTask(int task, int k) const;
+
+    /** Merge the results into the best k combinations sorted by the merit */
+    static void merge(QVector<Combination>& best, const QVector<Combination>& results, int k);
+
+private:
+    struct Candidate{
+        int    row;
+        double vd;
+        double PgF;
+        double PhF;
+        double x; // 1/vd
+        double y; // PgF/vd
+    };
+
+    QVector<Combination> runPairTask(int a, int k) const;
+    QVector<Combination> runTripletTask(int i, int k) const;
+
+    QSharedPointer<const GlassTable> m_table;
+    Settings                         m_settings;
+    QVector<Candidate>               m_candidates; // sorted by vd
+    KdTree2D                         m_kdTree;     // (vd, PgF) of the candidates, whose ids are the candidate indices
+    KdTree2D                         m_xyTree;     // (1/vd, PgF/vd) of the candidates, whose ids are the candidate indices
+
+    // bounding box of the candidates in (1/vd, PgF/vd) space
+    double m_xmin, m_xmax, m_ymin, m_ymax;
+};
+
+#endif // GLASS_COMBINATION_ENGINE_H
@@ -0,0 +1,212 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_combination_form.h"
+#include "ui_glass_combination_form.h"
+
+#include <QtConcurrent>
+#include <QDoubleValidator>
+#include <QIntValidator>
+#include <QListWidgetItem>
+
+#include "glass_catalog_manager.h"
+
+namespace {
+
+/** Interval of refreshing the result table while searching */
+constexpr int refreshIntervalMsec = 200;
+
+}
+
+GlassCombinationForm::GlassCombinationForm(QMdiArea *parent) :
+    QWidget(parent),
+    ui(new Ui::GlassCombinationForm),
+    m_parentMdiArea(parent)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Glass Combination");
+
+    m_resultCount = 0;
+    m_lastRefresh = 0;
+
+    ui->comboBox_Mode->addItems(QStringList({"Achromatic pair", "Apochromatic triplet"}));
+
+    ui->lineEdit_MaxPowerSum->setValidator(new QDoubleValidator(1.0, 1000.0, 3, this));
+    ui->lineEdit_MaxPowerSum->setText("5");
+
+    ui->lineEdit_OutputCount->setValidator(new QIntValidator(1, 1000, this));
+    ui->lineEdit_OutputCount->setText("20");
+
+    ui->checkBox_ExcludeObsolete->setChecked(true);
+    ui->pushButton_Cancel->setEnabled(false);
+    ui->progressBar->setValue(0);
+
+    updateCatalogList();
+
+    m_watcher = new QFutureWatcher<QVector<GlassCombinationEngine::Combination>>(this);
+    QObject::connect(m_watcher, SIGNAL(resultReadyAt(int)),           this,              SLOT(onResultReady(int)));
+    QObject::connect(m_watcher, SIGNAL(finished()),                   this,              SLOT(onSearchFinished()));
+    QObject::connect(m_watcher, SIGNAL(progressRangeChanged(int,int)), ui->progressBar, SLOT(setRange(int,int)));
+    QObject::connect(m_watcher, SIGNAL(progressValueChanged(int)),    ui->progressBar,   SLOT(setValue(int)));
+
+    QObject::connect(ui->pushButton_Search, SIGNAL(clicked()), this, SLOT(startSearch()));
+    QObject::connect(ui->pushButton_Cancel, SIGNAL(clicked()), this, SLOT(cancelSearch()));
+
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(tableUpdated()), this, SLOT(updateCatalogList()));
+    }
+}
+
+GlassCombinationForm::~GlassCombinationForm()
+{
+    // The tasks refer to the engine.
+    m_watcher->cancel();
+    m_watcher->waitForFinished();
+
+    delete ui;
+}
+
+void GlassCombinationForm::updateCatalogList()
+{
+    QSharedPointer<const GlassTable> table = GlassCatalogManager::table();
+    if(!table){
+        return;
+    }
+
+    // keep unchecked suppliers unchecked
+    QStringList uncheckedSuppliers;
+    for(int i = 0; i < ui->listWidget_Catalogs->count(); i++){
+        QListWidgetItem* item = ui->listWidget_Catalogs->item(i);
+        if(Qt::Unchecked == item->checkState()){
+            uncheckedSuppliers.append(item->text());
+        }
+    }
+
+    ui->listWidget_Catalogs->clear();
+    for(int ci = 0; ci < table->catalogCount(); ci++){
+        QListWidgetItem* item = new QListWidgetItem(table->supplier(ci), ui->listWidget_Catalogs);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(uncheckedSuppliers.contains(table->supplier(ci)) ? Qt::Unchecked : Qt::Checked);
+    }
+}
+
+GlassCombinationEngine::Settings GlassCombinationForm::getSettings() const
+{
+    GlassCombinationEngine::Settings settings;
+    settings.mode            = (1 == ui->comboBox_Mode->currentIndex()) ? GlassCombinationEngine::Triplet : GlassCombinationEngine::Pair;
+    settings.maxPowerSum     = ui->lineEdit_MaxPowerSum->text().toDouble();
+    settings.excludeObsolete = ui->checkBox_ExcludeObsolete->isChecked();
+
+    // The list is in the catalog order of the table.
+    for(int i = 0; i < ui->listWidget_Catalogs->count(); i++){
+        settings.catalogs.append(Qt::Checked == ui->listWidget_Catalogs->item(i)->checkState());
+    }
+
+    return settings;
+}
+
+void GlassCombinationForm::startSearch()
+{
+    // The engine must not be modified while the tasks are running.
+    m_watcher->cancel();
+    m_watcher->waitForFinished();
+
+    m_engine.prepare(GlassCatalogManager::table(), getSettings());
+    m_resultCount = ui->lineEdit_OutputCount->text().toInt();
+    m_best.clear();
+    showResult();
+
+    QVector<int> tasks(m_engine.taskCount());
+    for(int i = 0; i < tasks.size(); i++){
+        tasks[i] = i;
+    }
+
+    ui->pushButton_Search->setEnabled(false);
+    ui->pushButton_Cancel->setEnabled(true);
+    ui->label_Status->setText(QString("Searching %1 glasses...").arg(m_engine.candidateCount()));
+
+    m_searchTimer.start();
+    m_lastRefresh = 0;
+    m_watcher->setFuture(QtConcurrent::mapped(tasks, TaskRunner{&m_engine, m_resultCount}));
+}
+
+void GlassCombinationForm::cancelSearch()
+{
+    m_watcher->cancel();
+}
+
+void GlassCombinationForm::onResultReady(int index)
+{
+    GlassCombinationEngine::merge(m_best, m_watcher->resultAt(index), m_resultCount);
+
+    if(m_searchTimer.elapsed() - m_lastRefresh > refreshIntervalMsec){
+        showResult();
+        m_lastRefresh = m_searchTimer.elapsed();
+    }
+}
+
+void GlassCombinationForm::onSearchFinished()
+{
+    showResult();
+
+    ui->pushButton_Search->setEnabled(true);
+    ui->pushButton_Cancel->setEnabled(false);
+
+    QString status = m_watcher->isCanceled() ? "Canceled" : "Finished";
+    ui->label_Status->setText(QString("%1 in %2 sec").arg(status).arg(m_searchTimer.elapsed()/1000.0, 0, 'f', 2));
+}
+
+void GlassCombinationForm::showResult()
+{
+    const GlassTable* table = m_engine.table().data();
+
+    QStringList hHeaderLabels({"Glass 1", "Glass 2", "Glass 3", "Power 1", "Power 2", "Power 3", "Power Sum",
+                               (GlassCombinationEngine::Triplet == m_engine.settings().mode) ? "Tertiary Spectrum" : "Secondary Spectrum"});
+    ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
+    ui->tableWidget_Result->setRowCount(m_best.size());
+
+    for(int i = 0; i < m_best.size(); i++){
+        const GlassCombinationEngine::Combination& c = m_best[i];
+        for(int j = 0; j < 3; j++){
+            bool used = (j < c.count && table);
+            setCellValue(ui->tableWidget_Result, i, j,     used ? table->fullName(c.rows[j]) : "-");
+            setCellValue(ui->tableWidget_Result, i, j + 3, used ? QString::number(c.powers[j], 'f', 4) : "-");
+        }
+        setCellValue(ui->tableWidget_Result, i, 6, QString::number(c.powerSum, 'f', 4));
+        setCellValue(ui->tableWidget_Result, i, 7, QString::number(c.residual, 'e', 3));
+    }
+}
+
+void GlassCombinationForm::setCellValue(QTableWidget* table, int row, int col, QString str)
+{
+    QTableWidgetItem *item = table->item(row, col);
+    if(!item){
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+    }
+    item->setTextAlignment(Qt::AlignRight);
+    item->setText(str);
+}
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_COMBINATION_FORM_H
+#define GLASS_COMBINATION_FORM_H
+
+#include <QWidget>
+#include <QMdiArea>
+#include <QTableWidget>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+
+#include "glass_combination_engine.h"
+
+namespace Ui {
+class GlassCombinationForm;
+}
+
+/** Form to search achromatic pairs and apochromatic triplets */
+class GlassCombinationForm : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit GlassCombinationForm(QMdiArea *parent = nullptr);
+    ~GlassCombinationForm();
+
+private slots:
+    void startSearch();
+    void cancelSearch();
+
+    /** Merge the result of a finished task and show the ranking so far */
+    void onResultReady(int index);
+    void onSearchFinished();
+
+    /** Update the catalog list keeping the check states */
+    void updateCatalogList();
+
+private:
+    /** Functor to run a task of the engine in the thread pool */
+    struct TaskRunner{
+        typedef QVector<GlassCombinationEngine::Combination> result_type;
+
+        const GlassCombinationEngine* engine;
+        int k;
+
+        result_type operator()(int task) const { return engine->runTask(task, k); }
+    };
+
+    GlassCombinationEngine::Settings getSettings() const;
+    void showResult();
+    void setCellValue(QTableWidget* table, int row, int col, QString str);
+
+    Ui::GlassCombinationForm *ui;
+    QMdiArea* m_parentMdiArea;
+
+    GlassCombinationEngine m_engine;
+    QFutureWatcher<QVector<GlassCombinationEngine::Combination>>* m_watcher;
+
+    QVector<GlassCombinationEngine::Combination> m_best;
+    int           m_resultCount;
+    QElapsedTimer m_searchTimer;
+    qint64        m_lastRefresh; // msec from the start of the search
+};
+
+#endif // GLASS_COMBINATION_FORM_H
@@ -28,6 +28,7 @@
 #include <QDebug>
 
 #include "spectral_line.h"
+#include "glass_catalog_manager.h"
 
 
 GlassDataSheetForm::GlassDataSheetForm(Glass* glass, QWidget *parent) :
@@ -53,6 +54,33 @@ GlassDataSheetForm::GlassDataSheetForm(Glass* glass, QWidget *parent) :
     setUpThermalTab();
     setUpTransmittanceTab();
     setUpOtherDataTab();
+
+    // The datasheet is closed if the glass is removed from the catalog file.
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(glassesRemoved(int,QStringList)), this, SLOT(onGlassesRemoved(int,QStringList)));
+        QObject::connect(manager, SIGNAL(glassesChanged(int,QStringList)), this, SLOT(onGlassesChanged(int,QStringList)));
+    }
+}
+
+void GlassDataSheetForm::onGlassesRemoved(int catalogIndex, const QStringList& glassNames)
+{
+    if(GlassCatalogManager::isListed(m_glass, catalogIndex, glassNames)){
+        m_glass = nullptr;
+        if(this->parentWidget()){
+            this->parentWidget()->close(); // mdi subwindow
+        }else{
+            this->close();
+        }
+    }
+}
+
+void GlassDataSheetForm::onGlassesChanged(int catalogIndex, const QStringList& glassNames)
+{
+    // The old glass is deleted with the old snapshot.
+    if(GlassCatalogManager::isListed(m_glass, catalogIndex, glassNames)){
+        m_glass = GlassCatalogManager::find(m_glass->fullName());
+    }
 }
 
 GlassDataSheetForm::~GlassDataSheetForm()
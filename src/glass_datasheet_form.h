@@ -47,6 +47,10 @@ public:
     explicit GlassDataSheetForm(Glass* glass, QWidget *parent = nullptr);
     ~GlassDataSheetForm();
 
+private slots:
+    void onGlassesRemoved(int catalogIndex, const QStringList& glassNames);
+    void onGlassesChanged(int catalogIndex, const QStringList& glassNames);
+
 private:
     void setUpBasicTab();
     void setUpIndicesTab();
@@ -0,0 +1,817 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_expression.h"
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <QtConcurrent>
+#include <QThread>
+#include <QHash>
+
+#include "glass.h"
+#include "spectral_line.h"
+
+namespace {
+
+/** Rows evaluated at once by each node, small enough to keep the temporaries in cache */
+constexpr int blockSize = 1024;
+
+/** Below this number of rows, the overhead of the threads is larger than the gain */
+constexpr int minRowsPerChunk = 4096;
+
+enum Operation{
+    OpNeg, OpNot, OpAbs, OpSqrt, OpExp, OpLog, OpLog10,                                  // unary
+    OpAdd, OpSub, OpMul, OpDiv, OpPow, OpMin, OpMax,                                     // binary arithmetic
+    OpLt, OpLe, OpGt, OpGe, OpEq, OpNe, OpAnd, OpOr                                      // binary logical
+};
+
+inline bool truth(double x)
+{
+    return (x != 0.0) && !std::isnan(x);
+}
+
+template<typename F>
+void transform1(double* a, int n, F f)
+{
+    for(int i = 0; i < n; i++){
+        a[i] = f(a[i]);
+    }
+}
+
+template<typename F>
+void transform2(double* a, const double* b, int n, F f)
+{
+    for(int i = 0; i < n; i++){
+        a[i] = f(a[i], b[i]);
+    }
+}
+
+/** a = op(a) or a = op(a, b) for n elements.  The switch is outside of the loops. */
+void applyOperation(int op, double* a, const double* b, int n)
+{
+    switch (op) {
+    case OpNeg:   transform1(a, n, [](double x){ return -x; });                     break;
+    case OpNot:   transform1(a, n, [](double x){ return truth(x) ? 0.0 : 1.0; });  break;
+    case OpAbs:   transform1(a, n, [](double x){ return std::fabs(x); });           break;
+    case OpSqrt:  transform1(a, n, [](double x){ return std::sqrt(x); });           break;
+    case OpExp:   transform1(a, n, [](double x){ return std::exp(x); });            break;
+    case OpLog:   transform1(a, n, [](double x){ return std::log(x); });            break;
+    case OpLog10: transform1(a, n, [](double x){ return std::log10(x); });          break;
+    case OpAdd:   transform2(a, b, n, [](double x, double y){ return x + y; });      break;
+    case OpSub:   transform2(a, b, n, [](double x, double y){ return x - y; });      break;
+    case OpMul:   transform2(a, b, n, [](double x, double y){ return x * y; });      break;
+    case OpDiv:   transform2(a, b, n, [](double x, double y){ return x / y; });      break;
+    case OpPow:   transform2(a, b, n, [](double x, double y){ return std::pow(x, y); }); break;
+    case OpMin:   transform2(a, b, n, [](double x, double y){ return std::fmin(x, y); }); break;
+    case OpMax:   transform2(a, b, n, [](double x, double y){ return std::fmax(x, y); }); break;
+    case OpLt:    transform2(a, b, n, [](double x, double y){ return (x <  y) ? 1.0 : 0.0; }); break;
+    case OpLe:    transform2(a, b, n, [](double x, double y){ return (x <= y) ? 1.0 : 0.0; }); break;
+    case OpGt:    transform2(a, b, n, [](double x, double y){ return (x >  y) ? 1.0 : 0.0; }); break;
+    case OpGe:    transform2(a, b, n, [](double x, double y){ return (x >= y) ? 1.0 : 0.0; }); break;
+    case OpEq:    transform2(a, b, n, [](double x, double y){ return (x == y) ? 1.0 : 0.0; }); break;
+    case OpNe:    transform2(a, b, n, [](double x, double y){ return (x != y && !std::isnan(x) && !std::isnan(y)) ? 1.0 : 0.0; }); break;
+    case OpAnd:   transform2(a, b, n, [](double x, double y){ return (truth(x) && truth(y)) ? 1.0 : 0.0; }); break;
+    case OpOr:    transform2(a, b, n, [](double x, double y){ return (truth(x) || truth(y)) ? 1.0 : 0.0; }); break;
+    }
+}
+
+/** Identifier without spaces and '/', e.g. "Low TCE" -> "LowTCE" */
+QString identifierName(const QString& columnName)
+{
+    QString name = columnName;
+    name.remove(' ');
+    name.remove('/');
+    return name;
+}
+
+/** lower case identifier -> GlassTable::Column */
+const QHash<QString, int>& columnIdentifiers()
+{
+    static const QHash<QString, int> map = [](){
+        QHash<QString, int> m;
+        for(int c = 0; c < GlassTable::ColumnCount; c++){
+            m.insert(identifierName(GlassTable::columnNames()[c]).toLower(), c);
+        }
+        return m;
+    }();
+    return map;
+}
+
+struct FunctionInfo{
+    const char* name;
+    int         argCount;
+    int         op; // -1 for n() and T()
+};
+
+const FunctionInfo functions[] = {
+    {"n",     1, -1},
+    {"T",     2, -1},
+    {"abs",   1, OpAbs},
+    {"sqrt",  1, OpSqrt},
+    {"exp",   1, OpExp},
+    {"log",   1, OpLog},
+    {"log10", 1, OpLog10},
+    {"pow",   2, OpPow},
+    {"min",   2, OpMin},
+    {"max",   2, OpMax}
+};
+
+}
+
+
+struct GlassExpression::Node
+{
+    enum Kind{
+        Constant,
+        Column,          // index: GlassTable::Column
+        LineIndex,       // index: GlassTable::spectralLineIndex()
+        StatusEquals,    // index: GlassTable::Status, op: OpEq/OpNe
+        SupplierEquals,  // str: supplier, op: OpEq/OpNe
+        RefractiveIndex, // args: wavelength
+        Transmittance,   // args: wavelength, thickness
+        Operation        // op, args
+    };
+
+    Kind    kind;
+    int     op;
+    int     index;
+    double  value;
+    QString str;
+    std::vector< std::shared_ptr<const Node> > args;
+
+    Node(Kind k) : kind(k), op(-1), index(-1), value(0.0) {}
+};
+
+
+/**
+ * Recursive descent parser.
+ * A function returns nullptr after setting the error message.
+ */
+class GlassExpression::Parser
+{
+public:
+    typedef std::shared_ptr<const Node> NodePtr;
+
+    explicit Parser(const QString& text) : m_text(text), m_pos(0) {}
+
+    NodePtr parse()
+    {
+        if(!tokenize()){
+            return nullptr;
+        }
+        NodePtr node = parseOr();
+        if(node && m_tokens[m_pos].type != TokenEnd){
+            return error("Unexpected '" + m_tokens[m_pos].text + "'");
+        }
+        return node;
+    }
+
+    const QString& errorMessage() const { return m_errorMessage; }
+
+    bool normalize(QString& normalizedText)
+    {
+        if(!tokenize()){
+            return false;
+        }
+        QStringList parts;
+        for(int n = 0; n + 1 < m_tokens.size(); n++){
+            const Token& t = m_tokens[n];
+            if(TokenNumber == t.type || TokenString == t.type){
+                // the source up to the next token, which keeps the unit and the quoted spaces
+                parts.append(m_text.mid(t.position, m_tokens[n+1].position - t.position).trimmed());
+            }else{
+                parts.append(t.text);
+            }
+        }
+        normalizedText = parts.join(' ');
+        return true;
+    }
+
+private:
+    enum TokenType{ TokenNumber, TokenIdentifier, TokenString, TokenOperator, TokenEnd };
+
+    struct Token{
+        TokenType type;
+        QString   text;
+        double    value;
+        int       position;
+    };
+
+    bool tokenize()
+    {
+        const int len = m_text.size();
+        int i = 0;
+        while(i < len){
+            QChar c = m_text[i];
+            if(c.isSpace()){
+                i++;
+                continue;
+            }
+
+            Token t{TokenOperator, QString(), 0.0, i};
+
+            if(c.isDigit() || (c == '.' && i + 1 < len && m_text[i+1].isDigit())){
+                int j = i;
+                while(j < len && (m_text[j].isDigit() || m_text[j] == '.')) j++;
+                // exponent
+                if(j < len && (m_text[j] == 'e' || m_text[j] == 'E')){
+                    int k = j + 1;
+                    if(k < len && (m_text[k] == '+' || m_text[k] == '-')) k++;
+                    if(k < len && m_text[k].isDigit()){
+                        j = k;
+                        while(j < len && m_text[j].isDigit()) j++;
+                    }
+                }
+                bool ok;
+                t.type  = TokenNumber;
+                t.text  = m_text.mid(i, j - i);
+                t.value = t.text.toDouble(&ok);
+                if(!ok){
+                    m_errorMessage = QString("Invalid number '%1' at %2").arg(t.text).arg(i);
+                    return false;
+                }
+                // unit
+                int k = j;
+                while(k < len && m_text[k].isLetter()) k++;
+                QString unit = m_text.mid(j, k - j);
+                if("um" == unit || "mm" == unit){
+                    j = k;
+                }
+                else if("nm" == unit){
+                    t.value /= 1000.0;
+                    j = k;
+                }
+                else if(!unit.isEmpty()){
+                    m_errorMessage = QString("Unknown unit '%1' at %2").arg(unit).arg(j);
+                    return false;
+                }
+                i = j;
+            }
+            else if(c.isLetter() || c == '_'){
+                int j = i;
+                while(j < len && (m_text[j].isLetterOrNumber() || m_text[j] == '_')) j++;
+                t.type = TokenIdentifier;
+                t.text = m_text.mid(i, j - i);
+                // keywords
+                if("and" == t.text){
+                    t.type = TokenOperator;
+                    t.text = "&&";
+                }
+                else if("or" == t.text){
+                    t.type = TokenOperator;
+                    t.text = "||";
+                }
+                else if("not" == t.text){
+                    t.type = TokenOperator;
+                    t.text = "!";
+                }
+                i = j;
+            }
+            else if(c == '"' || c == '\''){
+                int j = m_text.indexOf(c, i + 1);
+                if(j < 0){
+                    m_errorMessage = QString("Unterminated string at %1").arg(i);
+                    return false;
+                }
+                t.type = TokenString;
+                t.text = m_text.mid(i + 1, j - i - 1);
+                i = j + 1;
+            }
+            else{
+                static const QStringList operators({"&&", "||", "==", "!=", "<=", ">=", "<", ">", "+", "-", "*", "/", "^", "!", "(", ")", ","});
+                for(auto &op : operators){
+                    if(m_text.midRef(i, op.size()) == op){
+                        t.text = op;
+                        break;
+                    }
+                }
+                if(t.text.isEmpty()){
+                    m_errorMessage = QString("Unexpected '%1' at %2").arg(c).arg(i);
+                    return false;
+                }
+                i += t.text.size();
+            }
+
+            m_tokens.append(t);
+        }
+
+        m_tokens.append(Token{TokenEnd, "end of expression", 0.0, len});
+        return true;
+    }
+
+    NodePtr error(const QString& message)
+    {
+        if(m_errorMessage.isEmpty()){
+            m_errorMessage = QString("%1 at %2").arg(message).arg(m_tokens[m_pos].position);
+        }
+        return nullptr;
+    }
+
+    bool acceptOperator(const QString& op)
+    {
+        if(m_tokens[m_pos].type == TokenOperator && m_tokens[m_pos].text == op){
+            m_pos++;
+            return true;
+        }
+        return false;
+    }
+
+    NodePtr makeConstant(double value)
+    {
+        auto node = std::make_shared<Node>(Node::Constant);
+        node->value = value;
+        return node;
+    }
+
+    /** Operation node, or a constant if all the arguments are constant */
+    NodePtr makeOperation(int op, NodePtr a, NodePtr b = nullptr)
+    {
+        if(Node::Constant == a->kind && (!b || Node::Constant == b->kind)){
+            double x = a->value;
+            double y = b ? b->value : 0.0;
+            applyOperation(op, &x, &y, 1);
+            return makeConstant(x);
+        }
+
+        auto node = std::make_shared<Node>(Node::Operation);
+        node->op = op;
+        node->args.push_back(a);
+        if(b){
+            node->args.push_back(b);
+        }
+        return node;
+    }
+
+    NodePtr parseOr()
+    {
+        NodePtr lhs = parseAnd();
+        while(lhs && acceptOperator("||")){
+            NodePtr rhs = parseAnd();
+            if(!rhs) return nullptr;
+            lhs = makeOperation(OpOr, lhs, rhs);
+        }
+        return lhs;
+    }
+
+    NodePtr parseAnd()
+    {
+        NodePtr lhs = parseComparison();
+        while(lhs && acceptOperator("&&")){
+            NodePtr rhs = parseComparison();
+            if(!rhs) return nullptr;
+            lhs = makeOperation(OpAnd, lhs, rhs);
+        }
+        return lhs;
+    }
+
+    NodePtr parseComparison()
+    {
+        NodePtr lhs = parseAdditive();
+        if(!lhs){
+            return nullptr;
+        }
+
+        static const QStringList comparisons({"<", "<=", ">", ">=", "==", "!="});
+        static const int         comparisonOps[] = {OpLt, OpLe, OpGt, OpGe, OpEq, OpNe};
+
+        for(int i = 0; i < comparisons.size(); i++){
+            if(acceptOperator(comparisons[i])){
+                NodePtr rhs = parseAdditive();
+                if(!rhs) return nullptr;
+                return makeOperation(comparisonOps[i], lhs, rhs);
+            }
+        }
+        return lhs;
+    }
+
+    NodePtr parseStringComparison()
+    {
+        bool isStatus = (0 == m_tokens[m_pos].text.compare("status", Qt::CaseInsensitive));
+        m_pos++;
+
+        int op;
+        if(acceptOperator("==")){
+            op = OpEq;
+        }
+        else if(acceptOperator("!=")){
+            op = OpNe;
+        }
+        else{
+            return error("Expected == or !=");
+        }
+
+        const Token& t = m_tokens[m_pos];
+        if(t.type != TokenString){
+            return error("Expected a string");
+        }
+        m_pos++;
+
+        auto node = std::make_shared<Node>(isStatus ? Node::StatusEquals : Node::SupplierEquals);
+        node->op  = op;
+        if(isStatus){
+            node->index = GlassTable::statusFromString(t.text);
+        }
+        else{
+            node->str = t.text;
+        }
+        return node;
+    }
+
+    NodePtr parseAdditive()
+    {
+        NodePtr lhs = parseMultiplicative();
+        while(lhs){
+            int op;
+            if(acceptOperator("+")){
+                op = OpAdd;
+            }
+            else if(acceptOperator("-")){
+                op = OpSub;
+            }
+            else{
+                break;
+            }
+            NodePtr rhs = parseMultiplicative();
+            if(!rhs) return nullptr;
+            lhs = makeOperation(op, lhs, rhs);
+        }
+        return lhs;
+    }
+
+    NodePtr parseMultiplicative()
+    {
+        NodePtr lhs = parseUnary();
+        while(lhs){
+            int op;
+            if(acceptOperator("*")){
+                op = OpMul;
+            }
+            else if(acceptOperator("/")){
+                op = OpDiv;
+            }
+            else{
+                break;
+            }
+            NodePtr rhs = parseUnary();
+            if(!rhs) return nullptr;
+            lhs = makeOperation(op, lhs, rhs);
+        }
+        return lhs;
+    }
+
+    NodePtr parseUnary()
+    {
+        if(acceptOperator("-")){
+            NodePtr arg = parseUnary();
+            return arg ? makeOperation(OpNeg, arg) : nullptr;
+        }
+        if(acceptOperator("!")){
+            NodePtr arg = parseUnary();
+            return arg ? makeOperation(OpNot, arg) : nullptr;
+        }
+        return parsePower();
+    }
+
+    NodePtr parsePower()
+    {
+        NodePtr base = parsePrimary();
+        if(base && acceptOperator("^")){
+            // right associative, and -x^2 = -(x^2)
+            NodePtr exponent = parseUnary();
+            if(!exponent) return nullptr;
+            return makeOperation(OpPow, base, exponent);
+        }
+        return base;
+    }
+
+    NodePtr parsePrimary()
+    {
+        const Token t = m_tokens[m_pos];
+
+        if(t.type == TokenNumber){
+            m_pos++;
+            return makeConstant(t.value);
+        }
+
+        if(acceptOperator("(")){
+            NodePtr node = parseOr();
+            if(!node) return nullptr;
+            if(!acceptOperator(")")){
+                return error("Expected ')'");
+            }
+            return node;
+        }
+
+        // status == "Preferred", supplier != "SCHOTT"
+        if(t.type == TokenIdentifier && (0 == t.text.compare("status", Qt::CaseInsensitive) || 0 == t.text.compare("supplier", Qt::CaseInsensitive))){
+            return parseStringComparison();
+        }
+
+        if(t.type == TokenIdentifier){
+            m_pos++;
+            if(m_tokens[m_pos].type == TokenOperator && m_tokens[m_pos].text == "("){
+                return parseFunction(t.text);
+            }
+            return parseIdentifier(t);
+        }
+
+        return error("Unexpected '" + t.text + "'");
+    }
+
+    NodePtr parseIdentifier(const Token& t)
+    {
+        // refractive index at the spectral line, e.g. nF, nC_
+        if(t.text.startsWith('n')){
+            int lineIndex = GlassTable::spectralLineIndex(t.text.mid(1));
+            if(lineIndex >= 0){
+                auto node = std::make_shared<Node>(Node::LineIndex);
+                node->index = lineIndex;
+                return node;
+            }
+        }
+
+        int column = columnIdentifiers().value(t.text.toLower(), -1);
+        if(column >= 0){
+            auto node = std::make_shared<Node>(Node::Column);
+            node->index = column;
+            return node;
+        }
+
+        m_pos--;
+        return error("Unknown identifier '" + t.text + "'");
+    }
+
+    NodePtr parseFunction(const QString& name)
+    {
+        const FunctionInfo* func = nullptr;
+        for(auto &f : functions){
+            if(name == f.name){
+                func = &f;
+                break;
+            }
+        }
+        if(!func){
+            m_pos--;
+            return error("Unknown function '" + name + "'");
+        }
+
+        acceptOperator("(");
+        std::vector<NodePtr> args;
+        for(int i = 0; i < func->argCount; i++){
+            if(i > 0 && !acceptOperator(",")){
+                return error(QString("%1() takes %2 arguments").arg(name).arg(func->argCount));
+            }
+            NodePtr arg = parseOr();
+            if(!arg) return nullptr;
+            args.push_back(arg);
+        }
+        if(!acceptOperator(")")){
+            return error("Expected ')'");
+        }
+
+        if(func->op >= 0){
+            return makeOperation(func->op, args[0], (args.size() > 1) ? args[1] : nullptr);
+        }
+
+        if("n" == name){
+            // The indices at the spectral lines are stored in the table.
+            if(Node::Constant == args[0]->kind){
+                for(int i = 0; i < GlassTable::spectralLineNames().size(); i++){
+                    double lambda = SpectralLine::wavelength(GlassTable::spectralLineNames()[i])/1000.0;
+                    if(std::fabs(lambda - args[0]->value) < 1e-9){
+                        auto node = std::make_shared<Node>(Node::LineIndex);
+                        node->index = i;
+                        return node;
+                    }
+                }
+            }
+            auto node = std::make_shared<Node>(Node::RefractiveIndex);
+            node->args = args;
+            return node;
+        }
+
+        auto node = std::make_shared<Node>(Node::Transmittance);
+        node->args = args;
+        return node;
+    }
+
+    QString        m_text;
+    QVector<Token> m_tokens;
+    int            m_pos;
+    QString        m_errorMessage;
+};
+
+
+GlassExpression::GlassExpression()
+{
+
+}
+
+GlassExpression::~GlassExpression()
+{
+
+}
+
+bool GlassExpression::compile(const QString &text)
+{
+    m_text = text;
+    m_errorMessage.clear();
+
+    Parser parser(text);
+    m_root = parser.parse();
+
+    if(!m_root){
+        m_errorMessage = parser.errorMessage();
+        return false;
+    }
+    return true;
+}
+
+void GlassExpression::evaluateNode(const Node &node, const GlassTable &table, int rowBegin, int rowEnd, double *out)
+{
+    const int n = rowEnd - rowBegin;
+
+    switch (node.kind) {
+    case Node::Constant:
+        std::fill(out, out + n, node.value);
+        break;
+
+    case Node::Column:
+    {
+        const double* data = table.column(node.index).constData() + rowBegin;
+        std::copy(data, data + n, out);
+        break;
+    }
+
+    case Node::LineIndex:
+    {
+        const double* data = table.refractiveIndices(node.index).constData() + rowBegin;
+        std::copy(data, data + n, out);
+        break;
+    }
+
+    case Node::StatusEquals:
+    {
+        const quint8* status = table.statusColumn().constData() + rowBegin;
+        const bool equal = (OpEq == node.op);
+        for(int i = 0; i < n; i++){
+            out[i] = ((status[i] == node.index) == equal) ? 1.0 : 0.0;
+        }
+        break;
+    }
+
+    case Node::SupplierEquals:
+    {
+        int catalogIndex = -1;
+        for(int ci = 0; ci < table.catalogCount(); ci++){
+            if(0 == table.supplier(ci).compare(node.str, Qt::CaseInsensitive)){
+                catalogIndex = ci;
+                break;
+            }
+        }
+        const int* catalogs = table.catalogColumn().constData() + rowBegin;
+        const bool equal = (OpEq == node.op);
+        for(int i = 0; i < n; i++){
+            out[i] = ((catalogs[i] == catalogIndex) == equal) ? 1.0 : 0.0;
+        }
+        break;
+    }
+
+    case Node::RefractiveIndex:
+    {
+        // n() is computed at the temperature of the table, not at the current one.
+        evaluateNode(*node.args[0], table, rowBegin, rowEnd, out);
+        const double temperature = table.temperature();
+        for(int i = 0; i < n; i++){
+            int row = rowBegin + i;
+            out[i] = table.isValid(row) ? table.glass(row)->refractiveIndex(out[i], temperature) : NAN;
+        }
+        break;
+    }
+
+    case Node::Transmittance:
+    {
+        std::vector<double> thickness(n);
+        evaluateNode(*node.args[0], table, rowBegin, rowEnd, out);
+        evaluateNode(*node.args[1], table, rowBegin, rowEnd, thickness.data());
+        for(int i = 0; i < n; i++){
+            const Glass* g = table.glass(rowBegin + i);
+            out[i] = g->hasTransmittanceAt(out[i]) ? g->transmittance(out[i], thickness[i]) : NAN;
+        }
+        break;
+    }
+
+    case Node::Operation:
+    {
+        evaluateNode(*node.args[0], table, rowBegin, rowEnd, out);
+        if(node.args.size() > 1){
+            std::vector<double> rhs(n);
+            evaluateNode(*node.args[1], table, rowBegin, rowEnd, rhs.data());
+            applyOperation(node.op, out, rhs.data(), n);
+        }
+        else{
+            applyOperation(node.op, out, nullptr, n);
+        }
+        break;
+    }
+    }
+}
+
+QVector<double> GlassExpression::evaluate(const GlassTable &table) const
+{
+    const int rowCount = table.rowCount();
+    QVector<double> values(rowCount, NAN);
+
+    if(!m_root || 0 == rowCount){
+        return values;
+    }
+
+    const int chunkCount = qBound(1, rowCount/minRowsPerChunk, QThread::idealThreadCount());
+    double* out = values.data();
+    const Node& root = *m_root;
+
+    auto evaluateChunk = [&](int chunk){
+        int rowBegin = static_cast<int>(static_cast<qint64>(rowCount)*chunk/chunkCount);
+        int rowEnd   = static_cast<int>(static_cast<qint64>(rowCount)*(chunk + 1)/chunkCount);
+        for(int row = rowBegin; row < rowEnd; row += blockSize){
+            evaluateNode(root, table, row, qMin(row + blockSize, rowEnd), out + row);
+        }
+    };
+
+    if(chunkCount == 1){
+        evaluateChunk(0);
+    }
+    else{
+        QVector<int> chunks(chunkCount);
+        for(int i = 0; i < chunkCount; i++){
+            chunks[i] = i;
+        }
+        QtConcurrent::blockingMap(chunks, [&](int& chunk){ evaluateChunk(chunk); });
+    }
+
+    return values;
+}
+
+QVector<bool> GlassExpression::filter(const GlassTable &table) const
+{
+    return filter(evaluate(table));
+}
+
+QVector<bool> GlassExpression::filter(const QVector<double> &values)
+{
+    QVector<bool> mask(values.size());
+    for(int i = 0; i < values.size(); i++){
+        mask[i] = truth(values[i]);
+    }
+    return mask;
+}
+
+QString GlassExpression::normalized(const QString &text)
+{
+    Parser parser(text);
+    QString normalizedText;
+    if(parser.normalize(normalizedText)){
+        return normalizedText;
+    }
+    return text;
+}
+
+QStringList GlassExpression::identifiers()
+{
+    QStringList names;
+    for(auto &c : GlassTable::columnNames()){
+        names.append(identifierName(c));
+    }
+    for(auto &line : GlassTable::spectralLineNames()){
+        names.append("n" + line);
+    }
+    names << "status" << "supplier";
+    for(auto &f : functions){
+        names.append(QString(f.name) + "()");
+    }
+    return names;
+}
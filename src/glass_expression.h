@@ -0,0 +1,115 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_EXPRESSION_H
+#define GLASS_EXPRESSION_H
+
+#include <memory>
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "glass_table.h"
+
+/**
+ * @brief Expression over the glass properties, used for computed columns and filters
+ * @details An expression such as <tt>nd > 1.75 && vd < 30 && status == "Preferred" && T(0.4um, 10mm) > 0.95</tt>
+ *          or <tt>(n(0.4) - n(0.7))/(nd - 1)</tt> is compiled into an expression tree once, and evaluated over the whole table column by column.
+ *          Each node computes a block of rows in a tight loop, and the blocks are evaluated in parallel.
+ *
+ *          - Numbers may have a unit: um (default for wavelengths), nm, mm (thickness).
+ *          - Identifiers are the column names of GlassTable with spaces and '/' removed (case insensitive, e.g. dndT, LowTCE),
+ *            and n + spectral line name for the stored refractive indices (e.g. nF, nC_, ng).
+ *          - status and supplier can be compared with a string by == and !=.
+ *          - Functions: n(lambda), T(lambda, thickness), abs, sqrt, exp, log, log10, pow, min, max.
+ *          - Operators: ^, unary - and !, * /, + -, comparisons, &&, || (and, or, not).
+ *
+ *          Missing data are NaN and propagate through the arithmetic. A comparison with NaN is false.
+ */
+class GlassExpression
+{
+public:
+    GlassExpression();
+    ~GlassExpression();
+
+    /**
+     * @brief Compile the expression
+     * @return false if the text has a syntax error, whose message is returned by errorMessage()
+     */
+    bool compile(const QString& text);
+
+    inline bool           isValid() const;
+    inline const QString& text() const;
+    inline const QString& errorMessage() const;
+
+    /**
+     * @brief Evaluate the expression for all the rows of the table.  The snapshot of the table must be held during the call.
+     * @return value of each row.  A logical expression gives 1 (true) or 0 (false).
+     */
+    QVector<double> evaluate(const GlassTable& table) const;
+
+    /** Returns true for the rows in which the expression is true (nonzero and not NaN) */
+    QVector<bool> filter(const GlassTable& table) const;
+
+    /** Returns true for the values which are true in the expressions, e.g. the values of a filter expression cached by the manager */
+    static QVector<bool> filter(const QVector<double>& values);
+
+    /** Names which can be used in the expressions, for the help of the input fields */
+    static QStringList identifiers();
+
+    /**
+     * @brief Text of the tokens joined by single spaces, e.g. "nd>1" and "nd  >  1" give "nd > 1"
+     * @details String literals and numbers are kept as written. The text itself is returned if it cannot be tokenized.
+     */
+    static QString normalized(const QString& text);
+
+private:
+    struct Node;
+    class Parser;
+
+    static void evaluateNode(const Node& node, const GlassTable& table, int rowBegin, int rowEnd, double* out);
+
+    std::shared_ptr<const Node> m_root;
+    QString                     m_text;
+    QString                     m_errorMessage;
+};
+
+
+bool GlassExpression::isValid() const
+{
+    return (nullptr != m_root);
+}
+
+const QString& GlassExpression::text() const
+{
+    return m_text;
+}
+
+const QString& GlassExpression::errorMessage() const
+{
+    return m_errorMessage;
+}
+
+#endif // GLASS_EXPRESSION_H
@@ -0,0 +1,315 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_melt_fit_form.h"
+#include "ui_glass_melt_fit_form.h"
+
+#include <cmath>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QRegularExpression>
+#include <QIntValidator>
+#include <QElapsedTimer>
+
+#include "glass_catalog_manager.h"
+#include "glass_selection_dialog.h"
+#include "spectral_line.h"
+
+namespace {
+
+const QString meltSupplier = "MELT";
+
+}
+
+GlassMeltFitForm::GlassMeltFitForm(QMdiArea *parent) :
+    QWidget(parent),
+    ui(new Ui::GlassMeltFitForm),
+    m_parentMdiArea(parent),
+    m_fittedFormula(0)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Melt Fitting");
+
+    for(int f : DispersionFitter::formulaIndices()){
+        ui->comboBox_Formula->addItem(DispersionFitter::formulaName(f), f);
+    }
+    ui->comboBox_Formula->setCurrentIndex(ui->comboBox_Formula->findData(2)); // Sellmeier1
+
+    ui->lineEdit_MaxIterations->setValidator(new QIntValidator(1, 10000, this));
+    ui->lineEdit_MaxIterations->setText("200");
+
+    ui->label_ReferenceGlass->setText("-");
+    ui->pushButton_AddToCatalog->setEnabled(false);
+
+    QObject::connect(ui->pushButton_Import,         SIGNAL(clicked()), this, SLOT(importCSV()));
+    QObject::connect(ui->pushButton_SelectGlass,    SIGNAL(clicked()), this, SLOT(selectReferenceGlass()));
+    QObject::connect(ui->pushButton_ClearGlass,     SIGNAL(clicked()), this, SLOT(clearReferenceGlass()));
+    QObject::connect(ui->pushButton_Fit,            SIGNAL(clicked()), this, SLOT(fitAll()));
+    QObject::connect(ui->pushButton_AddToCatalog,   SIGNAL(clicked()), this, SLOT(addToCatalog()));
+}
+
+GlassMeltFitForm::~GlassMeltFitForm()
+{
+    delete ui;
+}
+
+void GlassMeltFitForm::importCSV()
+{
+    QString filePath = QFileDialog::getOpenFileName(this, tr("Open"), "", tr("CSV file(*.csv);;All Files(*.*)"));
+    if(filePath.isEmpty()){
+        return;
+    }
+
+    QString message;
+    if(!loadCSV(filePath, message)){
+        QMessageBox::warning(this, tr("Error"), message);
+        return;
+    }
+
+    clearResult();
+    ui->label_File->setText(QString("%1 (%2 lots)").arg(QFileInfo(filePath).fileName()).arg(m_lots.size()));
+}
+
+bool GlassMeltFitForm::loadCSV(const QString &filePath, QString &message)
+{
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text)){
+        message = "Failed to open " + filePath;
+        return false;
+    }
+
+    QTextStream in(&file);
+    const QRegularExpression separator("[,;\\t]");
+
+    // header: label, wavelengths
+    QStringList header = in.readLine().split(separator);
+    QVector<double> wavelengths; // micron
+    for(int i = 1; i < header.size(); i++){
+        QString token = header[i].trimmed();
+        bool ok;
+        double nm = token.toDouble(&ok);
+        if(!ok){
+            nm = SpectralLine::wavelength(token);
+        }
+        if(std::isnan(nm) || nm <= 0.0){
+            message = QString("Invalid wavelength in the header: %1").arg(token);
+            return false;
+        }
+        wavelengths.append(nm/1000.0);
+    }
+
+    QStringList lotNames;
+    QVector< QVector<DispersionFitter::Sample> > lots;
+
+    // one lot in each row.  Empty cells are skipped.
+    while(!in.atEnd()){
+        QStringList cells = in.readLine().split(separator);
+        if(cells.isEmpty() || cells[0].trimmed().isEmpty()){
+            continue;
+        }
+
+        QVector<DispersionFitter::Sample> samples;
+        for(int i = 1; i < cells.size() && i <= wavelengths.size(); i++){
+            bool ok;
+            double index = cells[i].trimmed().toDouble(&ok);
+            if(ok){
+                samples.append({wavelengths[i-1], index});
+            }
+        }
+
+        lotNames.append(cells[0].trimmed());
+        lots.append(samples);
+    }
+
+    if(lots.isEmpty()){
+        message = "No melt data found";
+        return false;
+    }
+
+    m_lotNames = lotNames;
+    m_lots     = lots;
+
+    return true;
+}
+
+void GlassMeltFitForm::selectReferenceGlass()
+{
+    GlassSelectionDialog *dlg = new GlassSelectionDialog(this);
+    if(dlg->exec() == QDialog::Accepted)
+    {
+        Glass* glass = dlg->getSelectedGlass();
+        if(glass){
+            m_referenceGlass.reset(new Glass(*glass));
+            ui->label_ReferenceGlass->setText(glass->fullName());
+
+            // start from the formula of the reference glass if it can be fitted
+            int comboIndex = ui->comboBox_Formula->findData(glass->formulaIndex());
+            if(comboIndex >= 0){
+                ui->comboBox_Formula->setCurrentIndex(comboIndex);
+            }
+        }
+    }
+
+    delete dlg;
+}
+
+void GlassMeltFitForm::clearReferenceGlass()
+{
+    m_referenceGlass.reset();
+    ui->label_ReferenceGlass->setText("-");
+}
+
+void GlassMeltFitForm::fitAll()
+{
+    if(m_lots.isEmpty()){
+        QMessageBox::information(this, tr("Error"), "Import melt data first");
+        return;
+    }
+
+    const int formulaIndex  = ui->comboBox_Formula->currentData().toInt();
+    const int coefCount     = DispersionFitter::coefficientCount(formulaIndex);
+    const int maxIterations = ui->lineEdit_MaxIterations->text().toInt();
+
+    // The catalog coefficients of the reference glass are usually close to those of the melts.
+    QVector<double> initialCoefs;
+    if(m_referenceGlass && m_referenceGlass->formulaIndex() == formulaIndex){
+        for(int i = 0; i < coefCount; i++){
+            initialCoefs.append(m_referenceGlass->dispersionCoef(i));
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_results       = DispersionFitter::fitBatch(formulaIndex, m_lots, initialCoefs, maxIterations);
+    m_fittedFormula = formulaIndex;
+
+    const double ld = SpectralLine::d/1000.0;
+    const double lF = SpectralLine::F/1000.0;
+    const double lC = SpectralLine::C/1000.0;
+
+    QStringList hHeaderLabels({"Lot", "Samples", "Status", "Iterations", "RMS", "Max Residual", "nd", "vd"});
+    ui->tableWidget_Result->clear();
+    ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
+    ui->tableWidget_Result->setRowCount(m_results.size());
+
+    int fittedCount = 0;
+    for(int i = 0; i < m_results.size(); i++){
+        const DispersionFitter::Result& r = m_results[i];
+        setCellValue(ui->tableWidget_Result, i, 0, m_lotNames[i]);
+        setCellValue(ui->tableWidget_Result, i, 1, QString::number(m_lots[i].size()));
+        setCellValue(ui->tableWidget_Result, i, 2, r.message);
+
+        if(r.coefs.isEmpty()){
+            for(int j = 3; j < hHeaderLabels.size(); j++){
+                setCellValue(ui->tableWidget_Result, i, j, "-");
+            }
+            continue;
+        }
+
+        double nd = DispersionFitter::evaluate(formulaIndex, ld, r.coefs.constData());
+        double nF = DispersionFitter::evaluate(formulaIndex, lF, r.coefs.constData());
+        double nC = DispersionFitter::evaluate(formulaIndex, lC, r.coefs.constData());
+
+        setCellValue(ui->tableWidget_Result, i, 3, QString::number(r.iterations));
+        setCellValue(ui->tableWidget_Result, i, 4, QString::number(r.rms, 'e', 2));
+        setCellValue(ui->tableWidget_Result, i, 5, QString::number(r.maxAbsResidual, 'e', 2));
+        setCellValue(ui->tableWidget_Result, i, 6, QString::number(nd, 'f', 6));
+        setCellValue(ui->tableWidget_Result, i, 7, QString::number((nd - 1.0)/(nF - nC), 'f', 3));
+
+        fittedCount++;
+    }
+
+    ui->pushButton_AddToCatalog->setEnabled(fittedCount > 0);
+    ui->label_Status->setText(QString("%1 / %2 lots fitted, %3 msec").arg(fittedCount).arg(m_results.size()).arg(timer.elapsed()));
+}
+
+void GlassMeltFitForm::addToCatalog()
+{
+    GlassCatalog* catalog = new GlassCatalog;
+    catalog->setSupplier(meltSupplier);
+
+    QStringList skipped;
+    for(int i = 0; i < m_results.size(); i++){
+        const DispersionFitter::Result& r = m_results[i];
+        if(r.coefs.isEmpty()){
+            continue;
+        }
+
+        // The other data (thermal, transmittance etc.) are inherited from the reference glass.
+        Glass glass;
+        if(m_referenceGlass){
+            glass = *m_referenceGlass;
+            glass.setComment("Melt of " + m_referenceGlass->fullName());
+        }
+        glass.setName(m_lotNames[i]);
+        if(13 == m_fittedFormula){
+            // Glass reads formula 13 as Nikon Hikari only for the glasses of Hikari.  The supplier is replaced by the catalog.
+            glass.setSupplier("HIKARI");
+        }
+        glass.setDispForm(m_fittedFormula);
+        for(int j = 0; j < glass.dispersionCoefCount(); j++){
+            glass.setDispCoef(j, (j < r.coefs.size()) ? r.coefs[j] : 0.0);
+        }
+
+        if(!catalog->addGlass(glass)){
+            skipped.append(m_lotNames[i]);
+        }
+    }
+
+    int glassCount = catalog->glassCount();
+    GlassCatalogManager::addMemoryCatalog(catalog);
+
+    QString message = QString("%1 glasses were added to the catalog %2").arg(glassCount).arg(meltSupplier);
+    if(!skipped.isEmpty()){
+        message += "\nDuplicated lots were skipped: " + skipped.join(", ");
+    }
+    QMessageBox::information(this, "Success", message);
+}
+
+void GlassMeltFitForm::clearResult()
+{
+    m_results.clear();
+    ui->tableWidget_Result->clear();
+    ui->tableWidget_Result->setRowCount(0);
+    ui->tableWidget_Result->setColumnCount(0);
+    ui->pushButton_AddToCatalog->setEnabled(false);
+    ui->label_Status->clear();
+}
+
+void GlassMeltFitForm::setCellValue(QTableWidget* table, int row, int col, QString str)
+{
+    QTableWidgetItem *item = table->item(row, col);
+    if(!item){
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+    }
+    item->setTextAlignment(Qt::AlignRight);
+    item->setText(str);
+}
@@ -0,0 +1,84 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_MELT_FIT_FORM_H
+#define GLASS_MELT_FIT_FORM_H
+
+#include <memory>
+
+#include <QWidget>
+#include <QMdiArea>
+#include <QTableWidget>
+
+#include "glass.h"
+#include "dispersion_fitter.h"
+
+namespace Ui {
+class GlassMeltFitForm;
+}
+
+/**
+ * @brief Form to fit dispersion formulas to measured melt data
+ * @details The measured indices are imported from a CSV file whose first row lists the wavelengths (nm) or spectral line names
+ *          and each following row holds the lot name and the indices of one melt.
+ *          The fitted glasses can be added to the in-memory catalog "MELT".
+ */
+class GlassMeltFitForm : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit GlassMeltFitForm(QMdiArea *parent = nullptr);
+    ~GlassMeltFitForm();
+
+private slots:
+    void importCSV();
+    void selectReferenceGlass();
+    void clearReferenceGlass();
+
+    /** Fit all the lots and show the result */
+    void fitAll();
+
+    /** Add the fitted glasses to the MELT catalog */
+    void addToCatalog();
+
+private:
+    bool loadCSV(const QString& filePath, QString& message);
+    void clearResult();
+    void setCellValue(QTableWidget* table, int row, int col, QString str);
+
+    Ui::GlassMeltFitForm *ui;
+    QMdiArea* m_parentMdiArea;
+
+    QStringList                                m_lotNames;
+    QVector< QVector<DispersionFitter::Sample> > m_lots;
+
+    int                               m_fittedFormula;
+    QVector<DispersionFitter::Result> m_results;
+
+    // copy of the reference glass, which is independent of the catalog reloading
+    std::unique_ptr<Glass> m_referenceGlass;
+};
+
+#endif // GLASS_MELT_FIT_FORM_H
@@ -0,0 +1,163 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_search_engine.h"
+
+#include <algorithm>
+#include <QtConcurrent>
+#include <QThread>
+
+namespace {
+
+/** Below this number of rows, the overhead of the threads is larger than the gain */
+constexpr int minRowsPerChunk = 4096;
+
+bool errorLess(const GlassSearchEngine::Result& a, const GlassSearchEngine::Result& b)
+{
+    return a.error < b.error;
+}
+
+}
+
+GlassSearchEngine::GlassSearchEngine()
+{
+
+}
+
+void GlassSearchEngine::setTable(const QSharedPointer<const GlassTable> &table)
+{
+    m_table = table;
+    compile();
+}
+
+void GlassSearchEngine::setTargets(const QList<Target> &targets)
+{
+    m_targets = targets;
+    compile();
+}
+
+void GlassSearchEngine::setRowFilter(const QVector<bool> &rowFilter)
+{
+    m_rowFilter = rowFilter;
+}
+
+void GlassSearchEngine::compile()
+{
+    m_compiledTargets.clear();
+
+    if(!m_table){
+        return;
+    }
+
+    for(auto &t : m_targets){
+        if(t.column < 0 || t.column >= GlassTable::ColumnCount || t.weight == 0.0){
+            continue;
+        }
+        m_compiledTargets.append(CompiledTarget{m_table->column(t.column).constData(), t.value, t.weight});
+    }
+}
+
+QVector<GlassSearchEngine::Result> GlassSearchEngine::searchRange(int rowBegin, int rowEnd, int k) const
+{
+    QVector<Result> heap;
+    heap.reserve(k + 1);
+
+    const CompiledTarget* targets = m_compiledTargets.constData();
+    const int targetCount = m_compiledTargets.size();
+
+    // The filter is ignored if it was made for another table.
+    const bool* rowFilter = (m_rowFilter.size() == m_table->rowCount()) ? m_rowFilter.constData() : nullptr;
+
+    for(int row = rowBegin; row < rowEnd; row++){
+        if(!m_table->isValid(row) || (rowFilter && !rowFilter[row])){
+            continue;
+        }
+
+        double e = 0.0;
+        for(int i = 0; i < targetCount; i++){
+            double d = targets[i].data[row] - targets[i].value;
+            e += targets[i].weight*d*d;
+        }
+
+        if(qIsNaN(e)){
+            continue;
+        }
+
+        if(heap.size() < k){
+            heap.append(Result{row, e});
+            std::push_heap(heap.begin(), heap.end(), errorLess);
+        }
+        else if(e < heap.first().error){
+            // replace the worst one
+            std::pop_heap(heap.begin(), heap.end(), errorLess);
+            heap.last() = Result{row, e};
+            std::push_heap(heap.begin(), heap.end(), errorLess);
+        }
+    }
+
+    return heap;
+}
+
+QVector<GlassSearchEngine::Result> GlassSearchEngine::search(int k) const
+{
+    if(!m_table || k <= 0 || m_compiledTargets.isEmpty()){
+        return QVector<Result>();
+    }
+
+    const int rowCount   = m_table->rowCount();
+    const int chunkCount = qBound(1, rowCount/minRowsPerChunk, QThread::idealThreadCount());
+
+    QVector<Result> results;
+
+    if(chunkCount == 1){
+        results = searchRange(0, rowCount, k);
+    }
+    else{
+        QVector<int> chunks(chunkCount);
+        for(int i = 0; i < chunkCount; i++){
+            chunks[i] = i;
+        }
+
+        QVector<QVector<Result>> heaps(chunkCount);
+        QtConcurrent::blockingMap(chunks, [&](int& chunk){
+            int rowBegin = static_cast<int>(static_cast<qint64>(rowCount)*chunk/chunkCount);
+            int rowEnd   = static_cast<int>(static_cast<qint64>(rowCount)*(chunk + 1)/chunkCount);
+            heaps[chunk] = searchRange(rowBegin, rowEnd, k);
+        });
+
+        // merge the candidates of the chunks, at most k per chunk
+        results.reserve(chunkCount*k);
+        for(auto &heap : heaps){
+            results += heap;
+        }
+    }
+
+    int resultCount = qMin(k, results.size());
+    std::partial_sort(results.begin(), results.begin() + resultCount, results.end(), [](const Result& a, const Result& b){
+        return (a.error < b.error) || (a.error == b.error && a.row < b.row);
+    });
+    results.resize(resultCount);
+
+    return results;
+}
@@ -0,0 +1,89 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_SEARCH_ENGINE_H
+#define GLASS_SEARCH_ENGINE_H
+
+#include <QList>
+#include <QVector>
+#include <QSharedPointer>
+
+#include "glass_table.h"
+
+/**
+ * @brief Search engine to find the glasses closest to the target properties
+ * @details The error of a glass is the weighted sum of squared differences from the targets.
+ *          Targets are compiled into column pointers once, the rows are scored in parallel chunks,
+ *          and each chunk keeps its best k glasses in a bounded heap.
+ */
+class GlassSearchEngine
+{
+public:
+    struct Target{
+        int    column; // GlassTable::Column
+        double value;
+        double weight;
+    };
+
+    struct Result{
+        int    row; // row in the table
+        double error;
+    };
+
+    GlassSearchEngine();
+
+    void setTable(const QSharedPointer<const GlassTable>& table);
+    const QSharedPointer<const GlassTable>& table() const { return m_table; }
+
+    void setTargets(const QList<Target>& targets);
+
+    /** Rows whose flag is false are excluded from the search.  Empty to search all the rows. */
+    void setRowFilter(const QVector<bool>& rowFilter);
+
+    /**
+     * @brief Find the best glasses
+     * @param k maximum number of the results
+     * @return results sorted by the error in ascending order
+     */
+    QVector<Result> search(int k) const;
+
+private:
+    struct CompiledTarget{
+        const double* data;
+        double        value;
+        double        weight;
+    };
+
+    /** Best k results in the rows [rowBegin, rowEnd), stored as a max-heap by the error */
+    QVector<Result> searchRange(int rowBegin, int rowEnd, int k) const;
+
+    void compile();
+
+    QSharedPointer<const GlassTable> m_table;
+    QList<Target>                    m_targets;
+    QVector<CompiledTarget>          m_compiledTargets;
+    QVector<bool>                    m_rowFilter;
+};
+
+#endif // GLASS_SEARCH_ENGINE_H
@@ -41,6 +41,9 @@ GlassSearchForm::GlassSearchForm(QMdiArea *parent) :
     ui->lineEdit_OutputCount->setValidator(new QIntValidator(0,100));
     ui->lineEdit_OutputCount->setText("5");
 
+    ui->lineEdit_Filter->setPlaceholderText("e.g. nd > 1.7 && status == \"Preferred\"");
+    ui->lineEdit_Filter->setToolTip("Identifiers: " + GlassExpression::identifiers().join(", "));
+
     // initialize parameters table
     QStringList hHeaderLabels({"Item"," Target", "Weight"});
     ui->tableWidget_Parameters->setColumnCount(hHeaderLabels.size());
@@ -54,6 +57,16 @@ GlassSearchForm::GlassSearchForm(QMdiArea *parent) :
     QObject::connect(ui->pushButton_Remove, SIGNAL(clicked()), this, SLOT(removeParameter()));
 
     QObject::connect(ui->pushButton_Search, SIGNAL(clicked()), this, SLOT(showSearchResult()));
+
+    // live update
+    QObject::connect(ui->tableWidget_Parameters, SIGNAL(cellChanged(int,int)), this, SLOT(showSearchResult()));
+    QObject::connect(ui->lineEdit_OutputCount,   SIGNAL(textEdited(QString)),  this, SLOT(showSearchResult()));
+    QObject::connect(ui->lineEdit_Filter,        SIGNAL(editingFinished()),    this, SLOT(showSearchResult()));
+
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(tableUpdated()), this, SLOT(showSearchResult()));
+    }
 }
 
 GlassSearchForm::~GlassSearchForm()
@@ -66,15 +79,21 @@ void GlassSearchForm::addParameter()
     QTableWidget *table = ui->tableWidget_Parameters;
     int newRowCount = table->rowCount() + 1;
     int currentRow = newRowCount -1;
+
+    // The live update is suspended while the new row is set up, then the search runs once.
+    table->blockSignals(true);
     table->setRowCount(newRowCount);
 
     QComboBox* combo = createParameterCombo();
     table->setCellWidget(currentRow, 0, combo);
+    QObject::connect(combo, SIGNAL(currentIndexChanged(int)), this, SLOT(showSearchResult()));
 
     setCellValue(table, currentRow, 1, "1.0"); // target
     setCellValue(table, currentRow, 2, "1.0"); // weight
+    table->blockSignals(false);
 
     table->update();
+    showSearchResult();
 }
 
 void GlassSearchForm::removeParameter()
@@ -82,62 +101,56 @@ void GlassSearchForm::removeParameter()
     if(ui->tableWidget_Parameters->rowCount() > 1) {
         int currentRow = ui->tableWidget_Parameters->currentRow();
         ui->tableWidget_Parameters->removeRow(currentRow);
+        showSearchResult();
     }
 }
 
 void GlassSearchForm::showSearchResult()
 {
-    // search glass
-    int resultCount = ui->lineEdit_OutputCount->text().toInt();
-    QList<Glass*> results;
-    QList<Glass*> allGlasses;
-
-    for(auto &cat : GlassCatalogManager::catalogList()) {
-        int glassCount = cat->glassCount();
-        for(int gi = 0; gi < glassCount; gi++) {
-            allGlasses.append(cat->glass(gi));
-        }
+    // The targets are compiled once and the whole table is scored by the engine.
+    // The snapshot is held while the filter evaluates n() and T() of the glasses.
+    std::shared_ptr<const CatalogSnapshot> snapshot = GlassCatalogManager::snapshot();
+    m_searchEngine.setTable(snapshot->table());
+    m_searchEngine.setTargets(getTargets());
+
+    // Only the glasses for which the filter expression is true are searched.
+    QString filterText = ui->lineEdit_Filter->text().trimmed();
+    if(filterText.isEmpty()){
+        m_searchEngine.setRowFilter(QVector<bool>());
+        ui->label_FilterError->clear();
     }
-
-    for(auto &g : allGlasses) {
-
-        double e = getErrorValue(g);
-
-        if(results.empty()) {
-            results.append(g);
-        }else {
-            for(int i = 0; i < results.size(); i++) {
-                if(e < getErrorValue(results[i])) {
-                    results.insert(i,g);
-                    if(results.size() > resultCount) {
-                        results.pop_back();
-                    }
-                    break;
-                }
-            }
-        }
-
+    else if(m_filter.compile(filterText)){
+        m_searchEngine.setRowFilter(GlassExpression::filter(*GlassCatalogManager::derivedColumn(snapshot, filterText)));
+        ui->label_FilterError->clear();
+    }
+    else{
+        m_searchEngine.setRowFilter(QVector<bool>(snapshot->table()->rowCount(), false));
+        ui->label_FilterError->setText(m_filter.errorMessage());
     }
 
+    int resultCount = ui->lineEdit_OutputCount->text().toInt();
+    QVector<GlassSearchEngine::Result> results = m_searchEngine.search(resultCount);
+    const GlassTable* table = m_searchEngine.table().data();
+
     //setup result table
     QStringList hHeaderLabels({"Glass", "Catalog"});
+    QList<int>  columns;
     for(int i = 0; i < ui->tableWidget_Parameters->rowCount(); i++) {
         QComboBox* combo = dynamic_cast<QComboBox*>(ui->tableWidget_Parameters->cellWidget(i,0));
         hHeaderLabels.append(combo->currentText());
+        columns.append(GlassTable::columnIndex(combo->currentText()));
     }
     ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
     ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
-    ui->tableWidget_Result->setRowCount(resultCount);
-    for(int i = 0; i < resultCount; i++) {
-        Glass* g = results[i];
-        setCellValue(ui->tableWidget_Result, i, 0, g->productName());
-        setCellValue(ui->tableWidget_Result, i, 1, g->supplier());
-
-        for(int j = 0; j < ui->tableWidget_Parameters->rowCount(); j++) {
-            QString param = dynamic_cast<QComboBox*>(ui->tableWidget_Parameters->cellWidget(j, 0))->currentText();
-            setCellValue(ui->tableWidget_Result, i, j+2, numToQString(g->getValue(param)));
+    ui->tableWidget_Result->setRowCount(results.size());
+    for(int i = 0; i < results.size(); i++) {
+        int row = results[i].row;
+        setCellValue(ui->tableWidget_Result, i, 0, table->productName(row));
+        setCellValue(ui->tableWidget_Result, i, 1, table->supplier(table->catalogIndex(row)));
+
+        for(int j = 0; j < columns.size(); j++) {
+            setCellValue(ui->tableWidget_Result, i, j+2, numToQString(table->value(columns[j], row)));
         }
-
     }
 
 }
@@ -177,24 +190,28 @@ void GlassSearchForm::setCellValue(QTableWidget* table, int row, int col, QStrin
 }
 
 
-double GlassSearchForm::getErrorValue(const Glass* g)
+QList<GlassSearchEngine::Target> GlassSearchForm::getTargets() const
 {
-    double e = 0.0;
+    QList<GlassSearchEngine::Target> targets;
 
-    int parameterCount = ui->tableWidget_Parameters->rowCount();
-
-    for(int i = 0; i < parameterCount; i++) {
-
-        double pt = ui->tableWidget_Parameters->item(i, 1)->text().toDouble();
-        double w = ui->tableWidget_Parameters->item(i, 2)->text().toDouble();
+    for(int i = 0; i < ui->tableWidget_Parameters->rowCount(); i++) {
+        QTableWidgetItem* targetItem = ui->tableWidget_Parameters->item(i, 1);
+        QTableWidgetItem* weightItem = ui->tableWidget_Parameters->item(i, 2);
+        QComboBox*        combo      = dynamic_cast<QComboBox*>(ui->tableWidget_Parameters->cellWidget(i,0));
 
-        QString paramName = dynamic_cast<QComboBox*>(ui->tableWidget_Parameters->cellWidget(i,0))->currentText();
-        double p = g->getValue(paramName);
+        // the row being added
+        if(!targetItem || !weightItem || !combo){
+            continue;
+        }
 
-        e += w*pow(p-pt,2);
+        GlassSearchEngine::Target t;
+        t.column = GlassTable::columnIndex(combo->currentText());
+        t.value  = targetItem->text().toDouble();
+        t.weight = weightItem->text().toDouble();
+        targets.append(t);
     }
 
-    return e;
+    return targets;
 }
 
 QComboBox* GlassSearchForm::createParameterCombo()
@@ -32,6 +32,9 @@
 #include <QComboBox>
 
 #include "glass.h"
+#include "glass_table.h"
+#include "glass_search_engine.h"
+#include "glass_expression.h"
 
 namespace Ui {
 class GlassSearchForm;
@@ -60,8 +63,8 @@ private slots:
     void validateCellInput(int row, int col);
 
 private:
-    /** Compute error function value */
-    double getErrorValue(const Glass* g);
+    /** Targets and weights in the parameter table */
+    QList<GlassSearchEngine::Target> getTargets() const;
     QComboBox* createParameterCombo();
     void setCellValue(QTableWidget* table, int row, int col, QString str);
 
@@ -71,6 +74,9 @@ private:
     QMdiArea*     m_parentMdiArea;
     QTableWidget* m_tableProperties;
     QTableWidget* m_tableResult;
+
+    GlassSearchEngine m_searchEngine;
+    GlassExpression   m_filter;
 };
 
 
@@ -70,7 +70,7 @@ void GlassSelectionDialog::createGlassNameList()
 {
     m_glassNameList.clear();
     int catalogIndex = m_comboBoxSupplyer->currentIndex();
-    GlassCatalog* catalog = GlassCatalogManager::catalogList().at(catalogIndex);
+    const GlassCatalog* catalog = GlassCatalogManager::catalogList().at(catalogIndex);
     for(int i = 0; i < catalog->glassCount(); i++)
     {
         m_glassNameList.append(catalog->glass(i)->productName());
@@ -0,0 +1,249 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_skyline.h"
+
+#include <algorithm>
+#include <QtConcurrent>
+#include <QtNumeric>
+#include <QThread>
+
+namespace {
+
+/** Below this number of candidates, the overhead of the threads is larger than the gain */
+constexpr int minCandidatesPerChunk = 2048;
+
+}
+
+GlassSkyline::GlassSkyline()
+{
+
+}
+
+const QList<GlassSkyline::Objective>& GlassSkyline::presetObjectives()
+{
+    static const QList<Objective> objectives({
+        Objective{GlassTable::ColumnRelCost,       Minimize},
+        Objective{GlassTable::ColumnDPgF,          MinimizeAbsolute},
+        Objective{GlassTable::ColumnTi400,         Maximize},
+        Objective{GlassTable::ColumnClimateResist, Minimize},
+        Objective{GlassTable::ColumnStainResist,   Minimize},
+        Objective{GlassTable::ColumnAcidResist,    Minimize},
+        Objective{GlassTable::ColumnAlkaliResist,  Minimize},
+        Objective{GlassTable::ColumnDnDt,          MinimizeAbsolute},
+        Objective{GlassTable::ColumnNd,            Maximize},
+        Objective{GlassTable::ColumnVd,            Maximize}
+    });
+    return objectives;
+}
+
+QString GlassSkyline::objectiveName(const Objective &objective)
+{
+    QString name = GlassTable::columnNames().value(objective.column);
+
+    switch (objective.sense) {
+    case Minimize:         return "Min " + name;
+    case Maximize:         return "Max " + name;
+    case MinimizeAbsolute: return "Min |" + name + "|";
+    }
+    return name;
+}
+
+void GlassSkyline::setTable(const QSharedPointer<const GlassTable> &table)
+{
+    m_table = table;
+}
+
+void GlassSkyline::setObjectives(const QList<Objective> &objectives)
+{
+    m_objectives = objectives;
+}
+
+double GlassSkyline::objectiveValue(int objective, int row) const
+{
+    const Objective& o = m_objectives[objective];
+    double val = m_table->value(o.column, row);
+
+    // negative relative cost means no data in AGF
+    if(GlassTable::ColumnRelCost == o.column && val < 0){
+        return NAN;
+    }
+
+    switch (o.sense) {
+    case Minimize:         return val;
+    case Maximize:         return -val;
+    case MinimizeAbsolute: return qAbs(val);
+    }
+    return val;
+}
+
+bool GlassSkyline::dominates(const double *a, const double *b, int dim)
+{
+    bool better = false;
+    for(int i = 0; i < dim; i++){
+        if(a[i] > b[i]){
+            return false;
+        }
+        if(a[i] < b[i]){
+            better = true;
+        }
+    }
+    return better;
+}
+
+QVector<GlassSkyline::Candidate> GlassSkyline::reduce(QVector<Candidate> candidates, int dim)
+{
+    // Since the score is strictly monotone, a dominating glass always comes first.
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b){
+        return a.score < b.score;
+    });
+
+    QVector<Candidate> skyline;
+    for(auto &c : candidates){
+        bool dominated = false;
+        for(auto &s : skyline){
+            if(dominates(s.values, c.values, dim)){
+                dominated = true;
+                break;
+            }
+        }
+        if(!dominated){
+            skyline.append(c);
+        }
+    }
+
+    return skyline;
+}
+
+QVector<int> GlassSkyline::compute(const Filter &filter) const
+{
+    QVector<int> rows;
+
+    const int dim = m_objectives.size();
+    if(!m_table || 0 == dim){
+        return rows;
+    }
+
+    const GlassTable* table = m_table.data();
+    const QVector<quint8>& status = table->statusColumn();
+
+    // objectives of the candidates, dim values per candidate
+    QVector<double> values;
+    QVector<int>    candidateRows;
+    values.reserve(table->rowCount()*dim);
+    candidateRows.reserve(table->rowCount());
+
+    QVector<double> v(dim);
+    for(int row = 0; row < table->rowCount(); row++){
+        if(!table->isValid(row)){
+            continue;
+        }
+        if(filter.excludeObsolete && GlassTable::StatusObsolete == status[row]){
+            continue;
+        }
+        if(!filter.catalogs.isEmpty()){
+            int ci = table->catalogIndex(row);
+            if(ci >= filter.catalogs.size() || !filter.catalogs[ci]){
+                continue;
+            }
+        }
+
+        bool ok = true;
+        for(int i = 0; i < dim && ok; i++){
+            v[i] = objectiveValue(i, row);
+            ok = qIsFinite(v[i]);
+        }
+        if(ok){
+            values.append(v);
+            candidateRows.append(row);
+        }
+    }
+
+    const int count = candidateRows.size();
+    if(0 == count){
+        return rows;
+    }
+
+    // normalize the score by the range of each objective
+    QVector<double> vmin(dim, qInf()), vmax(dim, -qInf());
+    for(int c = 0; c < count; c++){
+        for(int i = 0; i < dim; i++){
+            vmin[i] = qMin(vmin[i], values[c*dim + i]);
+            vmax[i] = qMax(vmax[i], values[c*dim + i]);
+        }
+    }
+
+    QVector<Candidate> candidates(count);
+    for(int c = 0; c < count; c++){
+        double score = 0.0;
+        for(int i = 0; i < dim; i++){
+            double range = vmax[i] - vmin[i];
+            score += (range > 0.0) ? (values[c*dim + i] - vmin[i])/range : 0.0;
+        }
+        candidates[c] = Candidate{candidateRows[c], score, values.constData() + c*dim};
+    }
+
+    // local skylines in parallel
+    int chunkCount = qBound(1, count/minCandidatesPerChunk, QThread::idealThreadCount());
+    QVector< QVector<Candidate> > chunks(chunkCount);
+    for(int c = 0; c < chunkCount; c++){
+        int begin = count*c/chunkCount;
+        int end   = count*(c + 1)/chunkCount;
+        chunks[c] = candidates.mid(begin, end - begin);
+    }
+
+    QVector<Candidate> merged;
+    if(chunkCount > 1){
+        QVector<int> indices(chunkCount);
+        for(int c = 0; c < chunkCount; c++){
+            indices[c] = c;
+        }
+        QVector<Candidate>* data = chunks.data();
+        QtConcurrent::blockingMap(indices, [data, dim](int c){
+            data[c] = reduce(data[c], dim);
+        });
+
+        // The global skyline is a subset of the union of the local skylines.
+        for(auto &chunk : chunks){
+            merged += chunk;
+        }
+    }
+    else{
+        merged = candidates;
+    }
+
+    const QVector<Candidate> skyline = reduce(merged, dim);
+
+    rows.reserve(skyline.size());
+    for(auto &s : skyline){
+        rows.append(s.row);
+    }
+
+    // sort by the first objective for display
+    std::sort(rows.begin(), rows.end(), [this](int a, int b){
+        return objectiveValue(0, a) < objectiveValue(0, b);
+    });
+
+    return rows;
+}
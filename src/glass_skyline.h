@@ -0,0 +1,96 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_SKYLINE_H
+#define GLASS_SKYLINE_H
+
+#include <QList>
+#include <QVector>
+#include <QStringList>
+#include <QSharedPointer>
+
+#include "glass_table.h"
+
+/**
+ * @brief Skyline (Pareto front) query over the glass table
+ * @details A glass is in the skyline if no other glass is at least as good in all of the objectives and better in one of them.
+ *          The rows are split into chunks whose local skylines are computed in parallel, and then the union of them is reduced to the global skyline.
+ *          Each skyline is computed by sort-filter-skyline: the candidates are sorted by the sum of normalized objectives,
+ *          so that a glass can only be dominated by the glasses before it.
+ */
+class GlassSkyline
+{
+public:
+    enum Sense{
+        Minimize,
+        Maximize,
+        MinimizeAbsolute
+    };
+
+    struct Objective{
+        int   column; // GlassTable::Column
+        Sense sense;
+    };
+
+    struct Filter{
+        QVector<bool> catalogs;        // accepted catalogs indexed by the catalog index, empty to accept all
+        bool          excludeObsolete;
+    };
+
+    GlassSkyline();
+
+    /** Objectives selectable in the form */
+    static const QList<Objective>& presetObjectives();
+    static QString objectiveName(const Objective& objective);
+
+    void setTable(const QSharedPointer<const GlassTable>& table);
+    const QSharedPointer<const GlassTable>& table() const { return m_table; }
+
+    void setObjectives(const QList<Objective>& objectives);
+    const QList<Objective>& objectives() const { return m_objectives; }
+
+    /**
+     * @brief Compute the skyline
+     * @return rows of the non-dominated glasses, sorted by the first objective.
+     *         Glasses lacking some of the objectives are ignored.
+     */
+    QVector<int> compute(const Filter& filter) const;
+
+private:
+    /** Candidate with the objectives converted to be minimized */
+    struct Candidate{
+        int    row;
+        double score; // sum of the normalized objectives
+        const double* values;
+    };
+
+    double objectiveValue(int objective, int row) const;
+    static bool dominates(const double* a, const double* b, int dim);
+    static QVector<Candidate> reduce(QVector<Candidate> candidates, int dim);
+
+    QSharedPointer<const GlassTable> m_table;
+    QList<Objective>                 m_objectives;
+};
+
+#endif // GLASS_SKYLINE_H
@@ -0,0 +1,196 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_skyline_form.h"
+#include "ui_glass_skyline_form.h"
+
+#include <QListWidgetItem>
+#include <QMdiSubWindow>
+
+#include "glass_catalog_manager.h"
+#include "glassmap_form.h"
+
+GlassSkylineForm::GlassSkylineForm(QMdiArea *parent) :
+    QWidget(parent),
+    ui(new Ui::GlassSkylineForm),
+    m_parentMdiArea(parent)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Pareto Front");
+
+    m_overlayShown = false;
+
+    ui->checkBox_ExcludeObsolete->setChecked(true);
+
+    // objectives, the first four are selected by default
+    const QList<GlassSkyline::Objective>& objectives = GlassSkyline::presetObjectives();
+    for(int i = 0; i < objectives.size(); i++){
+        QListWidgetItem* item = new QListWidgetItem(GlassSkyline::objectiveName(objectives[i]), ui->listWidget_Objectives);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(i < 4 ? Qt::Checked : Qt::Unchecked);
+    }
+
+    updateCatalogList();
+
+    // live update
+    QObject::connect(ui->listWidget_Objectives,    SIGNAL(itemChanged(QListWidgetItem*)), this, SLOT(showSkyline()));
+    QObject::connect(ui->listWidget_Catalogs,      SIGNAL(itemChanged(QListWidgetItem*)), this, SLOT(showSkyline()));
+    QObject::connect(ui->checkBox_ExcludeObsolete, SIGNAL(toggled(bool)),                 this, SLOT(showSkyline()));
+    QObject::connect(ui->checkBox_ShowOnMaps,      SIGNAL(toggled(bool)),                 this, SLOT(showSkyline()));
+
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(tableUpdated()), this, SLOT(updateCatalogList()));
+        QObject::connect(manager, SIGNAL(tableUpdated()), this, SLOT(showSkyline()));
+    }
+
+    showSkyline();
+}
+
+GlassSkylineForm::~GlassSkylineForm()
+{
+    if(m_overlayShown){
+        setOverlayToGlassMaps(QStringList());
+    }
+    delete ui;
+}
+
+void GlassSkylineForm::updateCatalogList()
+{
+    QSharedPointer<const GlassTable> table = GlassCatalogManager::table();
+    if(!table){
+        return;
+    }
+
+    // keep unchecked suppliers unchecked
+    QStringList uncheckedSuppliers;
+    for(int i = 0; i < ui->listWidget_Catalogs->count(); i++){
+        QListWidgetItem* item = ui->listWidget_Catalogs->item(i);
+        if(Qt::Unchecked == item->checkState()){
+            uncheckedSuppliers.append(item->text());
+        }
+    }
+
+    ui->listWidget_Catalogs->blockSignals(true);
+    ui->listWidget_Catalogs->clear();
+    for(int ci = 0; ci < table->catalogCount(); ci++){
+        QListWidgetItem* item = new QListWidgetItem(table->supplier(ci), ui->listWidget_Catalogs);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(uncheckedSuppliers.contains(table->supplier(ci)) ? Qt::Unchecked : Qt::Checked);
+    }
+    ui->listWidget_Catalogs->blockSignals(false);
+}
+
+QList<GlassSkyline::Objective> GlassSkylineForm::getObjectives() const
+{
+    QList<GlassSkyline::Objective> objectives;
+
+    const QList<GlassSkyline::Objective>& presets = GlassSkyline::presetObjectives();
+    for(int i = 0; i < ui->listWidget_Objectives->count() && i < presets.size(); i++){
+        if(Qt::Checked == ui->listWidget_Objectives->item(i)->checkState()){
+            objectives.append(presets[i]);
+        }
+    }
+
+    return objectives;
+}
+
+GlassSkyline::Filter GlassSkylineForm::getFilter() const
+{
+    GlassSkyline::Filter filter;
+    filter.excludeObsolete = ui->checkBox_ExcludeObsolete->isChecked();
+
+    // The list is in the catalog order of the table.
+    for(int i = 0; i < ui->listWidget_Catalogs->count(); i++){
+        filter.catalogs.append(Qt::Checked == ui->listWidget_Catalogs->item(i)->checkState());
+    }
+
+    return filter;
+}
+
+void GlassSkylineForm::showSkyline()
+{
+    m_skyline.setTable(GlassCatalogManager::table());
+    m_skyline.setObjectives(getObjectives());
+
+    const QVector<int> rows = m_skyline.compute(getFilter());
+    const GlassTable* table = m_skyline.table().data();
+    const QList<GlassSkyline::Objective>& objectives = m_skyline.objectives();
+
+    // setup result table
+    QStringList hHeaderLabels({"Glass", "Catalog"});
+    for(auto &o : objectives){
+        hHeaderLabels.append(GlassTable::columnNames().value(o.column));
+    }
+    ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
+    ui->tableWidget_Result->setRowCount(rows.size());
+
+    QStringList fullNames;
+    for(int i = 0; i < rows.size(); i++){
+        int row = rows[i];
+        setCellValue(ui->tableWidget_Result, i, 0, table->productName(row));
+        setCellValue(ui->tableWidget_Result, i, 1, table->supplier(table->catalogIndex(row)));
+        for(int j = 0; j < objectives.size(); j++){
+            setCellValue(ui->tableWidget_Result, i, j + 2, numToQString(table->value(objectives[j].column, row), 'g', 6));
+        }
+        fullNames.append(table->fullName(row));
+    }
+
+    ui->label_Count->setText(QString("Non-dominated glasses: %1").arg(rows.size()));
+
+    if(ui->checkBox_ShowOnMaps->isChecked()){
+        setOverlayToGlassMaps(fullNames);
+        m_overlayShown = true;
+    }
+    else if(m_overlayShown){
+        setOverlayToGlassMaps(QStringList());
+        m_overlayShown = false;
+    }
+}
+
+void GlassSkylineForm::setOverlayToGlassMaps(const QStringList &fullNames)
+{
+    if(!m_parentMdiArea){
+        return;
+    }
+
+    for(auto subwindow : m_parentMdiArea->subWindowList()){
+        GlassMapForm* glassMapForm = qobject_cast<GlassMapForm*>(subwindow->widget());
+        if(glassMapForm){
+            glassMapForm->setOverlay("Pareto front", fullNames);
+        }
+    }
+}
+
+void GlassSkylineForm::setCellValue(QTableWidget* table, int row, int col, QString str)
+{
+    QTableWidgetItem *item = table->item(row, col);
+    if(!item){
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+    }
+    item->setTextAlignment(Qt::AlignRight);
+    item->setText(str);
+}
@@ -0,0 +1,82 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_SKYLINE_FORM_H
+#define GLASS_SKYLINE_FORM_H
+
+#include <QWidget>
+#include <QMdiArea>
+#include <QTableWidget>
+
+#include "glass_skyline.h"
+
+namespace Ui {
+class GlassSkylineForm;
+}
+
+/** Form to show the Pareto front of the glasses for the selected objectives */
+class GlassSkylineForm : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit GlassSkylineForm(QMdiArea *parent = nullptr);
+    ~GlassSkylineForm();
+
+private slots:
+    /** Compute the skyline and show result */
+    void showSkyline();
+
+    /** Update the catalog list keeping the check states */
+    void updateCatalogList();
+
+private:
+    QList<GlassSkyline::Objective> getObjectives() const;
+    GlassSkyline::Filter getFilter() const;
+
+    /** Show the skyline on the glassmaps in the mdi area, or clear it if the list is empty */
+    void setOverlayToGlassMaps(const QStringList& fullNames);
+
+    void setCellValue(QTableWidget* table, int row, int col, QString str);
+
+    inline QString numToQString(double val, char fmt='f', int digit=6);
+
+    Ui::GlassSkylineForm *ui;
+    QMdiArea* m_parentMdiArea;
+
+    GlassSkyline m_skyline;
+    bool         m_overlayShown;
+};
+
+QString GlassSkylineForm::numToQString(double val, char fmt, int digit)
+{
+    if(qIsNaN(val)){
+        return "-";
+    }
+    else{
+        return QString::number(val, fmt, digit);
+    }
+}
+
+#endif // GLASS_SKYLINE_FORM_H
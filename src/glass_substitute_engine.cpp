@@ -0,0 +1,224 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_substitute_engine.h"
+
+#include <QtConcurrent>
+#include <QtMath>
+#include <QtNumeric>
+
+GlassSubstituteEngine::GlassSubstituteEngine()
+{
+    m_weights = QVector<double>(PropertyCount, 0.0);
+    m_weights[PropertyNd]  = 1.0;
+    m_weights[PropertyVd]  = 1.0;
+    m_weights[PropertyPgF] = 1.0;
+}
+
+const QStringList& GlassSubstituteEngine::propertyNames()
+{
+    static const QStringList names({"nd", "vd", "PgF", "dn/dT", "CTE", "Relative Cost"});
+    Q_ASSERT(names.size() == PropertyCount);
+    return names;
+}
+
+int GlassSubstituteEngine::propertyColumn(int property)
+{
+    switch (property) {
+    case PropertyNd:      return GlassTable::ColumnNd;
+    case PropertyVd:      return GlassTable::ColumnVd;
+    case PropertyPgF:     return GlassTable::ColumnPgF;
+    case PropertyDnDt:    return GlassTable::ColumnDnDt;
+    case PropertyTCE:     return GlassTable::ColumnLowTCE;
+    case PropertyRelCost: return GlassTable::ColumnRelCost;
+    default:
+        return -1;
+    }
+}
+
+void GlassSubstituteEngine::setTable(const QSharedPointer<const GlassTable> &table)
+{
+    m_table = table;
+    rebuild();
+}
+
+void GlassSubstituteEngine::setWeights(const QVector<double> &weights)
+{
+    Q_ASSERT(weights.size() == PropertyCount);
+    m_weights = weights;
+    rebuild();
+}
+
+double GlassSubstituteEngine::propertyValue(int property, int row) const
+{
+    double val = m_table->value(propertyColumn(property), row);
+
+    // negative relative cost means no data in AGF
+    if(PropertyRelCost == property && val < 0){
+        return NAN;
+    }
+    return val;
+}
+
+bool GlassSubstituteEngine::coordinates(int row, double *coords) const
+{
+    for(int i = 0; i < m_activeProperties.size(); i++){
+        double val = propertyValue(m_activeProperties[i], row);
+        if(!qIsFinite(val)){
+            return false;
+        }
+        coords[i] = val*m_scales[i];
+    }
+    return true;
+}
+
+bool GlassSubstituteEngine::canQuery(int row) const
+{
+    if(!m_table || row < 0 || row >= m_table->rowCount() || m_activeProperties.isEmpty()){
+        return false;
+    }
+    QVector<double> coords(m_activeProperties.size());
+    return coordinates(row, coords.data());
+}
+
+void GlassSubstituteEngine::rebuild()
+{
+    m_tree.clear();
+    m_activeProperties.clear();
+    m_scales.clear();
+
+    if(!m_table){
+        return;
+    }
+
+    const int rowCount = m_table->rowCount();
+
+    for(int p = 0; p < PropertyCount; p++){
+        if(m_weights[p] <= 0.0){
+            continue;
+        }
+
+        // standard deviation over the valid glasses having the property
+        double sum = 0.0, sum2 = 0.0;
+        int    n   = 0;
+        for(int row = 0; row < rowCount; row++){
+            double val = propertyValue(p, row);
+            if(m_table->isValid(row) && qIsFinite(val)){
+                sum  += val;
+                sum2 += val*val;
+                n++;
+            }
+        }
+        double sd = (n > 1) ? sqrt(qMax(0.0, (sum2 - sum*sum/n)/(n - 1))) : 0.0;
+        if(sd <= 0.0){
+            continue;
+        }
+
+        m_activeProperties.append(p);
+        m_scales.append(sqrt(m_weights[p])/sd);
+    }
+
+    if(m_activeProperties.isEmpty()){
+        return;
+    }
+
+    const int dim = m_activeProperties.size();
+    QVector<double> coords;
+    QVector<int>    ids;
+    coords.reserve(rowCount*dim);
+    ids.reserve(rowCount);
+
+    QVector<double> c(dim);
+    for(int row = 0; row < rowCount; row++){
+        if(m_table->isValid(row) && coordinates(row, c.data())){
+            coords.append(c);
+            ids.append(row);
+        }
+    }
+
+    m_tree.build(coords, dim, ids);
+}
+
+QVector<GlassSubstituteEngine::Substitute> GlassSubstituteEngine::find(int row, int k, const Filter &filter) const
+{
+    QVector<Substitute> results;
+
+    QVector<double> query(m_activeProperties.size());
+    if(!canQuery(row) || !coordinates(row, query.data())){
+        return results;
+    }
+
+    const GlassTable* table = m_table.data();
+    const QVector<quint8>& status = table->statusColumn();
+
+    auto accept = [&](int id){
+        if(id == row){
+            return false;
+        }
+        if(filter.excludeObsolete && GlassTable::StatusObsolete == status[id]){
+            return false;
+        }
+        if(!filter.catalogs.isEmpty()){
+            int ci = table->catalogIndex(id);
+            if(ci >= filter.catalogs.size() || !filter.catalogs[ci]){
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const QVector<VpTree::Neighbor> neighbors = m_tree.kNearest(query.constData(), k, accept);
+
+    results.reserve(neighbors.size());
+    for(auto &nb : neighbors){
+        Substitute s;
+        s.row      = nb.id;
+        s.distance = nb.distance;
+        s.deltas   = QVector<double>(PropertyCount);
+        for(int p = 0; p < PropertyCount; p++){
+            s.deltas[p] = propertyValue(p, nb.id) - propertyValue(p, row);
+        }
+        results.append(s);
+    }
+
+    return results;
+}
+
+QVector< QVector<GlassSubstituteEngine::Substitute> > GlassSubstituteEngine::findBatch(const QVector<int> &rows, int k, const Filter &filter) const
+{
+    QVector< QVector<Substitute> > results(rows.size());
+
+    QVector<int> indices(rows.size());
+    for(int i = 0; i < indices.size(); i++){
+        indices[i] = i;
+    }
+
+    // the tree and the table are read-only here, so the queries are independent
+    QVector<Substitute>* out = results.data();
+    QtConcurrent::blockingMap(indices, [&](int i){
+        out[i] = find(rows[i], k, filter);
+    });
+
+    return results;
+}
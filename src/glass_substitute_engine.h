@@ -0,0 +1,108 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_SUBSTITUTE_ENGINE_H
+#define GLASS_SUBSTITUTE_ENGINE_H
+
+#include <QVector>
+#include <QStringList>
+#include <QSharedPointer>
+
+#include "glass_table.h"
+#include "vp_tree.h"
+
+/**
+ * @brief Engine to find substitutes of a glass by the nearest neighbors in a multi-property space
+ * @details Each property is divided by its standard deviation over the catalogs and multiplied by the square root of its weight,
+ *          so that the Euclidean distance is the weighted sum of squared normalized differences.
+ *          The glasses having all of the weighted properties are indexed by a VP-tree.
+ */
+class GlassSubstituteEngine
+{
+public:
+    enum Property{
+        PropertyNd,
+        PropertyVd,
+        PropertyPgF,
+        PropertyDnDt,
+        PropertyTCE,
+        PropertyRelCost,
+        PropertyCount
+    };
+
+    struct Filter{
+        QVector<bool> catalogs;        // accepted catalogs indexed by the catalog index, empty to accept all
+        bool          excludeObsolete;
+    };
+
+    struct Substitute{
+        int             row;      // row in the table
+        double          distance;
+        QVector<double> deltas;   // property of the substitute minus that of the query glass, indexed by Property
+    };
+
+    GlassSubstituteEngine();
+
+    static const QStringList& propertyNames();
+
+    /** @return GlassTable::Column of the property */
+    static int propertyColumn(int property);
+
+    void setTable(const QSharedPointer<const GlassTable>& table);
+    const QSharedPointer<const GlassTable>& table() const { return m_table; }
+
+    /** @param weights weights indexed by Property. Properties with zero weight are ignored. */
+    void setWeights(const QVector<double>& weights);
+    const QVector<double>& weights() const { return m_weights; }
+
+    /** @return number of the glasses indexed, which have all of the weighted properties */
+    int indexedCount() const { return m_tree.size(); }
+
+    /** @return true if the glass has all of the weighted properties */
+    bool canQuery(int row) const;
+
+    /**
+     * @brief Find the substitutes of a glass
+     * @param row row of the query glass
+     * @param k maximum number of the results
+     * @return substitutes sorted by the distance. The query glass itself is excluded.
+     */
+    QVector<Substitute> find(int row, int k, const Filter& filter) const;
+
+    /** Find the substitutes of each glass in parallel */
+    QVector< QVector<Substitute> > findBatch(const QVector<int>& rows, int k, const Filter& filter) const;
+
+private:
+    void   rebuild();
+    double propertyValue(int property, int row) const;
+    bool   coordinates(int row, double* coords) const;
+
+    QSharedPointer<const GlassTable> m_table;
+    QVector<double>                  m_weights;
+    QVector<int>                     m_activeProperties;
+    QVector<double>                  m_scales; // multiplier of each active property
+    VpTree                           m_tree;
+};
+
+#endif // GLASS_SUBSTITUTE_ENGINE_H
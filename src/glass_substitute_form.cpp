@@ -0,0 +1,244 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_substitute_form.h"
+#include "ui_glass_substitute_form.h"
+
+#include <QMessageBox>
+#include <QIntValidator>
+#include <QListWidgetItem>
+#include <QDebug>
+
+#include "glass.h"
+#include "glass_catalog_manager.h"
+#include "glass_selection_dialog.h"
+
+GlassSubstituteForm::GlassSubstituteForm(QMdiArea *parent) :
+    QWidget(parent),
+    ui(new Ui::GlassSubstituteForm),
+    m_parentMdiArea(parent)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Glass Substitute");
+
+    ui->lineEdit_OutputCount->setValidator(new QIntValidator(0,100));
+    ui->lineEdit_OutputCount->setText("5");
+
+    ui->checkBox_ExcludeObsolete->setChecked(true);
+
+    // initialize weight table
+    const QStringList& propertyNames = GlassSubstituteEngine::propertyNames();
+    const QVector<double>& weights = m_engine.weights();
+    ui->tableWidget_Weights->setColumnCount(1);
+    ui->tableWidget_Weights->setHorizontalHeaderLabels(QStringList({"Weight"}));
+    ui->tableWidget_Weights->setRowCount(propertyNames.size());
+    ui->tableWidget_Weights->setVerticalHeaderLabels(propertyNames);
+    for(int i = 0; i < propertyNames.size(); i++){
+        setCellValue(ui->tableWidget_Weights, i, 0, QString::number(weights[i]));
+    }
+
+    updateCatalogList();
+
+    QObject::connect(ui->pushButton_Add,    SIGNAL(clicked()), this, SLOT(addGlass()));
+    QObject::connect(ui->pushButton_Remove, SIGNAL(clicked()), this, SLOT(removeGlass()));
+    QObject::connect(ui->pushButton_Search, SIGNAL(clicked()), this, SLOT(showSearchResult()));
+
+    // live update
+    QObject::connect(ui->tableWidget_Weights,      SIGNAL(cellChanged(int,int)),              this, SLOT(showSearchResult()));
+    QObject::connect(ui->listWidget_Catalogs,      SIGNAL(itemChanged(QListWidgetItem*)),     this, SLOT(showSearchResult()));
+    QObject::connect(ui->checkBox_ExcludeObsolete, SIGNAL(toggled(bool)),                     this, SLOT(showSearchResult()));
+    QObject::connect(ui->lineEdit_OutputCount,     SIGNAL(textEdited(QString)),               this, SLOT(showSearchResult()));
+
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(tableUpdated()), this, SLOT(updateCatalogList()));
+        QObject::connect(manager, SIGNAL(tableUpdated()), this, SLOT(showSearchResult()));
+    }
+}
+
+GlassSubstituteForm::~GlassSubstituteForm()
+{
+    delete ui;
+}
+
+void GlassSubstituteForm::addGlass()
+{
+    GlassSelectionDialog *dlg = new GlassSelectionDialog(this);
+    if(dlg->exec() == QDialog::Accepted)
+    {
+        Glass* newGlass = dlg->getSelectedGlass();
+        if(newGlass && !m_queryGlasses.contains(newGlass->fullName())){
+            m_queryGlasses.append(newGlass->fullName());
+            ui->listWidget_Query->addItem(newGlass->fullName());
+            showSearchResult();
+        }
+    }
+
+    delete dlg;
+}
+
+void GlassSubstituteForm::removeGlass()
+{
+    int currentRow = ui->listWidget_Query->currentRow();
+    if(currentRow < 0 || currentRow >= m_queryGlasses.size()){
+        return;
+    }
+
+    m_queryGlasses.removeAt(currentRow);
+    delete ui->listWidget_Query->takeItem(currentRow);
+    showSearchResult();
+}
+
+void GlassSubstituteForm::updateCatalogList()
+{
+    QSharedPointer<const GlassTable> table = GlassCatalogManager::table();
+    if(!table){
+        return;
+    }
+
+    // keep unchecked suppliers unchecked
+    QStringList uncheckedSuppliers;
+    for(int i = 0; i < ui->listWidget_Catalogs->count(); i++){
+        QListWidgetItem* item = ui->listWidget_Catalogs->item(i);
+        if(Qt::Unchecked == item->checkState()){
+            uncheckedSuppliers.append(item->text());
+        }
+    }
+
+    ui->listWidget_Catalogs->blockSignals(true);
+    ui->listWidget_Catalogs->clear();
+    for(int ci = 0; ci < table->catalogCount(); ci++){
+        QListWidgetItem* item = new QListWidgetItem(table->supplier(ci), ui->listWidget_Catalogs);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(uncheckedSuppliers.contains(table->supplier(ci)) ? Qt::Unchecked : Qt::Checked);
+    }
+    ui->listWidget_Catalogs->blockSignals(false);
+}
+
+QVector<double> GlassSubstituteForm::getWeights() const
+{
+    QVector<double> weights(GlassSubstituteEngine::PropertyCount, 0.0);
+
+    for(int i = 0; i < weights.size() && i < ui->tableWidget_Weights->rowCount(); i++){
+        QTableWidgetItem* item = ui->tableWidget_Weights->item(i, 0);
+        if(item){
+            weights[i] = qMax(0.0, item->text().toDouble());
+        }
+    }
+
+    return weights;
+}
+
+GlassSubstituteEngine::Filter GlassSubstituteForm::getFilter() const
+{
+    GlassSubstituteEngine::Filter filter;
+    filter.excludeObsolete = ui->checkBox_ExcludeObsolete->isChecked();
+
+    // The list is in the catalog order of the table.
+    for(int i = 0; i < ui->listWidget_Catalogs->count(); i++){
+        filter.catalogs.append(Qt::Checked == ui->listWidget_Catalogs->item(i)->checkState());
+    }
+
+    return filter;
+}
+
+void GlassSubstituteForm::showSearchResult()
+{
+    // The tree is rebuilt only when the catalogs or the weights are changed.
+    QSharedPointer<const GlassTable> currentTable = GlassCatalogManager::table();
+    if(m_engine.table() != currentTable){
+        m_engine.setTable(currentTable);
+    }
+    QVector<double> weights = getWeights();
+    if(m_engine.weights() != weights){
+        m_engine.setWeights(weights);
+    }
+
+    const GlassTable* table = m_engine.table().data();
+    if(!table){
+        return;
+    }
+
+    QVector<int> queryRows;
+    for(auto &name : m_queryGlasses){
+        queryRows.append(table->findRow(name));
+    }
+
+    int resultCount = ui->lineEdit_OutputCount->text().toInt();
+    QVector< QVector<GlassSubstituteEngine::Substitute> > results = m_engine.findBatch(queryRows, resultCount, getFilter());
+
+    // setup result table
+    const QStringList& propertyNames = GlassSubstituteEngine::propertyNames();
+    QStringList hHeaderLabels({"Query", "Rank", "Glass", "Catalog", "Distance"});
+    for(auto &name : propertyNames){
+        hHeaderLabels.append("d" + name);
+    }
+
+    int rowCount = 0;
+    for(auto &r : results){
+        rowCount += qMax(1, r.size());
+    }
+
+    ui->tableWidget_Result->clear();
+    ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
+    ui->tableWidget_Result->setRowCount(rowCount);
+
+    int i = 0;
+    for(int q = 0; q < results.size(); q++){
+        if(results[q].isEmpty()){
+            // not found, or lacking some of the weighted properties
+            setCellValue(ui->tableWidget_Result, i, 0, m_queryGlasses[q]);
+            setCellValue(ui->tableWidget_Result, i, 2, m_engine.canQuery(queryRows[q]) ? "No substitute" : "Insufficient data");
+            i++;
+            continue;
+        }
+
+        for(int j = 0; j < results[q].size(); j++){
+            const GlassSubstituteEngine::Substitute& s = results[q][j];
+            setCellValue(ui->tableWidget_Result, i, 0, m_queryGlasses[q]);
+            setCellValue(ui->tableWidget_Result, i, 1, QString::number(j + 1));
+            setCellValue(ui->tableWidget_Result, i, 2, table->productName(s.row));
+            setCellValue(ui->tableWidget_Result, i, 3, table->supplier(table->catalogIndex(s.row)));
+            setCellValue(ui->tableWidget_Result, i, 4, numToQString(s.distance, 'f', 4));
+            for(int p = 0; p < s.deltas.size(); p++){
+                setCellValue(ui->tableWidget_Result, i, 5 + p, numToQString(s.deltas[p], 'g', 4));
+            }
+            i++;
+        }
+    }
+
+    ui->label_Indexed->setText(QString("Indexed glasses: %1").arg(m_engine.indexedCount()));
+}
+
+void GlassSubstituteForm::setCellValue(QTableWidget* table, int row, int col, QString str)
+{
+    QTableWidgetItem *item = table->item(row, col);
+    if(!item){
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+    }
+    item->setTextAlignment(Qt::AlignRight);
+    item->setText(str);
+}
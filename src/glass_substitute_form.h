@@ -0,0 +1,85 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_SUBSTITUTE_FORM_H
+#define GLASS_SUBSTITUTE_FORM_H
+
+#include <QWidget>
+#include <QMdiArea>
+#include <QStringList>
+#include <QTableWidget>
+
+#include "glass_substitute_engine.h"
+
+namespace Ui {
+class GlassSubstituteForm;
+}
+
+/** Form to find substitute glasses of the glasses in a lens */
+class GlassSubstituteForm : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit GlassSubstituteForm(QMdiArea *parent = nullptr);
+    ~GlassSubstituteForm();
+
+private slots:
+    /** Execute search and show result */
+    void showSearchResult();
+
+    /** Add a glass to the query list */
+    void addGlass();
+
+    /** Remove the selected glass from the query list */
+    void removeGlass();
+
+    /** Update the catalog list keeping the check states */
+    void updateCatalogList();
+
+private:
+    QVector<double> getWeights() const;
+    GlassSubstituteEngine::Filter getFilter() const;
+    void setCellValue(QTableWidget* table, int row, int col, QString str);
+
+    inline QString numToQString(double val, char fmt='f', int digit=6);
+
+    Ui::GlassSubstituteForm *ui;
+    QMdiArea*   m_parentMdiArea;
+    QStringList m_queryGlasses; // full names
+
+    GlassSubstituteEngine m_engine;
+};
+
+QString GlassSubstituteForm::numToQString(double val, char fmt, int digit)
+{
+    if(qIsNaN(val)){
+        return "-";
+    }
+    else{
+        return QString::number(val, fmt, digit);
+    }
+}
+
+#endif // GLASS_SUBSTITUTE_FORM_H
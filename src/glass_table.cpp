@@ -0,0 +1,246 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_table.h"
+
+#include <QtConcurrent>
+
+#include "glass.h"
+#include "glass_catalog.h"
+#include "spectral_line.h"
+
+namespace {
+
+// order of GlassTable::spectralLineNames()
+enum LineIndex{ Line_t, Line_s, Line_r, Line_C, Line_C_, Line_D, Line_d, Line_e, Line_F, Line_F_, Line_g, Line_h, Line_i, LineCount };
+
+const double lineWavelengths[LineCount] = {
+    SpectralLine::t, SpectralLine::s, SpectralLine::r, SpectralLine::C, SpectralLine::C_, SpectralLine::D, SpectralLine::d,
+    SpectralLine::e, SpectralLine::F, SpectralLine::F_, SpectralLine::g, SpectralLine::h, SpectralLine::i
+};
+
+}
+
+GlassTable::GlassTable()
+{
+    m_temperature = 25;
+    m_normalLineReference = NormalLine::ReferenceK7F2;
+}
+
+const QStringList& GlassTable::columnNames()
+{
+    static const QStringList names({"nd", "ne", "vd", "ve", "PgF", "PCt_", "PgF_", "dPgF", "dPCt_", "dPgF_", "eta1", "eta2",
+                                    "dn/dT", "Low TCE", "High TCE", "Relative Cost",
+                                    "Climate Resist", "Stain Resist", "Acid Resist", "Alkali Resist", "Phosphate Resist",
+                                    "Lambda Min", "Lambda Max", "Ti 400nm"});
+    Q_ASSERT(names.size() == ColumnCount);
+    return names;
+}
+
+int GlassTable::columnIndex(const QString &name)
+{
+    return columnNames().indexOf(name);
+}
+
+const QStringList& GlassTable::spectralLineNames()
+{
+    static const QStringList names({"t", "s", "r", "C", "C_", "D", "d", "e", "F", "F_", "g", "h", "i"});
+    Q_ASSERT(names.size() == LineCount);
+    return names;
+}
+
+int GlassTable::spectralLineIndex(const QString &name)
+{
+    return spectralLineNames().indexOf(name);
+}
+
+const QVector<double>* GlassTable::column(const QString &name) const
+{
+    int c = columnIndex(name);
+    if(c < 0){
+        return nullptr;
+    }
+    return &m_columns[c];
+}
+
+int GlassTable::findRow(const QString &fullName) const
+{
+    return m_rowMap.value(fullName, -1);
+}
+
+GlassTable::Status GlassTable::statusFromString(const QString &status)
+{
+    if("Preferred" == status){
+        return StatusPreferred;
+    }
+    else if("Obsolete" == status){
+        return StatusObsolete;
+    }
+    else if("Special" == status){
+        return StatusSpecial;
+    }
+    else if("Melt" == status){
+        return StatusMelt;
+    }
+    else{
+        return StatusNone;
+    }
+}
+
+QSharedPointer<const GlassTable> GlassTable::build(const QList<const GlassCatalog *> &catalogs, double temperature, NormalLine::Reference normalLineReference)
+{
+    QSharedPointer<GlassTable> table(new GlassTable);
+    table->m_temperature = temperature;
+
+    // row layout
+    int rowCount = 0;
+    for(auto &cat : catalogs){
+        rowCount += cat->glassCount();
+    }
+
+    table->m_glasses.reserve(rowCount);
+    table->m_productNames.reserve(rowCount);
+    table->m_catalogIndices.reserve(rowCount);
+    table->m_glassIndices.reserve(rowCount);
+    table->m_rowMap.reserve(rowCount);
+    table->m_firstRows.reserve(catalogs.size() + 1);
+
+    for(int ci = 0; ci < catalogs.size(); ci++){
+        const GlassCatalog* cat = catalogs[ci];
+        table->m_suppliers.append(cat->supplier());
+        table->m_firstRows.append(table->m_glasses.size());
+
+        for(int gi = 0; gi < cat->glassCount(); gi++){
+            Glass* g = cat->glass(gi);
+            table->m_rowMap.insert(g->fullName(), table->m_glasses.size());
+            table->m_glasses.append(g);
+            table->m_productNames.append(g->productName());
+            table->m_catalogIndices.append(ci);
+            table->m_glassIndices.append(gi);
+        }
+    }
+    table->m_firstRows.append(rowCount);
+
+    // allocate columns.  Each array is allocated separately so that none of them is implicitly shared.
+    table->m_columns.resize(ColumnCount);
+    for(auto &col : table->m_columns){
+        col.resize(rowCount);
+    }
+    table->m_refractiveIndices.resize(LineCount);
+    for(auto &col : table->m_refractiveIndices){
+        col.resize(rowCount);
+    }
+    table->m_status.resize(rowCount);
+    table->m_valid.resize(rowCount);
+
+    // Every row is independent, so that the rows are computed in parallel.
+    // Glass::refractiveIndex() at the table temperature only reads the glass data, not the current temperature set by the GUI.
+    QVector<int> rows(rowCount);
+    for(int row = 0; row < rowCount; row++){
+        rows[row] = row;
+    }
+    if(rowCount > 0){
+        GlassTable* t = table.data();
+        QtConcurrent::blockingMap(rows, [t](int& row){ t->fillRow(row); });
+    }
+
+    // The normal lines depend on the whole columns.
+    table->updateNormalLines(normalLineReference);
+
+    return table;
+}
+
+QSharedPointer<const GlassTable> GlassTable::withNormalLineReference(NormalLine::Reference normalLineReference) const
+{
+    QSharedPointer<GlassTable> table(new GlassTable(*this));
+    table->updateNormalLines(normalLineReference);
+    return table;
+}
+
+void GlassTable::updateNormalLines(NormalLine::Reference normalLineReference)
+{
+    m_normalLineReference = normalLineReference;
+    m_normalLines = NormalLine::fit(*this, normalLineReference);
+
+    const int rowCount = this->rowCount();
+    for(int ratio = 0; ratio < NormalLine::RatioCount; ratio++){
+        const double  a0 = m_normalLines[ratio].a0;
+        const double  a1 = m_normalLines[ratio].a1;
+        const double* v  = m_columns[NormalLine::abbeColumn(ratio)].constData();
+        const double* p  = m_columns[NormalLine::partialColumn(ratio)].constData();
+        double*       d  = m_columns[NormalLine::deviationColumn(ratio)].data(); // detached from the copied table
+
+        for(int row = 0; row < rowCount; row++){
+            d[row] = p[row] - (a0 + a1*v[row]);
+        }
+    }
+}
+
+void GlassTable::fillRow(int row)
+{
+    // Elements of the detached arrays are written by one thread per row, so no lock is required.
+    const Glass* g = m_glasses[row];
+
+    double n[LineCount];
+    for(int i = 0; i < LineCount; i++){
+        n[i] = g->refractiveIndex(lineWavelengths[i]/1000.0, m_temperature);
+        m_refractiveIndices[i].data()[row] = n[i];
+    }
+
+    double* c[ColumnCount];
+    for(int i = 0; i < ColumnCount; i++){
+        c[i] = m_columns[i].data();
+    }
+
+    c[ColumnNd][row]   = n[Line_d];
+    c[ColumnNe][row]   = n[Line_e];
+    c[ColumnVd][row]   = (n[Line_d] - 1)/(n[Line_F] - n[Line_C]);
+    c[ColumnVe][row]   = (n[Line_e] - 1)/(n[Line_F_] - n[Line_C_]);
+    c[ColumnPgF][row]  = (n[Line_g] - n[Line_F])/(n[Line_F] - n[Line_C]);
+    c[ColumnPCt_][row] = (n[Line_C] - n[Line_t])/(n[Line_F_] - n[Line_C_]);
+    c[ColumnPgF_][row] = (n[Line_g] - n[Line_F_])/(n[Line_F_] - n[Line_C_]);
+    // The deviation columns are computed by updateNormalLines().
+    c[ColumnEta1][row] = g->BuchdahlDispCoef(0, m_temperature);
+    c[ColumnEta2][row] = g->BuchdahlDispCoef(1, m_temperature);
+
+    // absolute dn/dT at d-line and the table temperature
+    c[ColumnDnDt][row] = g->hasThermalData() ? g->dn_dt_abs(m_temperature, SpectralLine::d/1000.0) : NAN;
+
+    c[ColumnLowTCE][row]          = g->lowTCE();
+    c[ColumnHighTCE][row]         = g->highTCE();
+    c[ColumnRelCost][row]         = g->relCost();
+    c[ColumnClimateResist][row]   = g->climateResist();
+    c[ColumnStainResist][row]     = g->stainResist();
+    c[ColumnAcidResist][row]      = g->acidResist();
+    c[ColumnAlkaliResist][row]    = g->alkaliResist();
+    c[ColumnPhosphateResist][row] = g->phosphateResist();
+    c[ColumnLambdaMin][row]       = g->lambdaMin();
+    c[ColumnLambdaMax][row]       = g->lambdaMax();
+
+    // internal transmittance at 400nm for 10mm thickness
+    c[ColumnTi400][row] = g->hasTransmittanceAt(0.4) ? g->transmittance(0.4, 10) : NAN;
+
+    m_status.data()[row] = statusFromString(g->status());
+    m_valid.data()[row]  = ("Unknown" != g->formulaName());
+}
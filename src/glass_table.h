@@ -0,0 +1,270 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_TABLE_H
+#define GLASS_TABLE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+#include <QHash>
+#include <QSharedPointer>
+
+#include "normal_line.h"
+
+class Glass;
+class GlassCatalog;
+
+/**
+ * @brief Immutable columnar snapshot of the glass properties in all the catalogs
+ * @details Each property is stored in a contiguous array whose n-th element belongs to the n-th row (glass),
+ *          so that searches, maps and sorts can be written as tight loops over the arrays.
+ *          Rows are ordered by catalog, and the glasses of a catalog are stored in the catalog order.
+ *          The table is built for each CatalogSnapshot and is shared read-only via QSharedPointer<const GlassTable>, so it can be read from any thread.
+ *          Glass pointers stored in the table are valid while the snapshot is held.
+ */
+class GlassTable
+{
+public:
+    enum Column{
+        ColumnNd,
+        ColumnNe,
+        ColumnVd,
+        ColumnVe,
+        ColumnPgF,
+        ColumnPCt_,
+        ColumnPgF_,
+        ColumnDPgF,
+        ColumnDPCt_,
+        ColumnDPgF_,
+        ColumnEta1,
+        ColumnEta2,
+        ColumnDnDt,
+        ColumnLowTCE,
+        ColumnHighTCE,
+        ColumnRelCost,
+        ColumnClimateResist,
+        ColumnStainResist,
+        ColumnAcidResist,
+        ColumnAlkaliResist,
+        ColumnPhosphateResist,
+        ColumnLambdaMin,
+        ColumnLambdaMax,
+        ColumnTi400,
+        ColumnCount
+    };
+
+    /** Same numbers as the status field of AGF */
+    enum Status{
+        StatusNone      = 0,
+        StatusPreferred = 1,
+        StatusObsolete  = 2,
+        StatusSpecial   = 3,
+        StatusMelt      = 4
+    };
+
+    /**
+     * @brief Build a new table from the catalogs.  This can be called from any thread while the catalogs are not modified.
+     * @param catalogs catalogs
+     * @param temperature temperature at which the refractive indices are computed
+     * @param normalLineReference reference of the normal lines from which the deviations of the partial dispersions are computed
+     */
+    static QSharedPointer<const GlassTable> build(const QList<const GlassCatalog*>& catalogs, double temperature, NormalLine::Reference normalLineReference);
+
+    /** Copy of the table whose deviation columns are recomputed from the other normal lines.  The other columns are shared. */
+    QSharedPointer<const GlassTable> withNormalLineReference(NormalLine::Reference normalLineReference) const;
+
+    /** Property names of the columns, which are the same as Glass::getValue() accepts if applicable */
+    static const QStringList& columnNames();
+
+    /** Returns column index of the property, or -1 if not found */
+    static int columnIndex(const QString& name);
+
+    /** Fraunhofer lines at which the refractive indices are stored */
+    static const QStringList& spectralLineNames();
+
+    /** Returns index of the spectral line, or -1 if not found */
+    static int spectralLineIndex(const QString& name);
+
+    inline int    rowCount() const;
+    inline double temperature() const;
+
+    inline NormalLine::Reference              normalLineReference() const;
+    inline const NormalLine::Coefficients&    normalLine(int ratio) const;
+
+    inline const QVector<double>& column(int column) const;
+    inline double value(int column, int row) const;
+
+    /** Returns column by name, or nullptr if not found */
+    const QVector<double>* column(const QString& name) const;
+
+    /** Refractive indices at the spectral line */
+    inline const QVector<double>& refractiveIndices(int lineIndex) const;
+
+    inline const QVector<quint8>& statusColumn() const;
+    inline const QVector<int>&    catalogColumn() const;
+
+    /** False if the dispersion formula of the glass is unknown */
+    inline bool isValid(int row) const;
+
+    inline int catalogCount() const;
+    inline int catalogIndex(int row) const;
+    inline int glassIndex(int row) const;
+    inline int firstRow(int catalogIndex) const;
+    inline int rowCount(int catalogIndex) const;
+
+    inline const QString& supplier(int catalogIndex) const;
+    inline const QString& productName(int row) const;
+    inline QString fullName(int row) const;
+    inline Glass* glass(int row) const;
+
+    /** Returns row of the glass, or -1 if not found */
+    int findRow(const QString& fullName) const;
+
+    static Status statusFromString(const QString& status);
+
+private:
+    GlassTable();
+
+    void fillRow(int row);
+
+    /** Fit the normal lines and compute the deviation columns */
+    void updateNormalLines(NormalLine::Reference normalLineReference);
+
+    double m_temperature;
+
+    NormalLine::Reference               m_normalLineReference;
+    QVector<NormalLine::Coefficients>   m_normalLines;
+
+    QVector<QVector<double>> m_columns;
+    QVector<QVector<double>> m_refractiveIndices;
+    QVector<quint8>          m_status;
+    QVector<bool>            m_valid;
+    QVector<int>             m_catalogIndices;
+    QVector<int>             m_glassIndices;
+    QVector<int>             m_firstRows; // size = catalog count + 1
+    QStringList              m_suppliers;
+    QVector<QString>         m_productNames;
+    QVector<Glass*>          m_glasses;
+    QHash<QString, int>      m_rowMap;
+};
+
+
+int GlassTable::rowCount() const
+{
+    return m_glasses.size();
+}
+
+double GlassTable::temperature() const
+{
+    return m_temperature;
+}
+
+NormalLine::Reference GlassTable::normalLineReference() const
+{
+    return m_normalLineReference;
+}
+
+const NormalLine::Coefficients& GlassTable::normalLine(int ratio) const
+{
+    return m_normalLines[ratio];
+}
+
+const QVector<double>& GlassTable::column(int column) const
+{
+    return m_columns[column];
+}
+
+double GlassTable::value(int column, int row) const
+{
+    return m_columns[column][row];
+}
+
+const QVector<double>& GlassTable::refractiveIndices(int lineIndex) const
+{
+    return m_refractiveIndices[lineIndex];
+}
+
+const QVector<quint8>& GlassTable::statusColumn() const
+{
+    return m_status;
+}
+
+const QVector<int>& GlassTable::catalogColumn() const
+{
+    return m_catalogIndices;
+}
+
+bool GlassTable::isValid(int row) const
+{
+    return m_valid[row];
+}
+
+int GlassTable::catalogCount() const
+{
+    return m_suppliers.size();
+}
+
+int GlassTable::catalogIndex(int row) const
+{
+    return m_catalogIndices[row];
+}
+
+int GlassTable::glassIndex(int row) const
+{
+    return m_glassIndices[row];
+}
+
+int GlassTable::firstRow(int catalogIndex) const
+{
+    return m_firstRows[catalogIndex];
+}
+
+int GlassTable::rowCount(int catalogIndex) const
+{
+    return m_firstRows[catalogIndex + 1] - m_firstRows[catalogIndex];
+}
+
+const QString& GlassTable::supplier(int catalogIndex) const
+{
+    return m_suppliers[catalogIndex];
+}
+
+const QString& GlassTable::productName(int row) const
+{
+    return m_productNames[row];
+}
+
+QString GlassTable::fullName(int row) const
+{
+    return m_productNames[row] + "_" + m_suppliers[m_catalogIndices[row]];
+}
+
+Glass* GlassTable::glass(int row) const
+{
+    return m_glasses[row];
+}
+
+#endif // GLASS_TABLE_H
@@ -25,6 +25,9 @@
 #include "glassmap_form.h"
 #include "ui_glassmap_form.h"
 
+#include <QToolTip>
+#include <algorithm>
+
 #include "glass_catalog_manager.h"
 #include "glass_datasheet_form.h"
 #include "curve_fitting_dialog.h"
@@ -42,22 +45,33 @@ GlassMapForm::GlassMapForm(QString xdataname, QString ydataname, QCPRange xrange
 {
     ui->setupUi(this);
 
+    m_overlayGraph = nullptr;
+    m_curveGraph   = nullptr;
+    m_lassoCurve   = nullptr;
+
     // plot widget
     m_customPlot = ui->widget;
     m_customPlot->setInteraction(QCP::iRangeDrag, true);
     m_customPlot->setInteraction(QCP::iRangeZoom, true);
-    m_customPlot->setInteraction(QCP::iSelectItems, true);
+    m_customPlot->setMouseTracking(true); // hover tooltip
     m_customPlot->axisRect()->insetLayout()->setInsetAlignment(0, Qt::AlignLeft|Qt::AlignTop);
     m_customPlot->setContextMenuPolicy(Qt::CustomContextMenu);
     m_customPlot->legend->setVisible(true);
 
+    // Layers
+    // The glassmaps are cached in their own buffer. The user curve and the overlay on "main" and the legend are redrawn without repainting every glass.
+    m_customPlot->addLayer("glassmaps", m_customPlot->layer("main"), QCustomPlot::limBelow);
+    m_customPlot->layer("glassmaps")->setMode(QCPLayer::lmBuffered);
+    m_customPlot->layer("main")->setMode(QCPLayer::lmBuffered);
+    m_customPlot->layer("legend")->setMode(QCPLayer::lmBuffered);
+
     // user defined curve control
     m_checkBoxCurve = ui->checkBox_Curve;
-    QObject::connect(ui->checkBox_Curve,SIGNAL(toggled(bool)), this, SLOT(update()));
+    QObject::connect(ui->checkBox_Curve,SIGNAL(toggled(bool)), this, SLOT(updateCurve()));
 
     m_lineEditList = QList<QLineEdit*>() << ui->lineEdit_C0 << ui->lineEdit_C1 << ui->lineEdit_C2 << ui->lineEdit_C3;
     for(int i = 0; i < m_lineEditList.size(); i++){
-        QObject::connect(m_lineEditList[i],SIGNAL(textEdited(QString)),this, SLOT(update()));
+        QObject::connect(m_lineEditList[i],SIGNAL(textEdited(QString)),this, SLOT(updateCurve()));
     }
 
 
@@ -92,8 +106,8 @@ GlassMapForm::GlassMapForm(QString xdataname, QString ydataname, QCPRange xrange
     m_settings->setIniCodec(QTextCodec::codecForName("UTF-8"));
 
     // mouse
-    QObject::connect(m_customPlot, SIGNAL(itemClick(QCPAbstractItem*,QMouseEvent*)), this, SLOT(showNeighbors(QCPAbstractItem*)));
-    QObject::connect(m_customPlot,SIGNAL(mousePress(QMouseEvent*)),this, SLOT(clearNeighbors()));
+    // Click selects the nearest glass, Ctrl+drag selects the glasses in the rectangle and Shift+drag those in the lasso.
+    QObject::connect(m_customPlot->selectionRect(), SIGNAL(accepted(QRect,QMouseEvent*)), this, SLOT(selectRectangle(QRect,QMouseEvent*)));
 
     // context menu
     m_customPlot->setContextMenuPolicy(Qt::CustomContextMenu);
@@ -108,6 +122,15 @@ GlassMapForm::GlassMapForm(QString xdataname, QString ydataname, QCPRange xrange
     // preset
     QObject::connect(ui->pushButton_Preset, SIGNAL(clicked()), this, SLOT(showPresetDlg()));
 
+    // catalog files modified on disk
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(glassesAdded(int,QStringList)),   this, SLOT(updateCatalog(int)));
+        QObject::connect(manager, SIGNAL(glassesRemoved(int,QStringList)), this, SLOT(updateCatalog(int)));
+        QObject::connect(manager, SIGNAL(glassesChanged(int,QStringList)), this, SLOT(updateCatalog(int)));
+        QObject::connect(manager, SIGNAL(tableUpdated()),                  this, SLOT(onTableUpdated()));
+    }
+
     // window title
     this->setWindowTitle( xdataname + " - " + ydataname + " Plot");
 
@@ -126,6 +149,7 @@ GlassMapForm::~GlassMapForm()
     }
     m_settings = nullptr;
 
+    deleteGlassmaps();
     m_customPlot->clearGraphs();
     m_customPlot->clearPlottables();
     m_customPlot->clearItems();
@@ -220,14 +244,14 @@ void GlassMapForm::setUpScrollArea()
         checkBox1->setObjectName("chkPlot_"+QString::number(i));
         checkBox1->setText("P"); // point
         gridLayout->addWidget(checkBox1, i, 1, 1, 1);
-        QObject::connect(checkBox1,SIGNAL(toggled(bool)), this, SLOT(update()));
+        QObject::connect(checkBox1,SIGNAL(toggled(bool)), this, SLOT(updateVisibility()));
 
         // label on/off
         checkBox2 = new QCheckBox(ui->scrollAreaWidgetContents);
         checkBox2->setObjectName("chkLabel_"+QString::number(i));
         checkBox2->setText("T"); // text label
         gridLayout->addWidget(checkBox2, i, 2, 1, 1);
-        QObject::connect(checkBox2,SIGNAL(toggled(bool)), this, SLOT(update()));
+        QObject::connect(checkBox2,SIGNAL(toggled(bool)), this, SLOT(updateVisibility()));
 
         m_glassMapCtrlList.append( GlassMapCtrl(label, checkBox1, checkBox2) );
     }
@@ -241,42 +265,175 @@ void GlassMapForm::setLegendVisible()
     m_customPlot->replot();
 }
 
-void GlassMapForm::showNeighbors(QCPAbstractItem* item)
+void GlassMapForm::showNeighbors(int targetRow)
 {
-    if(m_customPlot->selectedItems().isEmpty()){
+    if(!m_table || targetRow < 0){
         return;
     }
 
-    // mouse-selected glass
-    QString glassName = item->objectName();
-    Glass* targetGlass = GlassCatalogManager::find(glassName);
+    const QVector<double>* xColumn = m_xColumn.data();
+    const QVector<double>* yColumn = m_yColumn.data();
+    if(!xColumn || !yColumn){
+        return;
+    }
 
     double xThreshold = (m_customPlot->xAxis->range().upper - m_customPlot->xAxis->range().lower)/10;
     double yThreshold = (m_customPlot->yAxis->range().upper - m_customPlot->yAxis->range().lower)/10;
 
-    for(int i = 0; i < GlassCatalogManager::catalogList().size(); i++){
+    const double xt = xColumn->at(targetRow);
+    const double yt = yColumn->at(targetRow);
+
+    QVector<int> rows = m_kdTree.rectangle(xt - xThreshold, xt + xThreshold, yt - yThreshold, yt + yThreshold);
+    std::sort(rows.begin(), rows.end());
 
+    for(int row : rows){
         // Glasses in currently visible catalogs will be listed.
-        if(m_glassMapCtrlList[i].checkBoxPlot->checkState())
-        {
-            GlassCatalog* cat = GlassCatalogManager::catalogList().at(i);
-            for(int j = 0; j < cat->glassCount(); j++)
-            {
-                Glass* g = cat->glass(j);
+        if(m_glassMapCtrlList[m_table->catalogIndex(row)].checkBoxPlot->checkState()){
+            m_listWidgetNeighbors->addItem(m_table->fullName(row));
+        }
+    }
 
-                double dx = (targetGlass->getValue(m_xDataName) - g->getValue(m_xDataName));
-                double dy = (targetGlass->getValue(m_yDataName) - g->getValue(m_yDataName));
+    m_listWidgetNeighbors->update();
+}
 
-                if(fabs(dx) < xThreshold && fabs(dy) < yThreshold){
-                    m_listWidgetNeighbors->addItem(g->fullName());
-                }
-            }
+void GlassMapForm::setOverlay(const QString &name, const QStringList &fullNames)
+{
+    m_overlayName    = name;
+    m_overlayGlasses = fullNames;
+
+    createOverlay();
+    updateLegend();
+    m_customPlot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void GlassMapForm::createOverlay()
+{
+    if(m_overlayGraph){
+        m_customPlot->removeGraph(m_overlayGraph);
+        m_overlayGraph = nullptr;
+    }
+
+    if(!m_table || m_overlayGlasses.isEmpty()){
+        return;
+    }
+
+    const QVector<double>* xColumn = m_xColumn.data();
+    const QVector<double>* yColumn = m_yColumn.data();
+    if(!xColumn || !yColumn){
+        return;
+    }
+
+    // Glasses are looked up by name since the overlay is kept across catalog updates.
+    QVector<double> x, y;
+    for(auto &name : m_overlayGlasses){
+        int row = m_table->findRow(name);
+        if(row >= 0 && m_table->isValid(row)){
+            x.append(xColumn->at(row));
+            y.append(yColumn->at(row));
         }
     }
 
+    m_overlayGraph = m_customPlot->addGraph();
+    m_overlayGraph->setData(x, y);
+    m_overlayGraph->setName(m_overlayName);
+    m_overlayGraph->setLineStyle(QCPGraph::lsNone);
+    m_overlayGraph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, QPen(Qt::red, 2), Qt::NoBrush, 12));
+}
+
+void GlassMapForm::selectRectangle(const QRect &rect, QMouseEvent *event)
+{
+    Q_UNUSED(event)
+
+    m_customPlot->setSelectionRectMode(QCP::srmNone);
+    clearNeighbors();
+
+    if(!m_table){
+        return;
+    }
+
+    double x1 = m_customPlot->xAxis->pixelToCoord(rect.left());
+    double x2 = m_customPlot->xAxis->pixelToCoord(rect.right());
+    double y1 = m_customPlot->yAxis->pixelToCoord(rect.top());
+    double y2 = m_customPlot->yAxis->pixelToCoord(rect.bottom());
+
+    QVector<int> rows = m_kdTree.rectangle(x1, x2, y1, y2);
+    std::sort(rows.begin(), rows.end());
+
+    for(int row : rows){
+        m_listWidgetNeighbors->addItem(m_table->fullName(row));
+    }
+    m_listWidgetNeighbors->update();
+}
+
+void GlassMapForm::selectLasso()
+{
+    clearNeighbors();
+
+    if(!m_table){
+        return;
+    }
+
+    QVector<int> rows = m_kdTree.polygon(m_lasso);
+    std::sort(rows.begin(), rows.end());
+
+    for(int row : rows){
+        m_listWidgetNeighbors->addItem(m_table->fullName(row));
+    }
     m_listWidgetNeighbors->update();
 }
 
+int GlassMapForm::glassAt(const QPoint &pos) const
+{
+    constexpr double hitRadius = 8.0; // pixel
+
+    // pixels per unit of each axis
+    double sx = m_customPlot->xAxis->coordToPixel(1.0) - m_customPlot->xAxis->coordToPixel(0.0);
+    double sy = m_customPlot->yAxis->coordToPixel(1.0) - m_customPlot->yAxis->coordToPixel(0.0);
+
+    double x = m_customPlot->xAxis->pixelToCoord(pos.x());
+    double y = m_customPlot->yAxis->pixelToCoord(pos.y());
+
+    return m_kdTree.nearest(x, y, sx, sy, hitRadius);
+}
+
+void GlassMapForm::updateColumns()
+{
+    // The coordinates are shared by all the glassmap windows through the manager, and computed once per snapshot.
+    std::shared_ptr<const CatalogSnapshot> snapshot = GlassCatalogManager::snapshot();
+    m_table   = snapshot->table();
+    m_xColumn = GlassCatalogManager::derivedColumn(snapshot, m_xDataName);
+    m_yColumn = GlassCatalogManager::derivedColumn(snapshot, m_yDataName);
+}
+
+void GlassMapForm::rebuildIndex()
+{
+    const QVector<double>* xColumn = m_xColumn.data();
+    const QVector<double>* yColumn = m_yColumn.data();
+    if(!xColumn || !yColumn){
+        m_kdTree.clear();
+        return;
+    }
+
+    QVector<KdTree2D::Point> points;
+    points.reserve(m_table->rowCount());
+
+    for(int i = 0; i < m_table->catalogCount() && i < m_glassMapCtrlList.size(); i++){
+        if(!m_glassMapCtrlList[i].checkBoxPlot->checkState() && !m_glassMapCtrlList[i].checkBoxLabel->checkState()){
+            continue;
+        }
+
+        int rowBegin = m_table->firstRow(i);
+        int rowEnd   = rowBegin + m_table->rowCount(i);
+        for(int row = rowBegin; row < rowEnd; row++){
+            if(m_table->isValid(row)){
+                points.append(KdTree2D::Point{xColumn->at(row), yColumn->at(row), row});
+            }
+        }
+    }
+
+    m_kdTree.build(points);
+}
+
 void GlassMapForm::clearNeighbors()
 {
     m_listWidgetNeighbors->clear();
@@ -314,7 +471,7 @@ void GlassMapForm::showCurveFittingDlg()
             for(int i = 0; i < m_lineEditList.size(); i++){
                 m_lineEditList[i]->setText(QString::number(coefs[i]));
             }
-            this->update();
+            updateCurve();
         }
         else{
             QMessageBox::warning(this,tr("File"), tr("Fitting calculation failed"));
@@ -342,36 +499,165 @@ void GlassMapForm::setDefault()
 void GlassMapForm::update()
 {
     // delete all graphs and items
+    deleteGlassmaps();
     m_customPlot->clearGraphs();
     m_customPlot->clearItems();
     m_customPlot->clearPlottables();
+    m_overlayGraph = nullptr;
+    m_curveGraph   = nullptr;
+    m_lassoCurve   = nullptr;
+    m_lasso.clear();
 
-    int catalogCount = GlassCatalogManager::catalogList().size();
-    QCPScatterChart* glassmap;
-    bool plot_on, label_on;
+    updateColumns();
 
     // replot all glassmaps
+    // Catalogs added after this form was created have no controls and are not plotted.
+    int catalogCount = qMin(GlassCatalogManager::catalogList().size(), m_glassMapCtrlList.size());
     for(int i = 0; i < catalogCount; i++)
     {
-        plot_on  = m_glassMapCtrlList[i].checkBoxPlot->checkState();
-        label_on = m_glassMapCtrlList[i].checkBoxLabel->checkState();
-
-        if(plot_on || label_on){
-            glassmap = new QCPScatterChart(m_customPlot);
-            setGlassmapData(glassmap, GlassCatalogManager::catalogList().at(i), m_xDataName, m_yDataName, getColorFromIndex(i,catalogCount));
-            glassmap->setVisiblePointSeries(plot_on);
-            glassmap->setVisibleTextLabels(label_on);
+        m_glassMapList.append(nullptr);
+        createGlassmap(i);
+    }
+
+    rebuildIndex();
+
+    createCurve();
+    createOverlay();
+    updateLegend();
+
+    m_customPlot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void GlassMapForm::updateCurve()
+{
+    // The glassmaps are kept as they are while the coefficients are edited.
+    const bool curveShown = (m_curveGraph != nullptr);
+    createCurve();
+
+    if(curveShown == (m_curveGraph != nullptr)){
+        // Only the points of the curve were changed.
+        m_customPlot->layer("main")->replot();
+    }else{
+        updateLegend();
+        m_customPlot->replot(QCustomPlot::rpQueuedReplot);
+    }
+}
+
+void GlassMapForm::createCurve()
+{
+    if(!m_checkBoxCurve->checkState()){
+        if(m_curveGraph){
+            m_customPlot->removeGraph(m_curveGraph);
+            m_curveGraph = nullptr;
         }
+        return;
     }
 
-    // replot user defined curve
-    if(m_checkBoxCurve->checkState()){
-        QCPGraph* curveGraph = m_customPlot->addGraph();
-        setCurveData(curveGraph, getCurveCoefs());
-        curveGraph->setVisible(true);
+    if(!m_curveGraph){
+        m_curveGraph = m_customPlot->addGraph();
     }
+    setCurveData(m_curveGraph, getCurveCoefs());
+}
 
-    m_customPlot->replot();
+void GlassMapForm::updateLegend()
+{
+    // The legend is rebuilt in the catalog order, whatever order the plottables were created in.
+    m_customPlot->legend->clearItems();
+
+    for(int i = 0; i < m_glassMapList.size(); i++){
+        if(m_glassMapList[i] && (m_glassMapCtrlList[i].checkBoxPlot->checkState() || m_glassMapCtrlList[i].checkBoxLabel->checkState())){
+            m_glassMapList[i]->graphPoints()->addToLegend();
+        }
+    }
+    if(m_curveGraph){
+        m_curveGraph->addToLegend();
+    }
+    if(m_overlayGraph){
+        m_overlayGraph->addToLegend();
+    }
+}
+
+void GlassMapForm::updateCatalog(int catalogIndex)
+{
+    if(catalogIndex >= m_glassMapList.size()){
+        return;
+    }
+
+    // Only the glassmap of the modified catalog is recreated.
+    updateColumns();
+    delete m_glassMapList[catalogIndex];
+    m_glassMapList[catalogIndex] = nullptr;
+    createGlassmap(catalogIndex);
+    rebuildIndex();
+    createOverlay();
+    updateLegend();
+
+    clearNeighbors();
+    m_customPlot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void GlassMapForm::updateVisibility()
+{
+    if(m_glassMapList.isEmpty()){
+        update();
+        return;
+    }
+
+    // The glassmaps once created are kept, and are only shown or hidden.
+    updateColumns();
+    bool created = false;
+    for(int i = 0; i < m_glassMapList.size(); i++){
+        if(m_glassMapList[i]){
+            m_glassMapList[i]->setVisiblePointSeries(m_glassMapCtrlList[i].checkBoxPlot->checkState());
+            m_glassMapList[i]->setVisibleTextLabels(m_glassMapCtrlList[i].checkBoxLabel->checkState());
+        }else{
+            createGlassmap(i);
+            created = created || m_glassMapList[i];
+        }
+    }
+
+    // Bring the overlay back to the front of a new glassmap.
+    if(created){
+        createOverlay();
+    }
+
+    rebuildIndex();
+    updateLegend();
+    m_customPlot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void GlassMapForm::onTableUpdated()
+{
+    // Modified glasses are replotted by updateCatalog().
+    QSharedPointer<const GlassTable> table = GlassCatalogManager::table();
+    if(m_table && (table->temperature() != m_table->temperature() || table->normalLineReference() != m_table->normalLineReference())){
+        update();
+    }
+}
+
+void GlassMapForm::createGlassmap(int catalogIndex)
+{
+    bool plot_on  = m_glassMapCtrlList[catalogIndex].checkBoxPlot->checkState();
+    bool label_on = m_glassMapCtrlList[catalogIndex].checkBoxLabel->checkState();
+
+    if(plot_on || label_on){
+        int catalogCount = GlassCatalogManager::catalogList().size();
+        QCPScatterChart* glassmap = new QCPScatterChart(m_customPlot);
+        glassmap->setLayer("glassmaps");
+        setGlassmapData(glassmap, catalogIndex, getColorFromIndex(catalogIndex, catalogCount));
+        glassmap->setVisiblePointSeries(plot_on);
+        glassmap->setVisibleTextLabels(label_on);
+        m_glassMapList[catalogIndex] = glassmap;
+    }
+}
+
+void GlassMapForm::deleteGlassmaps()
+{
+    for(auto &glassmap : m_glassMapList){
+        delete glassmap; // plottable and items are also removed from the plot
+        glassmap = nullptr;
+    }
+    m_glassMapList.clear();
 }
 
 void GlassMapForm::showPresetDlg()
@@ -380,7 +666,7 @@ void GlassMapForm::showPresetDlg()
 
     if(dlg->exec() == QDialog::Accepted){
         setCurveCoefsToUI(dlg->getCoefs());
-        update();
+        updateCurve();
     }
 
     delete dlg;
@@ -388,33 +674,37 @@ void GlassMapForm::showPresetDlg()
 }
 
 
-void GlassMapForm::setGlassmapData(QCPScatterChart* glassmap,GlassCatalog* catalog, QString xlabel, QString ylabel, QColor color)
+void GlassMapForm::setGlassmapData(QCPScatterChart* glassmap, int catalogIndex, QColor color)
 {
-    int glassCount = catalog->glassCount();
+    const QVector<double>* xColumn = m_xColumn.data();
+    const QVector<double>* yColumn = m_yColumn.data();
+    if(!m_table || !xColumn || !yColumn){
+        return;
+    }
+    const GlassTable& table = *m_table;
+
+    int glassCount = table.rowCount(catalogIndex);
+    int rowBegin   = table.firstRow(catalogIndex);
 
     QVector<double> x, y;
-    QVector<QString> labels, obj_names;
+    QVector<QString> labels;
     x.reserve(glassCount);
     y.reserve(glassCount);
     labels.reserve(glassCount);
-    obj_names.reserve(glassCount);
 
-    Glass* g;
-
-    for(int i = 0; i < glassCount; i++)
+    for(int row = rowBegin; row < rowBegin + glassCount; row++)
     {
-        g = catalog->glass(i);
-        if("Unknown" == g->formulaName()){
+        if(!table.isValid(row)){
             continue;
         }else{
-            x.append(g->getValue(xlabel));
-            y.append(g->getValue(ylabel));
-            labels.append(g->fullName());
+            x.append(xColumn->at(row));
+            y.append(yColumn->at(row));
+            labels.append(table.fullName(row));
         }
     }
 
     glassmap->setData(x, y, labels);
-    glassmap->setName(catalog->supplier());
+    glassmap->setName(table.supplier(catalogIndex));
     glassmap->setColor(color);
 }
 
@@ -484,7 +774,31 @@ void GlassMapForm::mouseMoveSignal(QMouseEvent *event)
                            (event->pos().y()-m_customPlot->axisRect()->top())/(double)m_customPlot->axisRect()->height());
         rect.moveTopLeft(mousePoint-m_dragLegendOrigin);
         m_customPlot->axisRect()->insetLayout()->setInsetRect(0, rect);
-        m_customPlot->replot();
+
+        // Layer replot does not lay out the elements.
+        m_customPlot->axisRect()->insetLayout()->update(QCPLayoutElement::upLayout);
+        m_customPlot->legend->layer()->replot();
+    }
+    else if(m_lassoCurve)
+    {
+        double x = m_customPlot->xAxis->pixelToCoord(event->pos().x());
+        double y = m_customPlot->yAxis->pixelToCoord(event->pos().y());
+        m_lasso.append(QPointF(x, y));
+        m_lassoCurve->addData(x, y);
+        m_lassoCurve->layer()->replot();
+    }
+    else if(event->buttons() == Qt::NoButton)
+    {
+        // tooltip of the glass under the cursor
+        int row = glassAt(event->pos());
+        if(row >= 0){
+            QString text = m_table->fullName(row) + "\n"
+                         + m_xDataName + ": " + QString::number(m_xColumn->at(row)) + "\n"
+                         + m_yDataName + ": " + QString::number(m_yColumn->at(row));
+            QToolTip::showText(event->globalPos(), text, m_customPlot);
+        }else{
+            QToolTip::hideText();
+        }
     }
 }
 
@@ -500,8 +814,32 @@ void GlassMapForm::mousePressSignal(QMouseEvent *event)
                            (event->pos().y()-m_customPlot->axisRect()->top())/(double)m_customPlot->axisRect()->height());
         m_dragLegendOrigin = mousePoint-m_customPlot->axisRect()->insetLayout()->insetRect(0).topLeft();
     }
+    else if(event->modifiers() & Qt::ControlModifier){
+        // rectangle selection, finished in selectRectangle()
+        m_customPlot->setSelectionRectMode(QCP::srmCustom);
+    }
+    else if(event->modifiers() & Qt::ShiftModifier){
+        // lasso selection, finished in mouseReleaseSignal()
+        m_customPlot->setInteraction(QCP::iRangeDrag, false);
+        m_customPlot->setSelectionRectMode(QCP::srmNone);
+
+        double x = m_customPlot->xAxis->pixelToCoord(event->pos().x());
+        double y = m_customPlot->yAxis->pixelToCoord(event->pos().y());
+        m_lasso.clear();
+        m_lasso.append(QPointF(x, y));
+
+        m_lassoCurve = new QCPCurve(m_customPlot->xAxis, m_customPlot->yAxis);
+        m_lassoCurve->setPen(QPen(Qt::gray, 1, Qt::DashLine));
+        m_lassoCurve->removeFromLegend();
+        m_lassoCurve->setSelectable(QCP::stNone);
+        m_lassoCurve->addData(x, y);
+    }
     else{
         m_customPlot->setInteraction(QCP::iRangeDrag, true);
+        m_customPlot->setSelectionRectMode(QCP::srmNone);
+
+        clearNeighbors();
+        showNeighbors(glassAt(event->pos()));
     }
 }
 
@@ -509,6 +847,15 @@ void GlassMapForm::mouseReleaseSignal(QMouseEvent *event)
 {
     Q_UNUSED(event)
     m_draggingLegend = false;
+
+    if(m_lassoCurve){
+        selectLasso();
+
+        m_customPlot->removePlottable(m_lassoCurve);
+        m_lassoCurve = nullptr;
+        m_lasso.clear();
+        m_customPlot->replot(QCustomPlot::rpQueuedReplot);
+    }
 }
 
 void GlassMapForm::beforeReplot()
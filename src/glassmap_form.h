@@ -28,6 +28,9 @@
 #include <QWidget>
 #include "qcpscatterchart.h"
 #include "glass_catalog.h"
+#include "glass_table.h"
+#include "derived_column_cache.h"
+#include "kd_tree_2d.h"
 
 
 namespace Ui {
@@ -42,13 +45,31 @@ public:
     explicit GlassMapForm(QString xdataname, QString ydataname, QCPRange xrange, QCPRange yrange, bool xreversed = true, QMdiArea *parent = nullptr);
     ~GlassMapForm();
 
+    /**
+     * @brief Highlight the glasses over the glassmaps
+     * @param name legend name of the overlay
+     * @param fullNames full names of the glasses, empty to clear the overlay
+     */
+    void setOverlay(const QString& name, const QStringList& fullNames);
+
 private slots:
     void setLegendVisible();
     void showCurveFittingDlg();
-    void showNeighbors(QCPAbstractItem* item);
+    void selectRectangle(const QRect& rect, QMouseEvent* event);
     void clearNeighbors();
     void showGlassDataSheet();
     void update();
+    void updateCatalog(int catalogIndex);
+
+    /** Show or hide the points and the labels without recreating the glassmaps */
+    void updateVisibility();
+
+    /** Regenerate only the user defined curve */
+    void updateCurve();
+
+    /** Replot if the properties were recomputed at another temperature or from other normal lines */
+    void onTableUpdated();
+
     void setDefault();
     void showPresetDlg();
     void showContextMenu();
@@ -76,9 +97,24 @@ private:
     QListWidget* m_listWidgetNeighbors;
 
     QList<GlassMapCtrl>  m_glassMapCtrlList;
+    QList<QCPScatterChart*> m_glassMapList; // chart for each catalog, nullptr if not plotted yet
     QList<QLineEdit*>    m_lineEditList;
     QList<QGridLayout*>  m_gridLayoutList;
 
+    QSharedPointer<const GlassTable> m_table; // table from which the glassmaps were created
+    DerivedColumnCache::Column m_xColumn; // coordinates of each row of the table, null if the property is invalid
+    DerivedColumnCache::Column m_yColumn;
+    KdTree2D m_kdTree; // points of the visible catalogs, whose ids are rows of the table
+
+    QString     m_overlayName;
+    QStringList m_overlayGlasses;
+    QCPGraph*   m_overlayGraph;
+
+    QCPGraph*   m_curveGraph; // user defined curve, nullptr if hidden
+
+    QPolygonF   m_lasso;      // vertices of the lasso being drawn, in plot coordinates
+    QCPCurve*   m_lassoCurve; // outline of the lasso, nullptr if not drawing
+
     QSettings* m_settings;
     QString    m_settingFile;
 
@@ -93,7 +129,17 @@ private:
     bool m_draggingLegend;
     QPointF m_dragLegendOrigin;
 
-    void   setGlassmapData(QCPScatterChart* glassmap, GlassCatalog* catalog, QString xlabel, QString ylabel, QColor color);
+    void   setGlassmapData(QCPScatterChart* glassmap, int catalogIndex, QColor color);
+    void   createGlassmap(int catalogIndex);
+    void   deleteGlassmaps();
+    void   updateColumns();
+    void   rebuildIndex();
+    void   createOverlay();
+    void   createCurve();
+    void   updateLegend();
+    int    glassAt(const QPoint& pos) const;
+    void   showNeighbors(int targetRow);
+    void   selectLasso();
     void   setUpScrollArea();
     void   saveSetting();
     QList<double> getCurveCoefs();
@@ -67,6 +67,16 @@ double GlobalSettingsIO::temperature() const
     return m_temperature;
 }
 
+int GlobalSettingsIO::normalLineReference() const
+{
+    return m_normalLineReference;
+}
+
+bool GlobalSettingsIO::doWatchFiles() const
+{
+    return m_doWatchFiles;
+}
+
 void GlobalSettingsIO::setNumFiles(int n)
 {
     m_numFiles = n;
@@ -87,6 +97,16 @@ void GlobalSettingsIO::setTemperature(double t)
     m_temperature = t;
 }
 
+void GlobalSettingsIO::setNormalLineReference(int reference)
+{
+    m_normalLineReference = reference;
+}
+
+void GlobalSettingsIO::setDoWatchFiles(bool status)
+{
+    m_doWatchFiles = status;
+}
+
 void GlobalSettingsIO::loadIniFile()
 {
     m_settings->beginGroup("Preference");
@@ -102,6 +122,8 @@ void GlobalSettingsIO::loadIniFile()
 
     m_doShowResult = m_settings->value("ShowResult", false).toBool();
     m_temperature = m_settings->value("Temperature", 25).toDouble();
+    m_normalLineReference = m_settings->value("NormalLineReference", 0).toInt();
+    m_doWatchFiles = m_settings->value("WatchFiles", false).toBool();
 
     m_settings->endGroup();
 }
@@ -119,6 +141,8 @@ void GlobalSettingsIO::saveIniFile()
 
     m_settings->setValue("ShowResult", m_doShowResult);
     m_settings->setValue("Temperature", m_temperature);
+    m_settings->setValue("NormalLineReference", m_normalLineReference);
+    m_settings->setValue("WatchFiles", m_doWatchFiles);
 
     m_settings->endGroup();
     m_settings->sync();
@@ -43,11 +43,15 @@ public:
     QStringList defaultFilePaths() const;
     bool doShowResult() const;
     double temperature() const;
+    int normalLineReference() const;
+    bool doWatchFiles() const;
 
     void setNumFiles(int n);
     void setDefaultFilePaths(QStringList filepaths);
     void setDoShowResult(bool status);
     void setTemperature(double t);
+    void setNormalLineReference(int reference);
+    void setDoWatchFiles(bool status);
 
 private:
     QString iniFilePath;
@@ -58,6 +62,8 @@ private:
     QStringList m_defaultFilePaths;
     bool m_doShowResult;
     double m_temperature;
+    int m_normalLineReference;
+    bool m_doWatchFiles;
 };
 
 
@@ -0,0 +1,243 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "kd_tree_2d.h"
+
+#include <algorithm>
+
+KdTree2D::KdTree2D()
+{
+    m_xmin = m_xmax = m_ymin = m_ymax = 0.0;
+}
+
+void KdTree2D::clear()
+{
+    m_nodes.clear();
+    m_xmin = m_xmax = m_ymin = m_ymax = 0.0;
+}
+
+void KdTree2D::build(const QVector<Point> &points)
+{
+    m_nodes.clear();
+    m_nodes.reserve(points.size());
+    for(auto &p : points){
+        if(!qIsNaN(p.x) && !qIsNaN(p.y)){
+            m_nodes.append(p);
+        }
+    }
+
+    m_xmin = m_ymin =  qInf();
+    m_xmax = m_ymax = -qInf();
+    for(auto &p : m_nodes){
+        m_xmin = qMin(m_xmin, p.x);
+        m_xmax = qMax(m_xmax, p.x);
+        m_ymin = qMin(m_ymin, p.y);
+        m_ymax = qMax(m_ymax, p.y);
+    }
+
+    buildRange(0, m_nodes.size(), 0);
+}
+
+void KdTree2D::buildRange(int begin, int end, int depth)
+{
+    if(end - begin <= 1){
+        return;
+    }
+
+    // The median is placed at the middle, smaller ones before it and larger ones after it.
+    int mid = (begin + end)/2;
+    if(depth%2 == 0){
+        std::nth_element(m_nodes.begin() + begin, m_nodes.begin() + mid, m_nodes.begin() + end, [](const Point& a, const Point& b){ return a.x < b.x; });
+    }else{
+        std::nth_element(m_nodes.begin() + begin, m_nodes.begin() + mid, m_nodes.begin() + end, [](const Point& a, const Point& b){ return a.y < b.y; });
+    }
+
+    buildRange(begin, mid, depth + 1);
+    buildRange(mid + 1, end, depth + 1);
+}
+
+void KdTree2D::searchNearest(int begin, int end, int depth, double x, double y, double sx, double sy, int k, QVector<Candidate>& heap, double& worst2) const
+{
+    if(begin >= end){
+        return;
+    }
+
+    auto heapLess = [](const Candidate& a, const Candidate& b){ return a.distance2 < b.distance2; };
+
+    int mid = (begin + end)/2;
+    const Point& p = m_nodes[mid];
+
+    double dx = (p.x - x)*sx;
+    double dy = (p.y - y)*sy;
+    double d2 = dx*dx + dy*dy;
+
+    if(d2 < worst2){
+        heap.append(Candidate{d2, p.id});
+        std::push_heap(heap.begin(), heap.end(), heapLess);
+        if(heap.size() > k){
+            std::pop_heap(heap.begin(), heap.end(), heapLess);
+            heap.removeLast();
+        }
+        if(heap.size() == k){
+            worst2 = heap.first().distance2;
+        }
+    }
+
+    int    axis  = depth%2;
+    double delta = (axis == 0) ? (x - p.x)*sx : (y - p.y)*sy;
+
+    // near side first, then far side only if the splitting line is closer than the current worst
+    if(delta < 0){
+        searchNearest(begin, mid, depth + 1, x, y, sx, sy, k, heap, worst2);
+        if(delta*delta < worst2){
+            searchNearest(mid + 1, end, depth + 1, x, y, sx, sy, k, heap, worst2);
+        }
+    }else{
+        searchNearest(mid + 1, end, depth + 1, x, y, sx, sy, k, heap, worst2);
+        if(delta*delta < worst2){
+            searchNearest(begin, mid, depth + 1, x, y, sx, sy, k, heap, worst2);
+        }
+    }
+}
+
+int KdTree2D::nearest(double x, double y, double sx, double sy, double maxDistance) const
+{
+    QVector<Candidate> heap;
+    double worst2 = maxDistance*maxDistance;
+    searchNearest(0, m_nodes.size(), 0, x, y, qAbs(sx), qAbs(sy), 1, heap, worst2);
+
+    return heap.isEmpty() ? -1 : heap.first().id;
+}
+
+void KdTree2D::searchRectangle(int begin, int end, int depth, double xmin, double xmax, double ymin, double ymax, QVector<int>& nodes) const
+{
+    if(begin >= end){
+        return;
+    }
+
+    int mid = (begin + end)/2;
+    const Point& p = m_nodes[mid];
+
+    if(xmin <= p.x && p.x <= xmax && ymin <= p.y && p.y <= ymax){
+        nodes.append(mid);
+    }
+
+    int    axis = depth%2;
+    double c    = coord(mid, axis);
+    double lo   = (axis == 0) ? xmin : ymin;
+    double hi   = (axis == 0) ? xmax : ymax;
+
+    if(lo <= c){
+        searchRectangle(begin, mid, depth + 1, xmin, xmax, ymin, ymax, nodes);
+    }
+    if(c <= hi){
+        searchRectangle(mid + 1, end, depth + 1, xmin, xmax, ymin, ymax, nodes);
+    }
+}
+
+QVector<int> KdTree2D::rectangle(double xmin, double xmax, double ymin, double ymax) const
+{
+    if(xmin > xmax) std::swap(xmin, xmax);
+    if(ymin > ymax) std::swap(ymin, ymax);
+
+    QVector<int> nodes;
+    searchRectangle(0, m_nodes.size(), 0, xmin, xmax, ymin, ymax, nodes);
+
+    QVector<int> ids;
+    ids.reserve(nodes.size());
+    for(int n : nodes){
+        ids.append(m_nodes[n].id);
+    }
+    return ids;
+}
+
+QVector<int> KdTree2D::polygon(const QPolygonF &lasso) const
+{
+    QVector<int> ids;
+    if(lasso.size() < 3){
+        return ids;
+    }
+
+    // candidates in the bounding box are tested one by one
+    QRectF bound = lasso.boundingRect();
+    QVector<int> nodes;
+    searchRectangle(0, m_nodes.size(), 0, bound.left(), bound.right(), bound.top(), bound.bottom(), nodes);
+
+    for(int n : nodes){
+        const Point& p = m_nodes[n];
+        if(lasso.containsPoint(QPointF(p.x, p.y), Qt::OddEvenFill)){
+            ids.append(p.id);
+        }
+    }
+    return ids;
+}
+
+void KdTree2D::searchHalfPlane(int begin, int end, int depth, double xmin, double xmax, double ymin, double ymax, double a, double b, double t, QVector<int> &nodes) const
+{
+    if(begin >= end){
+        return;
+    }
+
+    // The extremes of a*x + b*y over the cell are at its corners.
+    double vmax = a*((a >= 0) ? xmax : xmin) + b*((b >= 0) ? ymax : ymin);
+    if(vmax < t){
+        return;
+    }
+    double vmin = a*((a >= 0) ? xmin : xmax) + b*((b >= 0) ? ymin : ymax);
+    if(vmin >= t){
+        for(int n = begin; n < end; n++){
+            nodes.append(n);
+        }
+        return;
+    }
+
+    int mid = (begin + end)/2;
+    const Point& p = m_nodes[mid];
+
+    if(a*p.x + b*p.y >= t){
+        nodes.append(mid);
+    }
+
+    // The cell is split at the median on the axis of the depth.
+    if(depth%2 == 0){
+        searchHalfPlane(begin, mid, depth + 1, xmin, p.x, ymin, ymax, a, b, t, nodes);
+        searchHalfPlane(mid + 1, end, depth + 1, p.x, xmax, ymin, ymax, a, b, t, nodes);
+    }else{
+        searchHalfPlane(begin, mid, depth + 1, xmin, xmax, ymin, p.y, a, b, t, nodes);
+        searchHalfPlane(mid + 1, end, depth + 1, xmin, xmax, p.y, ymax, a, b, t, nodes);
+    }
+}
+
+QVector<int> KdTree2D::halfPlane(double a, double b, double t) const
+{
+    QVector<int> nodes;
+    searchHalfPlane(0, m_nodes.size(), 0, m_xmin, m_xmax, m_ymin, m_ymax, a, b, t, nodes);
+
+    QVector<int> ids;
+    ids.reserve(nodes.size());
+    for(int n : nodes){
+        ids.append(m_nodes[n].id);
+    }
+    return ids;
+}
@@ -0,0 +1,100 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef KD_TREE_2D_H
+#define KD_TREE_2D_H
+
+#include <QVector>
+#include <QPolygonF>
+#include <QtNumeric>
+
+/**
+ * @brief Static 2-D k-d tree for point queries on a glass map
+ * @details The points are reordered into an implicit balanced tree, in which the median of each range is the node splitting the range.
+ *          Distances are measured after scaling each axis, so that the queries can be done in pixel space of the plot
+ *          by giving the pixels per unit of each axis.
+ */
+class KdTree2D
+{
+public:
+    struct Point{
+        double x;
+        double y;
+        int    id; // e.g. row of GlassTable
+    };
+
+    KdTree2D();
+
+    /** Build the tree.  NaN points are ignored. */
+    void build(const QVector<Point>& points);
+    void clear();
+
+    int  size() const { return m_nodes.size(); }
+    bool isEmpty() const { return m_nodes.isEmpty(); }
+
+    /**
+     * @brief Nearest point
+     * @param x query coordinate
+     * @param y query coordinate
+     * @param sx scale of x axis
+     * @param sy scale of y axis
+     * @param maxDistance points farther than this scaled distance are ignored
+     * @return id of the nearest point, or -1 if not found
+     */
+    int nearest(double x, double y, double sx = 1.0, double sy = 1.0, double maxDistance = qInf()) const;
+
+    /** Ids of the points in the rectangle */
+    QVector<int> rectangle(double xmin, double xmax, double ymin, double ymax) const;
+
+    /** Ids of the points in the polygon (lasso) */
+    QVector<int> polygon(const QPolygonF& lasso) const;
+
+    /** Ids of the points on the side of the line where a*x + b*y >= t */
+    QVector<int> halfPlane(double a, double b, double t) const;
+
+private:
+    struct Candidate{
+        double distance2;
+        int    id;
+    };
+
+    void buildRange(int begin, int end, int depth);
+    void searchNearest(int begin, int end, int depth, double x, double y, double sx, double sy, int k, QVector<Candidate>& heap, double& worst2) const;
+    void searchRectangle(int begin, int end, int depth, double xmin, double xmax, double ymin, double ymax, QVector<int>& ids) const;
+    void searchHalfPlane(int begin, int end, int depth, double xmin, double xmax, double ymin, double ymax, double a, double b, double t, QVector<int>& nodes) const;
+
+    inline double coord(int n, int axis) const;
+
+    QVector<Point> m_nodes;
+
+    // bounding box of the points
+    double m_xmin, m_xmax, m_ymin, m_ymax;
+};
+
+double KdTree2D::coord(int n, int axis) const
+{
+    return (axis == 0) ? m_nodes[n].x : m_nodes[n].y;
+}
+
+#endif // KD_TREE_2D_H
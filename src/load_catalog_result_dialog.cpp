@@ -25,6 +25,9 @@
 #include "load_catalog_result_dialog.h"
 #include "ui_load_catalog_result_dialog.h"
 
+#include <QHeaderView>
+#include "parse_diagnostics_model.h"
+
 
 LoadCatalogResultDialog::LoadCatalogResultDialog(QWidget *parent) :
     QDialog(parent),
@@ -34,7 +37,16 @@ LoadCatalogResultDialog::LoadCatalogResultDialog(QWidget *parent) :
 
     this->setWindowTitle("File Loading Result");
 
+    m_model = new ParseDiagnosticsModel(this);
+    ui->tableView_Result->setModel(m_model);
+
+    // fixed row height so that the view does not measure every row
+    ui->tableView_Result->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui->tableView_Result->verticalHeader()->setDefaultSectionSize(ui->tableView_Result->fontMetrics().height() + 4);
+    ui->tableView_Result->horizontalHeader()->setStretchLastSection(true);
+
     connect(ui->pushButton_OK, SIGNAL(clicked()), this, SLOT(accept()));
+    connect(ui->comboBox_Filter, SIGNAL(currentIndexChanged(int)), this, SLOT(setFilter(int)));
 }
 
 LoadCatalogResultDialog::~LoadCatalogResultDialog()
@@ -47,8 +59,31 @@ void LoadCatalogResultDialog::setLabel(QString labeltext)
     ui->label->setText(labeltext);
 }
 
-void LoadCatalogResultDialog::setText(QString text)
+void LoadCatalogResultDialog::setDiagnostics(const ParseDiagnostics &diagnostics)
+{
+    m_model->setDiagnostics(diagnostics);
+
+    // filter items with the number of records
+    ui->comboBox_Filter->blockSignals(true);
+    ui->comboBox_Filter->clear();
+    ui->comboBox_Filter->addItem("All (" + QString::number(diagnostics.recordCount()) + ")", -1);
+    for(int code = 0; code < ParseDiagnostics::CodeCount; code++){
+        int count = diagnostics.count(static_cast<ParseDiagnostics::Code>(code));
+        if(count > 0){
+            ui->comboBox_Filter->addItem(ParseDiagnostics::message(static_cast<ParseDiagnostics::Code>(code)) + " (" + QString::number(count) + ")", code);
+        }
+    }
+    ui->comboBox_Filter->blockSignals(false);
+
+    m_model->setCodeFilter(-1);
+    ui->tableView_Result->resizeColumnsToContents();
+}
+
+void LoadCatalogResultDialog::setFilter(int comboIndex)
 {
-    ui->textEdit_Result->setText(text);
+    if(comboIndex < 0){
+        return;
+    }
+    m_model->setCodeFilter(ui->comboBox_Filter->itemData(comboIndex).toInt());
 }
 
@@ -27,6 +27,10 @@
 
 #include <QDialog>
 
+#include "parse_diagnostics.h"
+
+class ParseDiagnosticsModel;
+
 namespace Ui {
 class LoadCatalogResultDialog;
 }
@@ -40,10 +44,14 @@ public:
     ~LoadCatalogResultDialog();
 
     void setLabel(QString labeltext);
-    void setText(QString text);
+    void setDiagnostics(const ParseDiagnostics& diagnostics);
+
+private slots:
+    void setFilter(int comboIndex);
 
 private:
     Ui::LoadCatalogResultDialog *ui;
+    ParseDiagnosticsModel* m_model;
 };
 
 #endif // LOAD_CATALOG_RESULT_DIALOG_H
@@ -23,11 +23,21 @@
  *****************************************************************************/
 
 #include "main_window.h"
+#include "batch_renderer.h"
 
 #include <QApplication>
 
 int main(int argc, char *argv[])
 {
+    // batch rendering without display
+    if(BatchRenderer::isRequested(argc, argv)){
+        if(!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")){
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+        QApplication a(argc, argv);
+        return BatchRenderer::exec(a.arguments());
+    }
+
     QApplication a(argc, argv);
     //a.setStyle("fusion"); //for windows, it looks better.
     MainWindow w;
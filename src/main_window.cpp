@@ -27,6 +27,7 @@
 #include "ui_main_window.h"
 
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QMessageBox>
 
 #include "glassmap_form.h"
@@ -36,6 +37,12 @@
 #include "dndt_plot_form.h"
 #include "catalog_view_form.h"
 #include "glass_search_form.h"
+#include "glass_substitute_form.h"
+#include "glass_skyline_form.h"
+#include "glass_combination_form.h"
+#include "glass_athermal_form.h"
+#include "glass_melt_fit_form.h"
+#include "dispersion_similarity_form.h"
 #include "load_catalog_result_dialog.h"
 #include "preference_dialog.h"
 
@@ -51,6 +58,7 @@ MainWindow::MainWindow(QWidget *parent)
     // File menu
     QObject::connect(ui->action_loadAGF,    SIGNAL(triggered()), this, SLOT(loadNewAGF()));
     QObject::connect(ui->action_loadXML,    SIGNAL(triggered()), this, SLOT(loadNewXML()));
+    QObject::connect(ui->action_WatchFiles, SIGNAL(toggled(bool)), this, SLOT(setWatchFiles(bool)));
     QObject::connect(ui->action_Preference, SIGNAL(triggered()), this, SLOT(showPreferenceDlg()));
 
     // Tools menu
@@ -58,12 +66,21 @@ MainWindow::MainWindow(QWidget *parent)
     QObject::connect(ui->action_NeVe,              SIGNAL(triggered()),this, SLOT(showGlassMapNeVe()));
     QObject::connect(ui->action_VdPgF,             SIGNAL(triggered()),this, SLOT(showGlassMapVdPgF()));
     QObject::connect(ui->action_VdPCt,             SIGNAL(triggered()),this, SLOT(showGlassMapVdPCt()));
+    QObject::connect(ui->action_VdDPgF,            SIGNAL(triggered()),this, SLOT(showGlassMapVdDPgF()));
+    QObject::connect(ui->action_VdDPCt,            SIGNAL(triggered()),this, SLOT(showGlassMapVdDPCt()));
+    QObject::connect(ui->action_VeDPgF_,           SIGNAL(triggered()),this, SLOT(showGlassMapVeDPgF_()));
     QObject::connect(ui->action_Buchdahl,          SIGNAL(triggered()),this, SLOT(showGlassMapBuchdahl()));
     QObject::connect(ui->action_DispersionPlot,    SIGNAL(triggered()),this, SLOT(showDispersionPlot()));
     QObject::connect(ui->action_TransmittancePlot, SIGNAL(triggered()),this, SLOT(showTransmittancePlot()));
     QObject::connect(ui->action_DnDtabsPlot,       SIGNAL(triggered()),this, SLOT(showDnDtabsPlot()));
     QObject::connect(ui->action_CatalogView,       SIGNAL(triggered()),this, SLOT(showCatalogViewForm()));
     QObject::connect(ui->action_GlassSearch,       SIGNAL(triggered()),this, SLOT(showGlassSearchForm()));
+    QObject::connect(ui->action_GlassSubstitute,   SIGNAL(triggered()),this, SLOT(showGlassSubstituteForm()));
+    QObject::connect(ui->action_ParetoFront,       SIGNAL(triggered()),this, SLOT(showGlassSkylineForm()));
+    QObject::connect(ui->action_GlassCombination,  SIGNAL(triggered()),this, SLOT(showGlassCombinationForm()));
+    QObject::connect(ui->action_AthermalGlass,     SIGNAL(triggered()),this, SLOT(showGlassAthermalForm()));
+    QObject::connect(ui->action_MeltFitting,       SIGNAL(triggered()),this, SLOT(showGlassMeltFitForm()));
+    QObject::connect(ui->action_DispersionSimilarity, SIGNAL(triggered()),this, SLOT(showDispersionSimilarityForm()));
 
     // Window menu
     QObject::connect(ui->action_Tile,    SIGNAL(triggered()),this, SLOT(tileWindows()));
@@ -81,12 +98,48 @@ MainWindow::MainWindow(QWidget *parent)
     m_globalSettings->loadIniFile();
 
     m_catalogManager = new GlassCatalogManager();
+    QObject::connect(m_catalogManager, SIGNAL(reloadFailed(ParseDiagnostics)), this, SLOT(onReloadFailed(ParseDiagnostics)));
+    ui->action_WatchFiles->setChecked(m_globalSettings->doWatchFiles());
+
+    // background loading
+    m_catalogLoader = nullptr;
+    m_loaderThread  = nullptr;
+    m_loadingPublished = false;
+
+    // Each publication rebuilds the table, so that the files loaded in a short interval are published together.
+    m_publishTimer = new QTimer(this);
+    m_publishTimer->setSingleShot(true);
+    m_publishTimer->setInterval(200);
+    QObject::connect(m_publishTimer, SIGNAL(timeout()), this, SLOT(publishLoadedCatalogs()));
+
+    m_labelLoading = new QLabel(this);
+    m_progressBar  = new QProgressBar(this);
+    m_progressBar->setMaximumWidth(200);
+    m_buttonCancelLoading = new QPushButton(tr("Cancel"), this);
+    QObject::connect(m_buttonCancelLoading, SIGNAL(clicked()), this, SLOT(cancelLoading()));
+
+    ui->statusbar->addPermanentWidget(m_labelLoading);
+    ui->statusbar->addPermanentWidget(m_progressBar);
+    ui->statusbar->addPermanentWidget(m_buttonCancelLoading);
+    m_labelLoading->hide();
+    m_progressBar->hide();
+    m_buttonCancelLoading->hide();
+
+    updateMenuState();
 
     // loading default catalog files is in main.cpp
 }
 
 MainWindow::~MainWindow()
 {
+    if(m_catalogLoader){
+        m_catalogLoader->cancel();
+        m_loaderThread->quit();
+        m_loaderThread->wait();
+        delete m_catalogLoader;
+        m_catalogLoader = nullptr;
+    }
+
     try {
         delete m_globalSettings;
     }  catch (...) {
@@ -106,22 +159,7 @@ void MainWindow::loadDefaultCatalogFiles()
         return;
     }
 
-    QString parseResult;
-    m_catalogManager->loadCatalogFiles(catalogFilePaths, parseResult);
-
-    //set temperature
-    double temperature = m_globalSettings->temperature();
-    Glass::setCurrentTemperature(temperature);
-
-    if(m_globalSettings->doShowResult()) {
-        LoadCatalogResultDialog dlg(this);
-        dlg.setLabel("Loading catalog files has been finished.\nBelows are notable parse results.");
-        dlg.setText(parseResult);
-        dlg.exec();
-    }else{
-        QMessageBox::information(this, tr("Info"), "Catalog files were newly loaded");
-    }
-
+    loadCatalogFilesInBackground(catalogFilePaths);
 }
 
 void MainWindow::loadNewAGF()
@@ -135,18 +173,7 @@ void MainWindow::loadNewAGF()
         QMessageBox::warning(this,tr("Canceled"), tr("Canceled"));
         return;
     }else{
-        ui->mdiArea->closeAllSubWindows();
-
-        QString parseResult;
-        GlassCatalogManager::loadCatalogFiles(filePaths, parseResult);
-        if(m_globalSettings->doShowResult()) {
-            LoadCatalogResultDialog dlg(this);
-            dlg.setLabel("Loading catalog files has been finished.\nBelows are notable parse results.");
-            dlg.setText(parseResult);
-            dlg.exec();
-        }else{
-            QMessageBox::information(this, tr("Info"), "Catalog files were newly loaded");
-        }
+        loadCatalogFilesInBackground(filePaths);
     }
 
 }
@@ -162,20 +189,169 @@ void MainWindow::loadNewXML()
         QMessageBox::warning(this,tr("Canceled"), tr("Canceled"));
         return;
     } else {
-        ui->mdiArea->closeAllSubWindows();
-        QString parseResult;
-        GlassCatalogManager::loadCatalogFiles(filePaths, parseResult);
-        if(m_globalSettings->doShowResult()) {
-            LoadCatalogResultDialog dlg(this);
-            dlg.setLabel("Loading catalog files has been finished.\nBelows are notable parse results.");
-            dlg.setText(parseResult);
-            dlg.exec();
-        }else{
-            QMessageBox::information(this, tr("Info"), "Catalog files were newly loaded");
+        loadCatalogFilesInBackground(filePaths);
+    }
+}
+
+void MainWindow::loadCatalogFilesInBackground(const QStringList &catalogFilePaths)
+{
+    if(m_catalogLoader){
+        QMessageBox::warning(this, tr("Warning"), tr("Catalog files are being loaded"));
+        return;
+    }
+
+    m_catalogLoader = new CatalogLoader(catalogFilePaths);
+    m_loaderThread  = new QThread(this);
+    m_catalogLoader->moveToThread(m_loaderThread);
+
+    QObject::connect(m_loaderThread,  SIGNAL(started()), m_catalogLoader, SLOT(run()));
+    QObject::connect(m_catalogLoader, SIGNAL(progressChanged(int,int,QString)), this, SLOT(onLoadingProgress(int,int,QString)));
+    QObject::connect(m_catalogLoader, SIGNAL(catalogLoaded()), this, SLOT(onCatalogLoaded()));
+    QObject::connect(m_catalogLoader, SIGNAL(finished()), this, SLOT(onLoadingFinished()));
+    m_loadingPublished = false;
+
+    m_progressBar->setRange(0, catalogFilePaths.size());
+    m_progressBar->setValue(0);
+    m_labelLoading->setText(tr("Loading..."));
+    m_labelLoading->show();
+    m_progressBar->show();
+    m_buttonCancelLoading->show();
+    ui->action_loadAGF->setEnabled(false);
+    ui->action_loadXML->setEnabled(false);
+
+    m_loaderThread->start();
+}
+
+void MainWindow::onLoadingProgress(int loadedCount, int totalCount, const QString &filePath)
+{
+    m_progressBar->setRange(0, totalCount);
+    m_progressBar->setValue(loadedCount);
+
+    if(!filePath.isEmpty()){
+        m_labelLoading->setText(QFileInfo(filePath).fileName());
+    }
+}
+
+void MainWindow::onCatalogLoaded()
+{
+    if(!m_publishTimer->isActive()){
+        m_publishTimer->start();
+    }
+}
+
+void MainWindow::publishLoadedCatalogs()
+{
+    if(!m_catalogLoader || m_catalogLoader->isCanceled()){
+        return;
+    }
+
+    QStringList filePaths;
+    QList<GlassCatalog*> catalogs = m_catalogLoader->takeCatalogs(filePaths);
+    if(!catalogs.isEmpty()){
+        publishCatalogBatch(catalogs, filePaths);
+    }
+}
+
+void MainWindow::publishCatalogBatch(const QList<GlassCatalog*> &catalogs, const QStringList &filePaths)
+{
+    if(m_loadingPublished){
+        GlassCatalogManager::appendCatalogs(catalogs, filePaths);
+    }
+    else{
+        // The subwindows refer to the old catalogs, so they are closed before the catalogs are replaced.
+        closeAll();
+
+        // The table is built once at the temperature of the preference.
+        double temperature = m_globalSettings->temperature();
+        NormalLine::Reference normalLineReference = static_cast<NormalLine::Reference>(m_globalSettings->normalLineReference());
+
+        GlassCatalogManager::publishCatalogs(catalogs, filePaths, temperature, normalLineReference);
+        m_loadingPublished = true;
+    }
+
+    updateMenuState();
+}
+
+void MainWindow::cancelLoading()
+{
+    if(m_catalogLoader){
+        m_catalogLoader->cancel();
+        m_labelLoading->setText(tr("Canceling..."));
+    }
+}
+
+void MainWindow::onLoadingFinished()
+{
+    // run() has already returned, so the loader can be accessed from this thread.
+    m_loaderThread->quit();
+    m_loaderThread->wait();
+
+    m_publishTimer->stop();
+
+    bool        canceled    = m_catalogLoader->isCanceled();
+    ParseDiagnostics diagnostics = m_catalogLoader->diagnostics();
+    QStringList filePaths;
+    QList<GlassCatalog*> catalogs = m_catalogLoader->takeCatalogs(filePaths);
+
+    delete m_catalogLoader;
+    m_catalogLoader = nullptr;
+    delete m_loaderThread;
+    m_loaderThread = nullptr;
+
+    m_labelLoading->hide();
+    m_progressBar->hide();
+    m_buttonCancelLoading->hide();
+    ui->action_loadAGF->setEnabled(true);
+    ui->action_loadXML->setEnabled(true);
+
+    if(canceled){
+        // The catalogs already published are kept, and the rest are discarded.
+        for(auto &cat : catalogs){
+            delete cat;
         }
+        catalogs.clear();
+        ui->statusbar->showMessage(tr("Loading catalog files was canceled"), 5000);
+        return;
+    }
+
+    // The rest of the catalogs.  If no file was loaded, the current catalogs are replaced with none as before.
+    if(!catalogs.isEmpty() || !m_loadingPublished){
+        publishCatalogBatch(catalogs, filePaths);
+    }
+
+    if(m_globalSettings->doShowResult()) {
+        LoadCatalogResultDialog dlg(this);
+        dlg.setLabel("Loading catalog files has been finished.\nBelows are notable parse results.");
+        dlg.setDiagnostics(diagnostics);
+        dlg.exec();
+    }else{
+        QMessageBox::information(this, tr("Info"), "Catalog files were newly loaded");
     }
 }
 
+void MainWindow::onReloadFailed(const ParseDiagnostics &diagnostics)
+{
+    QStringList messages;
+    for(int i = 0; i < diagnostics.recordCount(); i++){
+        messages.append(diagnostics.toString(diagnostics.record(i)));
+    }
+    messages.removeDuplicates();
+    ui->statusbar->showMessage(tr("Failed to reload catalog files: ") + messages.join("; "), 5000);
+}
+
+void MainWindow::updateMenuState()
+{
+    ui->menuTools->setEnabled(!GlassCatalogManager::isEmpty());
+}
+
+void MainWindow::setWatchFiles(bool state)
+{
+    m_catalogManager->setWatchEnabled(state);
+
+    m_globalSettings->setDoWatchFiles(state);
+    m_globalSettings->saveIniFile();
+}
+
 
 void MainWindow::showPreferenceDlg()
 {
@@ -233,6 +409,21 @@ void MainWindow::showGlassMapVdPCt()
     showGlassMap("vd", "PCt_",QCPRange(10,100), QCPRange(0.6,0.9));
 }
 
+void MainWindow::showGlassMapVdDPgF()
+{
+    showGlassMap("vd", "dPgF", QCPRange(10,100), QCPRange(-0.03,0.05));
+}
+
+void MainWindow::showGlassMapVdDPCt()
+{
+    showGlassMap("vd", "dPCt_", QCPRange(10,100), QCPRange(-0.1,0.1));
+}
+
+void MainWindow::showGlassMapVeDPgF_()
+{
+    showGlassMap("ve", "dPgF_", QCPRange(10,100), QCPRange(-0.03,0.05));
+}
+
 void MainWindow::showGlassMapBuchdahl()
 {
     showGlassMap("eta2", "eta1",QCPRange(-0.025,0.175), QCPRange(-0.25,0.0), false);
@@ -279,6 +470,36 @@ void MainWindow::showGlassSearchForm()
     showAnalysisForm<GlassSearchForm>();
 }
 
+void MainWindow::showGlassSubstituteForm()
+{
+    showAnalysisForm<GlassSubstituteForm>();
+}
+
+void MainWindow::showGlassSkylineForm()
+{
+    showAnalysisForm<GlassSkylineForm>();
+}
+
+void MainWindow::showGlassCombinationForm()
+{
+    showAnalysisForm<GlassCombinationForm>();
+}
+
+void MainWindow::showGlassAthermalForm()
+{
+    showAnalysisForm<GlassAthermalForm>();
+}
+
+void MainWindow::showGlassMeltFitForm()
+{
+    showAnalysisForm<GlassMeltFitForm>();
+}
+
+void MainWindow::showDispersionSimilarityForm()
+{
+    showAnalysisForm<DispersionSimilarityForm>();
+}
+
 void MainWindow::tileWindows()
 {
     ui->mdiArea->tileSubWindows();
@@ -26,10 +26,16 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QThread>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QLabel>
+#include <QTimer>
 
 #include "qcustomplot.h"
 #include "glass_catalog_manager.h"
 #include "global_settings_io.h"
+#include "catalog_loader.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -47,6 +53,19 @@ public:
 
 private:
 
+    /**
+     * @brief Start loading catalog files in a background thread
+     * @details Current catalogs remain available until the first new ones are published.
+     *          The files loaded are published in batches, so that the analysis menus are enabled as soon as a catalog is available.
+     */
+    void loadCatalogFilesInBackground(const QStringList& catalogFilePaths);
+
+    /** Replace the current catalogs by the first batch of the loading, and append the later ones */
+    void publishCatalogBatch(const QList<GlassCatalog*>& catalogs, const QStringList& filePaths);
+
+    /** Enable analysis menus if any catalog is available */
+    void updateMenuState();
+
     /** Base function to show plot form */
     template<class F> void showAnalysisForm();
 
@@ -65,18 +84,34 @@ private:
 private slots:
     void loadNewAGF();
     void loadNewXML();
+    void setWatchFiles(bool state);
+    void onLoadingProgress(int loadedCount, int totalCount, const QString& filePath);
+    void onCatalogLoaded();
+    void publishLoadedCatalogs();
+    void onLoadingFinished();
+    void onReloadFailed(const ParseDiagnostics& diagnostics);
+    void cancelLoading();
     void showPreferenceDlg();
 
     void showGlassMapNdVd();
     void showGlassMapNeVe();
     void showGlassMapVdPgF();
     void showGlassMapVdPCt();
+    void showGlassMapVdDPgF();
+    void showGlassMapVdDPCt();
+    void showGlassMapVeDPgF_();
     void showGlassMapBuchdahl();
     void showDispersionPlot();
     void showTransmittancePlot();
     void showDnDtabsPlot();
     void showCatalogViewForm();
     void showGlassSearchForm();
+    void showGlassSubstituteForm();
+    void showGlassSkylineForm();
+    void showGlassCombinationForm();
+    void showGlassAthermalForm();
+    void showGlassMeltFitForm();
+    void showDispersionSimilarityForm();
 
     void tileWindows();
     void cascadeWindows();
@@ -89,5 +124,13 @@ private:
     GlobalSettingsIO* m_globalSettings;
     GlassCatalogManager *m_catalogManager;
 
+    CatalogLoader* m_catalogLoader;
+    QThread*       m_loaderThread;
+    QLabel*        m_labelLoading;
+    QProgressBar*  m_progressBar;
+    QPushButton*   m_buttonCancelLoading;
+    QTimer*        m_publishTimer;     // throttles the publication of the loaded catalogs
+    bool           m_loadingPublished; // true if any catalog of the loading has been published
+
 };
 #endif // MAINWINDOW_H
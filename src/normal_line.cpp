@@ -0,0 +1,212 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "normal_line.h"
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "glass_table.h"
+
+#include "Eigen/Dense"
+
+using namespace Eigen;
+
+namespace {
+
+// published normal line PgF = a0 + a1*vd through K7 and F2
+constexpr double normalLinePgF0 =  0.6438;
+constexpr double normalLinePgF1 = -0.001682;
+
+// Tukey's biweight tuning constant for 95% efficiency
+constexpr double biweightConstant = 4.685;
+constexpr int    maxIterations    = 50;
+
+double median(std::vector<double>& values)
+{
+    auto mid = values.begin() + values.size()/2;
+    std::nth_element(values.begin(), mid, values.end());
+    double m = *mid;
+    if(values.size() % 2 == 0){
+        m = 0.5*(m + *std::max_element(values.begin(), mid));
+    }
+    return m;
+}
+
+/** Row of the glass, preferring the SCHOTT catalog */
+int findReferenceRow(const GlassTable& table, const QString& productName)
+{
+    int row = table.findRow(productName + "_SCHOTT");
+    if(row >= 0 && table.isValid(row)){
+        return row;
+    }
+    for(int r = 0; r < table.rowCount(); r++){
+        if(table.isValid(r) && table.productName(r) == productName){
+            return r;
+        }
+    }
+    return -1;
+}
+
+/** Samples of the ratio from the selected glasses */
+void collectSamples(const GlassTable& table, int ratio, bool preferredOnly, QVector<double>& x, QVector<double>& y)
+{
+    const QVector<double>& v = table.column(NormalLine::abbeColumn(ratio));
+    const QVector<double>& p = table.column(NormalLine::partialColumn(ratio));
+    const QVector<quint8>& status = table.statusColumn();
+
+    x.clear();
+    y.clear();
+    for(int row = 0; row < table.rowCount(); row++){
+        if(!table.isValid(row) || (preferredOnly && GlassTable::StatusPreferred != status[row])){
+            continue;
+        }
+        if(std::isfinite(v[row]) && std::isfinite(p[row])){
+            x.append(v[row]);
+            y.append(p[row]);
+        }
+    }
+}
+
+}
+
+const QStringList& NormalLine::referenceNames()
+{
+    static const QStringList names({"K7 - F2", "Preferred glasses", "All glasses"});
+    return names;
+}
+
+int NormalLine::abbeColumn(int ratio)
+{
+    return (RatioPgF_ == ratio) ? GlassTable::ColumnVe : GlassTable::ColumnVd;
+}
+
+int NormalLine::partialColumn(int ratio)
+{
+    switch (ratio) {
+    case RatioPgF:  return GlassTable::ColumnPgF;
+    case RatioPCt_: return GlassTable::ColumnPCt_;
+    case RatioPgF_: return GlassTable::ColumnPgF_;
+    }
+    return -1;
+}
+
+int NormalLine::deviationColumn(int ratio)
+{
+    switch (ratio) {
+    case RatioPgF:  return GlassTable::ColumnDPgF;
+    case RatioPCt_: return GlassTable::ColumnDPCt_;
+    case RatioPgF_: return GlassTable::ColumnDPgF_;
+    }
+    return -1;
+}
+
+QVector<NormalLine::Coefficients> NormalLine::fit(const GlassTable &table, Reference reference)
+{
+    QVector<Coefficients> lines(RatioCount, Coefficients{NAN, NAN});
+
+    const int rowK7 = (ReferenceK7F2 == reference) ? findReferenceRow(table, "K7") : -1;
+    const int rowF2 = (ReferenceK7F2 == reference) ? findReferenceRow(table, "F2") : -1;
+
+    QVector<double> x, y;
+    for(int ratio = 0; ratio < RatioCount; ratio++){
+        if(ReferenceK7F2 == reference){
+            if(rowK7 >= 0 && rowF2 >= 0){
+                double v1 = table.value(abbeColumn(ratio), rowK7),   p1 = table.value(partialColumn(ratio), rowK7);
+                double v2 = table.value(abbeColumn(ratio), rowF2),   p2 = table.value(partialColumn(ratio), rowF2);
+                lines[ratio].a1 = (p2 - p1)/(v2 - v1);
+                lines[ratio].a0 = p1 - lines[ratio].a1*v1;
+                continue;
+            }
+            if(RatioPgF == ratio){
+                lines[ratio] = Coefficients{normalLinePgF0, normalLinePgF1};
+                continue;
+            }
+        }
+
+        collectSamples(table, ratio, (ReferenceAll != reference), x, y);
+        if(!fitRobust(x, y, lines[ratio]) && ReferenceAll != reference){
+            // too few preferred glasses
+            collectSamples(table, ratio, false, x, y);
+            fitRobust(x, y, lines[ratio]);
+        }
+    }
+
+    return lines;
+}
+
+bool NormalLine::fitRobust(const QVector<double> &x, const QVector<double> &y, Coefficients &line)
+{
+    const int n = x.size();
+    if(n < 2 || std::all_of(x.begin(), x.end(), [&](double v){ return v == x.first(); })){
+        return false;
+    }
+
+    MatrixXd A(n, 2);
+    VectorXd b(n);
+    for(int i = 0; i < n; i++){
+        A(i, 0) = 1.0;
+        A(i, 1) = x[i];
+        b(i)    = y[i];
+    }
+
+    // The first iteration is the ordinary least squares.
+    VectorXd w = VectorXd::Ones(n);
+    Vector2d beta(0.0, 0.0);
+    std::vector<double> absResiduals(n);
+
+    for(int iter = 0; iter < maxIterations; iter++){
+        VectorXd sw = w.cwiseSqrt();
+        Vector2d newBeta = (sw.asDiagonal()*A).colPivHouseholderQr().solve(sw.asDiagonal()*b);
+
+        bool converged = (iter > 0) && ((newBeta - beta).cwiseAbs().maxCoeff() < 1e-12*(1.0 + newBeta.cwiseAbs().maxCoeff()));
+        beta = newBeta;
+        if(converged){
+            break;
+        }
+
+        // scale by the median absolute deviation
+        VectorXd r = b - A*beta;
+        for(int i = 0; i < n; i++){
+            absResiduals[i] = std::fabs(r(i));
+        }
+        double scale = 1.4826*median(absResiduals);
+        if(scale <= 0.0){
+            break; // more than half of the samples are on the line
+        }
+
+        for(int i = 0; i < n; i++){
+            double u = r(i)/(biweightConstant*scale);
+            w(i) = (std::fabs(u) < 1.0) ? (1.0 - u*u)*(1.0 - u*u) : 0.0;
+        }
+        if((w.array() > 0.0).count() < 2){
+            break;
+        }
+    }
+
+    line.a0 = beta(0);
+    line.a1 = beta(1);
+    return true;
+}
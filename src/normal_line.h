@@ -0,0 +1,84 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef NORMAL_LINE_H
+#define NORMAL_LINE_H
+
+#include <QVector>
+#include <QStringList>
+
+class GlassTable;
+
+/**
+ * @brief Normal lines of the partial dispersions and the deviations from them
+ * @details A normal line P = a0 + a1*v is fitted for each partial dispersion ratio against its Abbe number,
+ *          and the deviation dP = P - (a0 + a1*v) of every glass is stored in the table.
+ *          The reference line is the straight line through K7 and F2, or a robust regression over the preferred (or all) glasses,
+ *          which is solved by iteratively reweighted least squares with Tukey's biweight and QR decomposition.
+ */
+class NormalLine
+{
+public:
+    enum Reference{
+        ReferenceK7F2,
+        ReferencePreferred,
+        ReferenceAll
+    };
+
+    enum Ratio{
+        RatioPgF,  // PgF  - vd
+        RatioPCt_, // PCt_ - vd
+        RatioPgF_, // PgF_ - ve
+        RatioCount
+    };
+
+    /** P = a0 + a1*v.  NaN if the line could not be determined. */
+    struct Coefficients{
+        double a0;
+        double a1;
+    };
+
+    static const QStringList& referenceNames();
+
+    /** GlassTable column of the Abbe number, the partial dispersion and the deviation of the ratio */
+    static int abbeColumn(int ratio);
+    static int partialColumn(int ratio);
+    static int deviationColumn(int ratio);
+
+    /**
+     * @brief Fit the normal lines of all the ratios
+     * @details For ReferenceK7F2, the PgF line falls back to the published constants and the other lines to the preferred glasses
+     *          if K7 or F2 is not loaded.
+     * @return coefficients for each ratio
+     */
+    static QVector<Coefficients> fit(const GlassTable& table, Reference reference);
+
+    /**
+     * @brief Robust straight line fit
+     * @return false if there are less than 2 distinct samples
+     */
+    static bool fitRobust(const QVector<double>& x, const QVector<double>& y, Coefficients& line);
+};
+
+#endif // NORMAL_LINE_H
@@ -0,0 +1,125 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "parse_diagnostics.h"
+
+#include <QFileInfo>
+
+ParseDiagnostics::ParseDiagnostics()
+{
+    m_counts = QVector<int>(CodeCount, 0);
+}
+
+int ParseDiagnostics::addFile(const QString &filePath)
+{
+    m_fileNames.append(QFileInfo(filePath).fileName());
+    m_glassNames.append(QStringList());
+    return m_fileNames.size() - 1;
+}
+
+void ParseDiagnostics::setGlassNames(int fileId, const QStringList &glassNames)
+{
+    m_glassNames[fileId] = glassNames;
+}
+
+void ParseDiagnostics::merge(const ParseDiagnostics &other)
+{
+    const int fileIdOffset = m_fileNames.size();
+    m_fileNames  += other.m_fileNames;
+    m_glassNames += other.m_glassNames;
+
+    m_records.reserve(m_records.size() + other.m_records.size());
+    for(auto &rec : other.m_records){
+        append(rec.fileId + fileIdOffset, rec.line, rec.glassId, rec.code);
+    }
+}
+
+void ParseDiagnostics::clear()
+{
+    m_fileNames.clear();
+    m_glassNames.clear();
+    m_records.clear();
+    m_counts.fill(0);
+}
+
+QString ParseDiagnostics::fileName(int fileId) const
+{
+    if(fileId < m_fileNames.size()){
+        return m_fileNames[fileId];
+    }
+    return QString();
+}
+
+QString ParseDiagnostics::glassName(const Record &rec) const
+{
+    if(rec.glassId >= 0 && rec.glassId < m_glassNames[rec.fileId].size()){
+        return m_glassNames[rec.fileId][rec.glassId];
+    }
+    return QString();
+}
+
+QString ParseDiagnostics::toString(const Record &rec) const
+{
+    QString str = fileName(rec.fileId);
+    if(rec.line > 0){
+        str += "(" + QString::number(rec.line) + ")";
+    }
+    str += ": ";
+
+    if(rec.glassId >= 0){
+        str += glassName(rec) + ": ";
+    }
+
+    return str + message(rec.code);
+}
+
+QString ParseDiagnostics::message(Code code)
+{
+    switch (code) {
+    case UnknownDispersionFormula:
+        return "Unknown dispersion formula";
+    case ThermalDataNotFound:
+        return "Thermal Data Not Found";
+    case OtherDataNotFound:
+        return "Other Data Not Found";
+    case TransmittanceDataNotFound:
+        return "Transmittance Data Not Found";
+    case LowTCENotFound:
+        return "Not found LowCTE";
+    case HighTCENotFound:
+        return "Not found HighCTE";
+    case AcidResistNotFound:
+        return "Not found Acid Resist";
+    case ClimateResistNotFound:
+        return "Not found Climate Resist";
+    case StainResistNotFound:
+        return "Not found Stain Resist";
+    case AlkaliResistNotFound:
+        return "Not found Alkali Resist";
+    case CatalogLoadingError:
+        return "Catalog loading error";
+    default:
+        return "Unknown";
+    }
+}
@@ -0,0 +1,127 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef PARSE_DIAGNOSTICS_H
+#define PARSE_DIAGNOSTICS_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+
+/**
+ * @brief Container of notable results found while parsing catalog files
+ * @details Each result is stored as a compact record of ids and a code, and the text is generated only when displayed.
+ */
+class ParseDiagnostics
+{
+public:
+    enum Code{
+        UnknownDispersionFormula,
+        ThermalDataNotFound,
+        OtherDataNotFound,
+        TransmittanceDataNotFound,
+        LowTCENotFound,
+        HighTCENotFound,
+        AcidResistNotFound,
+        ClimateResistNotFound,
+        StainResistNotFound,
+        AlkaliResistNotFound,
+        CatalogLoadingError,
+        CodeCount
+    };
+
+    struct Record{
+        int  fileId;
+        int  line;    // 0 if not available
+        int  glassId; // index in the catalog, -1 if not related to a glass
+        Code code;
+    };
+
+    ParseDiagnostics();
+
+    /** Register a new file and return its id */
+    int addFile(const QString& filePath);
+
+    /** Set glass names of the file to look up the glass ids */
+    void setGlassNames(int fileId, const QStringList& glassNames);
+
+    inline void append(int fileId, int line, int glassId, Code code);
+
+    /** Append the files and the records of the other */
+    void merge(const ParseDiagnostics& other);
+
+    void clear();
+    inline bool isEmpty() const;
+
+    inline int recordCount() const;
+    inline const Record& record(int n) const;
+
+    /** Number of the records with the code */
+    inline int count(Code code) const;
+
+    int     fileCount() const { return m_fileNames.size(); }
+    QString fileName(int fileId) const;
+    QString glassName(const Record& rec) const;
+
+    /** One line text of the record */
+    QString toString(const Record& rec) const;
+
+    static QString message(Code code);
+
+private:
+    QStringList        m_fileNames;
+    QList<QStringList> m_glassNames;
+    QVector<Record>    m_records;
+    QVector<int>       m_counts;
+};
+
+
+void ParseDiagnostics::append(int fileId, int line, int glassId, Code code)
+{
+    m_records.append(Record{fileId, line, glassId, code});
+    m_counts[code] += 1;
+}
+
+bool ParseDiagnostics::isEmpty() const
+{
+    return m_records.isEmpty();
+}
+
+int ParseDiagnostics::recordCount() const
+{
+    return m_records.size();
+}
+
+const ParseDiagnostics::Record& ParseDiagnostics::record(int n) const
+{
+    return m_records[n];
+}
+
+int ParseDiagnostics::count(Code code) const
+{
+    return m_counts[code];
+}
+
+#endif // PARSE_DIAGNOSTICS_H
@@ -0,0 +1,138 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "parse_diagnostics_model.h"
+
+ParseDiagnosticsModel::ParseDiagnosticsModel(QObject *parent) :
+    QAbstractTableModel(parent),
+    m_codeFilter(-1)
+{
+
+}
+
+void ParseDiagnosticsModel::setDiagnostics(const ParseDiagnostics &diagnostics)
+{
+    beginResetModel();
+    m_diagnostics = diagnostics;
+    updateRows();
+    endResetModel();
+}
+
+void ParseDiagnosticsModel::setCodeFilter(int code)
+{
+    beginResetModel();
+    m_codeFilter = code;
+    updateRows();
+    endResetModel();
+}
+
+void ParseDiagnosticsModel::updateRows()
+{
+    m_rows.clear();
+
+    if(m_codeFilter < 0){
+        m_rows.reserve(m_diagnostics.recordCount());
+        for(int i = 0; i < m_diagnostics.recordCount(); i++){
+            m_rows.append(i);
+        }
+    }
+    else{
+        m_rows.reserve(m_diagnostics.count(static_cast<ParseDiagnostics::Code>(m_codeFilter)));
+        for(int i = 0; i < m_diagnostics.recordCount(); i++){
+            if(m_diagnostics.record(i).code == m_codeFilter){
+                m_rows.append(i);
+            }
+        }
+    }
+}
+
+int ParseDiagnosticsModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid()){
+        return 0;
+    }
+    return m_rows.size();
+}
+
+int ParseDiagnosticsModel::columnCount(const QModelIndex &parent) const
+{
+    if(parent.isValid()){
+        return 0;
+    }
+    return ColumnCount;
+}
+
+QVariant ParseDiagnosticsModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid() || index.row() >= m_rows.size()){
+        return QVariant();
+    }
+
+    if(role != Qt::DisplayRole && role != Qt::ToolTipRole){
+        return QVariant();
+    }
+
+    const ParseDiagnostics::Record& rec = m_diagnostics.record(m_rows[index.row()]);
+
+    if(role == Qt::ToolTipRole){
+        return m_diagnostics.toString(rec);
+    }
+
+    switch (index.column()) {
+    case ColumnFile:
+        return m_diagnostics.fileName(rec.fileId);
+    case ColumnLine:
+        return (rec.line > 0) ? QVariant(rec.line) : QVariant("-");
+    case ColumnGlass:
+        return m_diagnostics.glassName(rec);
+    case ColumnMessage:
+        return ParseDiagnostics::message(rec.code);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ParseDiagnosticsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(role != Qt::DisplayRole){
+        return QVariant();
+    }
+
+    if(orientation == Qt::Vertical){
+        return section + 1;
+    }
+
+    switch (section) {
+    case ColumnFile:
+        return "File";
+    case ColumnLine:
+        return "Line";
+    case ColumnGlass:
+        return "Glass";
+    case ColumnMessage:
+        return "Message";
+    default:
+        return QVariant();
+    }
+}
@@ -0,0 +1,74 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef PARSE_DIAGNOSTICS_MODEL_H
+#define PARSE_DIAGNOSTICS_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+
+#include "parse_diagnostics.h"
+
+/**
+ * @brief Table model to show ParseDiagnostics
+ * @details Cell texts are generated only for the rows requested by the view.
+ */
+class ParseDiagnosticsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column{
+        ColumnFile,
+        ColumnLine,
+        ColumnGlass,
+        ColumnMessage,
+        ColumnCount
+    };
+
+    ParseDiagnosticsModel(QObject* parent = nullptr);
+
+    void setDiagnostics(const ParseDiagnostics& diagnostics);
+    const ParseDiagnostics& diagnostics() const { return m_diagnostics; }
+
+    /**
+     * @brief Show only the records with the code
+     * @param code ParseDiagnostics::Code, or -1 to show all
+     */
+    void setCodeFilter(int code);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    void updateRows();
+
+    ParseDiagnostics m_diagnostics;
+    QVector<int>     m_rows; // record indices shown in the view
+    int              m_codeFilter;
+};
+
+#endif // PARSE_DIAGNOSTICS_MODEL_H
@@ -0,0 +1,108 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "plot_data_model.h"
+
+PlotDataModel::PlotDataModel(QObject *parent) :
+    QAbstractTableModel(parent),
+    m_rowCount(0),
+    m_digit(1)
+{
+
+}
+
+void PlotDataModel::setColumns(const QStringList &headerLabels, const QVector<QVector<double> > &columns, int digit)
+{
+    beginResetModel();
+    m_headerLabels = headerLabels;
+    m_columns      = columns;
+    m_digit        = digit;
+
+    m_rowCount = 0;
+    for(auto &column : m_columns){
+        m_rowCount = qMax(m_rowCount, column.size());
+    }
+    endResetModel();
+}
+
+void PlotDataModel::clear()
+{
+    beginResetModel();
+    m_headerLabels.clear();
+    m_columns.clear();
+    m_rowCount = 0;
+    endResetModel();
+}
+
+int PlotDataModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid()){
+        return 0;
+    }
+    return m_rowCount;
+}
+
+int PlotDataModel::columnCount(const QModelIndex &parent) const
+{
+    if(parent.isValid()){
+        return 0;
+    }
+    return qMax(m_headerLabels.size(), m_columns.size());
+}
+
+QVariant PlotDataModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid()){
+        return QVariant();
+    }
+
+    const int row = index.row();
+    const int col = index.column();
+    if(col >= m_columns.size() || row >= m_columns[col].size()){
+        return QVariant();
+    }
+
+    if(Qt::DisplayRole == role){
+        return QString::number(m_columns[col][row], 'f', m_digit);
+    }
+    else if(Qt::TextAlignmentRole == role){
+        return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    }
+
+    return QVariant();
+}
+
+QVariant PlotDataModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(Qt::DisplayRole != role){
+        return QVariant();
+    }
+
+    if(Qt::Horizontal == orientation){
+        return m_headerLabels.value(section);
+    }
+    else{
+        return section + 1;
+    }
+}
@@ -0,0 +1,65 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef PLOT_DATA_MODEL_H
+#define PLOT_DATA_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief Table model to show the data of the property plots
+ * @details The model keeps the computed arrays as they are, without creating an item per cell.
+ *          Cell texts are formatted only for the cells requested by the view.
+ */
+class PlotDataModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    PlotDataModel(QObject* parent = nullptr);
+
+    /**
+     * @brief Replace all the data
+     * @param headerLabels label of each column
+     * @param columns values of each column.  A column shorter than the others is padded with empty cells.
+     * @param digit number of the digits after the decimal point
+     */
+    void setColumns(const QStringList& headerLabels, const QVector< QVector<double> >& columns, int digit);
+    void clear();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    QStringList               m_headerLabels;
+    QVector< QVector<double> > m_columns;
+    int                       m_rowCount;
+    int                       m_digit;
+};
+
+#endif // PLOT_DATA_MODEL_H
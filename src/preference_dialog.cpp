@@ -27,7 +27,7 @@
 
 #include <QFileDialog>
 #include <QDebug>
-#include "glass.h"
+#include "glass_catalog_manager.h"
 
 PreferenceDialog::PreferenceDialog(GlobalSettingsIO *settings, QWidget *parent) :
     QDialog(parent),
@@ -37,6 +37,7 @@ PreferenceDialog::PreferenceDialog(GlobalSettingsIO *settings, QWidget *parent)
     this->setWindowTitle("Preference");
 
     ui->lineEdit_Temperature->setValidator(new QDoubleValidator(-30, 70, 4, this));
+    ui->comboBox_NormalLine->addItems(NormalLine::referenceNames());
 
     QObject::connect(ui->pushButton_Browse, SIGNAL(clicked()), this, SLOT(browseCatalogFiles()));
     QObject::connect(ui->pushButton_Clear,  SIGNAL(clicked()), this, SLOT(clearCatalogFiles()));
@@ -100,6 +101,9 @@ void PreferenceDialog::syncUiWithSettings()
     // environment
     double temperature = m_globalSettings->temperature();
     ui->lineEdit_Temperature->setText(QString::number(temperature));
+
+    int normalLineReference = m_globalSettings->normalLineReference();
+    ui->comboBox_NormalLine->setCurrentIndex(qBound(0, normalLineReference, ui->comboBox_NormalLine->count() - 1));
 }
 
 void PreferenceDialog::onAccept()
@@ -123,7 +127,12 @@ void PreferenceDialog::onAccept()
     double temperature = ui->lineEdit_Temperature->text().toDouble();
     m_globalSettings->setTemperature(temperature);
 
-    Glass::setCurrentTemperature(temperature);
+    GlassCatalogManager::setTemperature(temperature);
+
+    int normalLineReference = ui->comboBox_NormalLine->currentIndex();
+    m_globalSettings->setNormalLineReference(normalLineReference);
+
+    GlassCatalogManager::setNormalLineReference(static_cast<NormalLine::Reference>(normalLineReference));
 
     m_globalSettings->saveIniFile();
 
@@ -24,11 +24,44 @@
 
 #include "property_plot_form.h"
 
+#include <QtConcurrent>
+
+namespace {
+
+// Points of the coarse sampling shown at once
+const double CoarsePointCount = 64.0;
+
+// Ratio of the steps between the successive samplings
+const double RefinementRatio = 8.0;
+
+}
+
 PropertyPlotForm::PropertyPlotForm(QWidget *parent):
-    QWidget(parent)
+    QWidget(parent),
+    m_editXmin(nullptr),
+    m_editXmax(nullptr),
+    m_editYmin(nullptr),
+    m_editYmax(nullptr),
+    m_editPlotStep(nullptr),
+    m_sampledDigit(1),
+    m_samplingStep(0.0),
+    m_samplingGeneration(0),
+    m_samplingPending(false),
+    m_pendingStep(0.0),
+    m_rangeDragSuspended(false)
 {
     // Attribute
     this->setAttribute(Qt::WA_DeleteOnClose, true);
+
+    m_samplingWatcher = new QFutureWatcher<SampledData>(this);
+    QObject::connect(m_samplingWatcher, SIGNAL(finished()), this, SLOT(onSamplingFinished()));
+}
+
+PropertyPlotForm::~PropertyPlotForm()
+{
+    // The task refers to the generation counter.
+    m_samplingGeneration.fetchAndAddOrdered(1);
+    m_samplingWatcher->waitForFinished();
 }
 
 void PropertyPlotForm::setupFundamentalUi(const QList<QPushButton*>& buttons, QCheckBox* chkLegend)
@@ -40,8 +73,21 @@ void PropertyPlotForm::setupFundamentalUi(const QList<QPushButton*>& buttons, QC
 
     QObject::connect(chkLegend, SIGNAL(toggled(bool)), this, SLOT(setLegendVisible()));
 
+    // The graphs and the legend have their own buffers, so that dragging the legend does not repaint the graphs.
+    m_customPlot->layer("main")->setMode(QCPLayer::lmBuffered);
+    m_customPlot->layer("legend")->setMode(QCPLayer::lmBuffered);
+
     m_customPlot->setContextMenuPolicy(Qt::CustomContextMenu);
     QObject::connect(m_customPlot, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(showContextMenuOnPlot()));
+
+    // The curves are sampled again while the axes are dragged or zoomed.
+    m_customPlot->setInteraction(QCP::iRangeDrag, true);
+    m_customPlot->setInteraction(QCP::iRangeZoom, true);
+    QObject::connect(m_customPlot->xAxis, SIGNAL(rangeChanged(QCPRange)), this, SLOT(onRangeChanged()));
+    QObject::connect(m_customPlot->yAxis, SIGNAL(rangeChanged(QCPRange)), this, SLOT(onRangeChanged()));
+
+    m_plotDataModel = new PlotDataModel(this);
+    m_plotDataTable->setModel(m_plotDataModel);
     m_plotDataTable->setContextMenuPolicy(Qt::CustomContextMenu);
     QObject::connect(m_plotDataTable, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(showContextMenuOnTable()));
 }
@@ -122,16 +168,6 @@ void PropertyPlotForm::setLegendVisible()
 }
 
 
-void PropertyPlotForm::setValueToCell(int row, int col, double val, int digit)
-{
-    QTableWidgetItem* item = m_plotDataTable->item(row, col);
-    if( !item ){
-        item = new QTableWidgetItem();
-    }
-    item->setText( QString::number(val, 'f', digit) );
-    m_plotDataTable->setItem(row,col,item);
-}
-
 QColor PropertyPlotForm::getColorFromIndex(int index, int maxIndex)
 {
     QCPColorGradient colorgrad;
@@ -157,6 +193,9 @@ QVector<double> PropertyPlotForm::getVectorFromRange(QCPRange range, double step
     double xmin = range.lower;
     double xmax = range.upper;
     QVector<double> xdata;
+    if(step <= 0.0){
+        return xdata;
+    }
     xdata.reserve(floor((xmax - xmin)/step) + 1 );
     double x = xmin;
     while(x <= xmax)
@@ -167,6 +206,154 @@ QVector<double> PropertyPlotForm::getVectorFromRange(QCPRange range, double step
     return xdata;
 }
 
+void PropertyPlotForm::startSampling(const QList<QCPGraph *> &graphs, const QList<CurveSampler> &samplers, const QStringList &headerLabels, int digit)
+{
+    m_sampledGraphs.clear();
+    for(auto graph : graphs){
+        m_sampledGraphs.append(graph);
+    }
+    m_samplers            = samplers;
+    m_sampledHeaderLabels = headerLabels;
+    m_sampledDigit        = digit;
+
+    resample();
+}
+
+void PropertyPlotForm::cancelSampling()
+{
+    m_samplingGeneration.fetchAndAddOrdered(1);
+    m_samplingPending = false;
+
+    m_sampledGraphs.clear();
+    m_samplers.clear();
+    m_sampledHeaderLabels.clear();
+}
+
+void PropertyPlotForm::resample()
+{
+    // A step queued for an older generation must not run against the new range.
+    m_samplingPending = false;
+
+    if(m_sampledHeaderLabels.isEmpty()){
+        return;
+    }
+
+    int generation = m_samplingGeneration.fetchAndAddOrdered(1) + 1;
+
+    m_sampledRange = m_customPlot->xAxis->range();
+    m_samplingStep = m_editPlotStep->text().toDouble();
+    if(m_samplingStep <= 0.0){
+        return;
+    }
+
+    // The coarse curves are sampled here, so that the plot follows the axes without delay.
+    double coarseStep = qMax(m_samplingStep, m_sampledRange.size()/CoarsePointCount);
+    bool   isFinal    = (coarseStep <= m_samplingStep);
+    setSampledData(sampleCurves(m_samplers, m_sampledRange, coarseStep, isFinal, generation, nullptr));
+
+    if(!isFinal){
+        startSamplingTask(qMax(m_samplingStep, coarseStep/RefinementRatio));
+    }
+}
+
+void PropertyPlotForm::startSamplingTask(double step)
+{
+    // The running task stops at the next curve since its generation is old.
+    if(m_samplingWatcher->isRunning()){
+        m_samplingPending = true;
+        m_pendingStep     = step;
+        return;
+    }
+
+    QList<CurveSampler> samplers   = m_samplers;
+    QCPRange            range      = m_sampledRange;
+    bool                isFinal    = (step <= m_samplingStep);
+    int                 generation = m_samplingGeneration.loadAcquire();
+    const QAtomicInt*   current    = &m_samplingGeneration;
+
+    m_samplingWatcher->setFuture(QtConcurrent::run([=](){
+        return sampleCurves(samplers, range, step, isFinal, generation, current);
+    }));
+}
+
+void PropertyPlotForm::onSamplingFinished()
+{
+    if(m_samplingPending){
+        m_samplingPending = false;
+        startSamplingTask(m_pendingStep);
+        return;
+    }
+
+    SampledData data = m_samplingWatcher->result();
+    if(data.generation != m_samplingGeneration.loadAcquire()){
+        return;
+    }
+
+    setSampledData(data);
+
+    if(!data.isFinal){
+        startSamplingTask(qMax(m_samplingStep, data.step/RefinementRatio));
+    }
+}
+
+PropertyPlotForm::SampledData PropertyPlotForm::sampleCurves(const QList<CurveSampler> &samplers, QCPRange range, double step, bool isFinal, int generation, const QAtomicInt *currentGeneration)
+{
+    SampledData data;
+    data.generation = generation;
+    data.step       = step;
+    data.isFinal    = isFinal;
+    data.xdata      = getVectorFromRange(range, step);
+
+    for(auto &sampler : samplers){
+        if(currentGeneration && currentGeneration->loadAcquire() != generation){
+            data.ydata.clear();
+            return data;
+        }
+        data.ydata.append(sampler(data.xdata));
+    }
+
+    return data;
+}
+
+void PropertyPlotForm::setSampledData(const SampledData &data)
+{
+    for(int i = 0; i < m_sampledGraphs.size() && i < data.ydata.size(); i++){
+        if(m_sampledGraphs[i]){
+            m_sampledGraphs[i]->setData(data.xdata, data.ydata[i], true);
+        }
+    }
+
+    if(data.isFinal){
+        QVector< QVector<double> > columns;
+        columns.append(data.xdata);
+        columns.append(data.ydata);
+
+        // The cells are formatted by the model only when they are shown.
+        m_plotDataModel->setColumns(m_sampledHeaderLabels, columns, m_sampledDigit);
+        m_customPlot->replot();
+    }
+    else{
+        m_customPlot->replot(QCustomPlot::rpQueuedReplot);
+    }
+}
+
+void PropertyPlotForm::onRangeChanged()
+{
+    // The line edits are set up after the plot.
+    if(!m_editXmin || !m_editXmax || !m_editYmin || !m_editYmax){
+        return;
+    }
+
+    m_editXmin->setText(QString::number(m_customPlot->xAxis->range().lower));
+    m_editXmax->setText(QString::number(m_customPlot->xAxis->range().upper));
+    m_editYmin->setText(QString::number(m_customPlot->yAxis->range().lower));
+    m_editYmax->setText(QString::number(m_customPlot->yAxis->range().upper));
+
+    if(m_customPlot->xAxis->range() != m_sampledRange){
+        resample();
+    }
+}
+
 //https://www.qcustomplot.com/index.php/support/forum/481
 void PropertyPlotForm::mouseMoveSignal(QMouseEvent *event)
 {
@@ -178,7 +365,10 @@ void PropertyPlotForm::mouseMoveSignal(QMouseEvent *event)
                            (event->pos().y()-m_customPlot->axisRect()->top())/(double)m_customPlot->axisRect()->height());
         rect.moveTopLeft(mousePoint-m_dragLegendOrigin);
         m_customPlot->axisRect()->insetLayout()->setInsetRect(0, rect);
-        m_customPlot->replot();
+
+        // Layer replot does not lay out the elements.
+        m_customPlot->axisRect()->insetLayout()->update(QCPLayoutElement::upLayout);
+        m_customPlot->legend->layer()->replot();
     }
 }
 
@@ -187,6 +377,11 @@ void PropertyPlotForm::mousePressSignal(QMouseEvent *event)
     if (m_customPlot->legend->selectTest(event->pos(), false) > 0)
     {
         m_draggingLegend = true;
+
+        // The axes should stay while the legend is dragged.
+        m_rangeDragSuspended = m_customPlot->interactions().testFlag(QCP::iRangeDrag);
+        m_customPlot->setInteraction(QCP::iRangeDrag, false);
+
         // since insetRect is in axisRect coordinates (0..1), we transform the mouse position:
         QPointF mousePoint((event->pos().x()-m_customPlot->axisRect()->left())/(double)m_customPlot->axisRect()->width(),
                            (event->pos().y()-m_customPlot->axisRect()->top())/(double)m_customPlot->axisRect()->height());
@@ -198,6 +393,11 @@ void PropertyPlotForm::mouseReleaseSignal(QMouseEvent *event)
 {
     Q_UNUSED(event)
     m_draggingLegend = false;
+
+    if(m_rangeDragSuspended){
+        m_customPlot->setInteraction(QCP::iRangeDrag, true);
+        m_rangeDragSuspended = false;
+    }
 }
 
 void PropertyPlotForm::beforeReplot()
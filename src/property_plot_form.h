@@ -25,7 +25,13 @@
 #ifndef PROPERTYPLOTFORM_H
 #define PROPERTYPLOTFORM_H
 
-#include "qcustomtablewidget.h"
+#include <functional>
+#include <QAtomicInt>
+#include <QFutureWatcher>
+#include <QPointer>
+
+#include "qcustomtableview.h"
+#include "plot_data_model.h"
 #include "qcustomplot.h"
 
 namespace Ui {
@@ -51,8 +57,16 @@ public:
         Clear
     };
 
+    /**
+     * @brief Function that samples a curve at the given x values
+     * @details This is called from a worker thread, so it must not touch the widgets and must hold the data it refers to, such as the snapshot of the glasses.
+     *          The temperature should be captured as well, because the current temperature of Glass is written by the GUI thread.
+     */
+    typedef std::function<QVector<double>(const QVector<double>&)> CurveSampler;
+
 public:
     PropertyPlotForm(QWidget *parent = nullptr);
+    ~PropertyPlotForm();
 
 protected slots:
 
@@ -91,24 +105,38 @@ protected slots:
     void exportCSV();
 
 protected:
-    /** Add data to the specified cell in plot data table */
-    void setValueToCell(int row, int col, double val, int digit= 1);
-
     /** Get color at specified position in calormap */
     QColor getColorFromIndex(int index, int maxIndex=5);
 
     /** Get scaled vector */
-    QVector<double> scaleVector(const QVector<double>& v, double scale);
+    static QVector<double> scaleVector(const QVector<double>& v, double scale);
 
     /** Get QVector<double> within the range */
-    QVector<double> getVectorFromRange(QCPRange range, double step=5.0);
+    static QVector<double> getVectorFromRange(QCPRange range, double step=5.0);
+
+    /**
+     * @brief Sample the curves over the x range and set them to the graphs
+     * @details A coarse sampling is shown at once, and finer ones are computed in the background until the plot step is reached.
+     *          The table is filled when the final sampling is done.  A new request or a change of the x range discards the older results.
+     * @param graphs graphs to which the curves are set
+     * @param samplers sampler of each graph
+     * @param headerLabels header labels of the table, the first of which is for x
+     * @param digit digits of the table
+     */
+    void startSampling(const QList<QCPGraph*>& graphs, const QList<CurveSampler>& samplers, const QStringList& headerLabels, int digit);
+
+    /** Discard the sampling in progress and forget the curves */
+    void cancelSampling();
 
 
     /** Plotting widget */
     QCustomPlot*  m_customPlot;
 
-    /** Plota data table widget */
-    QCustomTableWidget* m_plotDataTable;
+    /** Plota data table view */
+    QCustomTableView* m_plotDataTable;
+
+    /** Model of the plot data table, which refers to the plotted arrays */
+    PlotDataModel* m_plotDataModel;
 
     /** Line edit widget (x min) */
     QLineEdit* m_editXmin;
@@ -144,6 +172,43 @@ protected slots:
     void mouseReleaseSignal(QMouseEvent *event);
     void beforeReplot();
 
+private slots:
+    /** Sample the curves again for the current x range */
+    void resample();
+
+    /** Show the axis ranges in the line edits, and resample if the x range is changed by dragging or zooming */
+    void onRangeChanged();
+
+    void onSamplingFinished();
+
+private:
+    struct SampledData{
+        int                        generation;
+        double                     step;
+        bool                       isFinal;
+        QVector<double>            xdata;
+        QVector< QVector<double> > ydata; // empty if discarded
+    };
+
+    static SampledData sampleCurves(const QList<CurveSampler>& samplers, QCPRange range, double step, bool isFinal, int generation, const QAtomicInt* currentGeneration);
+    void startSamplingTask(double step);
+    void setSampledData(const SampledData& data);
+
+    QList< QPointer<QCPGraph> > m_sampledGraphs;
+    QList<CurveSampler>         m_samplers;
+    QStringList                 m_sampledHeaderLabels;
+    int                         m_sampledDigit;
+    QCPRange                    m_sampledRange;
+    double                      m_samplingStep;
+
+    // The generation is incremented by every request, so that the results of the older requests are discarded.
+    // Only one task runs at a time, and the latest request waits for it while it is stopping.
+    QAtomicInt                   m_samplingGeneration;
+    QFutureWatcher<SampledData>* m_samplingWatcher;
+    bool                         m_samplingPending;
+    double                       m_pendingStep;
+
+    bool m_rangeDragSuspended;
 };
 
 #endif // PROPERTYPLOTFORM_H
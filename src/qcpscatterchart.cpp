@@ -29,9 +29,8 @@ QCPScatterChart::QCPScatterChart(QCustomPlot *customPlot)
 {  
     m_customPlot = customPlot;
 
-    m_graphPoints = new QCPCurve(m_customPlot->xAxis, m_customPlot->yAxis);
-
-    m_textlabels.clear();
+    m_graphPoints = new QCPScatterPoints(m_customPlot->xAxis, m_customPlot->yAxis);
+    m_textLabels  = new QCPTextLabels(m_customPlot->xAxis, m_customPlot->yAxis);
 }
 
 QCPScatterChart::~QCPScatterChart()
@@ -45,16 +44,12 @@ QCPScatterChart::~QCPScatterChart()
     m_graphPoints = nullptr;
 
     // delete text labels
-    int labelCount = m_textlabels.size();
-    for(int i = 0; i < labelCount; i++){
-        try {
-            m_customPlot->removeItem(m_textlabels[i]);
-        }  catch (...) {
-            qDebug() << "delete error: ~QCPScatterChart";
-        }
-        m_textlabels[i] = nullptr;
+    try {
+        m_customPlot->removePlottable(m_textLabels);
+    }  catch (...) {
+        qDebug() << "delete error: ~QCPScatterChart";
     }
-    m_textlabels.clear();
+    m_textLabels = nullptr;
 
     m_customPlot = nullptr;
 }
@@ -63,7 +58,7 @@ QCPScatterChart::QCPScatterChart(QCPScatterChart &other)
 {
     m_customPlot  = other.parentPlot();
     m_graphPoints = other.graphPoints();
-    m_textlabels  = other.textLabels();
+    m_textLabels  = other.textLabels();
 }
 
 void QCPScatterChart::setName(QString name)
@@ -83,14 +78,14 @@ QCustomPlot* QCPScatterChart::parentPlot() const
     return m_customPlot;
 }
 
-QCPCurve* QCPScatterChart::graphPoints() const
+QCPScatterPoints* QCPScatterChart::graphPoints() const
 {
     return m_graphPoints;
 }
 
-QList<QCPItemText*> QCPScatterChart::textLabels() const
+QCPTextLabels* QCPScatterChart::textLabels() const
 {
-    return m_textlabels;
+    return m_textLabels;
 }
 
 QString QCPScatterChart::name() const
@@ -102,36 +97,10 @@ void QCPScatterChart::setData(const QVector<double>& x, const QVector<double>& y
 {   
     //set data to points
     m_graphPoints->setData(x,y);
-    m_graphPoints->setLineStyle(QCPCurve::lsNone);
     m_graphPoints->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssDisc,8));
 
-
-    //clear current text labels and recreate
-    if(!m_textlabels.isEmpty())
-    {
-        int labelCount = m_textlabels.size();
-        for(int i = 0; i < labelCount; i++){
-            try {
-                m_customPlot->removeItem(m_textlabels[i]);
-            }  catch (...) {
-                m_textlabels[i] = nullptr;
-            }
-            m_textlabels[i] = nullptr;
-        }
-    }
-    m_textlabels.clear();
-
-    QCPItemText *label;
-    int nlabels = label_texts.size();
-    for(int i = 0; i < nlabels; i++){
-        label = new QCPItemText(m_customPlot);
-        label->position->setCoords(x[i],y[i]);
-        label->setPositionAlignment(Qt::AlignRight|Qt::AlignBottom);
-        label->setText(label_texts[i]);
-        label->setObjectName(label_texts[i]); //used for mouse click
-        m_textlabels.append(label);
-    }
-
+    // All labels are drawn by one plottable.
+    m_textLabels->setData(x, y, label_texts);
 }
 
 void QCPScatterChart::setVisiblePointSeries(bool state)
@@ -141,15 +110,18 @@ void QCPScatterChart::setVisiblePointSeries(bool state)
 
 void QCPScatterChart::setVisibleTextLabels(bool state)
 {
-    int nlabels = m_textlabels.size();
-    for(int i = 0; i < nlabels; i++){
-        m_textlabels[i]->setVisible(state);
-    }
+    m_textLabels->setVisible(state);
+}
+
+void QCPScatterChart::setLayer(const QString &layerName)
+{
+    m_graphPoints->setLayer(layerName);
+    m_textLabels->setLayer(layerName);
 }
 
 int QCPScatterChart::dataCount() const
 {
-    return m_textlabels.size();
+    return m_textLabels->dataCount();
 }
 
 
@@ -27,6 +27,8 @@
 #define QCPSCATTERCHART_H
 
 #include "qcustomplot.h"
+#include "qcpscatterpoints.h"
+#include "qcptextlabels.h"
 
 /** Class for scatter chart using QCustomPlot */
 class QCPScatterChart
@@ -38,8 +40,8 @@ public:
     QCPScatterChart(QCPScatterChart &other);
 
     QCustomPlot*        parentPlot() const;
-    QCPCurve*           graphPoints() const;
-    QList<QCPItemText*> textLabels() const;
+    QCPScatterPoints*   graphPoints() const;
+    QCPTextLabels*      textLabels() const;
     QString             name() const;
 
     void setData(const QVector<double>& x, const QVector<double>& y, const QVector<QString>& label_texts);
@@ -47,13 +49,14 @@ public:
     void setColor(QColor color);
     void setVisiblePointSeries(bool state);
     void setVisibleTextLabels(bool state);
+    void setLayer(const QString& layerName);
     void setAxis(QCPRange xrange, QCPRange yrange);
     int  dataCount() const;
 
 private:
     QCustomPlot*        m_customPlot;
-    QCPCurve*           m_graphPoints; //points
-    QList<QCPItemText*> m_textlabels; // text label for each point
+    QCPScatterPoints*   m_graphPoints; //points
+    QCPTextLabels*      m_textLabels; // text labels of all points
 
 };
 
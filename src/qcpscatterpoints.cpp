@@ -0,0 +1,204 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "qcpscatterpoints.h"
+
+QCPScatterPoints::QCPScatterPoints(QCPAxis *keyAxis, QCPAxis *valueAxis) :
+    QCPAbstractPlottable(keyAxis, valueAxis),
+    m_scatterStyle(QCPScatterStyle::ssDisc, 8),
+    m_spriteDevicePixelRatio(0.0),
+    m_drawnCount(0)
+{
+    setSelectable(QCP::stNone);
+}
+
+void QCPScatterPoints::setData(const QVector<double> &keys, const QVector<double> &values)
+{
+    const int n = qMin(keys.size(), values.size());
+    m_keys   = keys.mid(0, n);
+    m_values = values.mid(0, n);
+}
+
+void QCPScatterPoints::setScatterStyle(const QCPScatterStyle &style)
+{
+    m_scatterStyle = style;
+    m_sprite = QPixmap();
+}
+
+double QCPScatterPoints::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+    Q_UNUSED(pos)
+    Q_UNUSED(onlySelectable)
+    Q_UNUSED(details)
+    return -1;
+}
+
+QCPRange QCPScatterPoints::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+    QCPRange range;
+    foundRange = false;
+    for(double key : m_keys){
+        if(!qIsFinite(key) || (inSignDomain == QCP::sdPositive && key <= 0) || (inSignDomain == QCP::sdNegative && key >= 0)){
+            continue;
+        }
+        if(!foundRange){
+            range = QCPRange(key, key);
+            foundRange = true;
+        }else{
+            range.expand(key);
+        }
+    }
+    return range;
+}
+
+QCPRange QCPScatterPoints::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+{
+    const bool restrictKeyRange = (inKeyRange != QCPRange());
+
+    QCPRange range;
+    foundRange = false;
+    for(int i = 0; i < m_values.size(); i++){
+        double value = m_values[i];
+        if(!qIsFinite(value) || (inSignDomain == QCP::sdPositive && value <= 0) || (inSignDomain == QCP::sdNegative && value >= 0)){
+            continue;
+        }
+        if(restrictKeyRange && !inKeyRange.contains(m_keys[i])){
+            continue;
+        }
+        if(!foundRange){
+            range = QCPRange(value, value);
+            foundRange = true;
+        }else{
+            range.expand(value);
+        }
+    }
+    return range;
+}
+
+void QCPScatterPoints::updateSprite(double devicePixelRatio)
+{
+    // The scatter style takes the pen of the plottable unless it has its own.
+    QPen pen = m_scatterStyle.isPenDefined() ? m_scatterStyle.pen() : mPen;
+    if(!m_sprite.isNull() && pen == m_spritePen && devicePixelRatio == m_spriteDevicePixelRatio){
+        return;
+    }
+
+    const int margin = qCeil(pen.widthF()) + 1;
+    const int extent = qCeil(m_scatterStyle.size()) + 2*margin;
+
+    m_sprite = QPixmap(qCeil(extent*devicePixelRatio), qCeil(extent*devicePixelRatio));
+#ifdef QCP_DEVICEPIXELRATIO_SUPPORTED
+    m_sprite.setDevicePixelRatio(devicePixelRatio);
+#endif
+    m_sprite.fill(Qt::transparent);
+
+    QCPPainter spritePainter(&m_sprite);
+    spritePainter.setRenderHint(QPainter::Antialiasing, true);
+    QCPScatterStyle style = m_scatterStyle;
+    style.setPen(pen);
+    style.applyTo(&spritePainter, pen);
+    style.drawShape(&spritePainter, extent/2.0, extent/2.0);
+    spritePainter.end();
+
+    m_spritePen = pen;
+    m_spriteDevicePixelRatio = devicePixelRatio;
+}
+
+void QCPScatterPoints::draw(QCPPainter *painter)
+{
+    m_drawnCount = 0;
+
+    if(m_keys.isEmpty() || !mKeyAxis || !mValueAxis || m_scatterStyle.isNone()){
+        return;
+    }
+
+    const QRect area = clipRect();
+    if(area.isEmpty()){
+        return;
+    }
+
+    const bool vectorized = painter->modes().testFlag(QCPPainter::pmVectorized);
+    if(vectorized){
+        applyScattersAntialiasingHint(painter);
+        m_scatterStyle.applyTo(painter, mPen);
+    }else{
+        updateSprite(mParentPlot->bufferDevicePixelRatio());
+    }
+
+    const QPointF spriteOffset(-m_sprite.width()/(2.0*m_spriteDevicePixelRatio), -m_sprite.height()/(2.0*m_spriteDevicePixelRatio));
+
+    // one bit per pixel of the clip rect
+    const int width  = area.width();
+    const int height = area.height();
+    const int wordCount = (width*height + 63)/64;
+    m_paintedPixels.fill(0, wordCount);
+    quint64* painted = m_paintedPixels.data();
+
+    // The markers a little out of the clip rect are still drawn since they are partly visible.
+    const double reach = m_scatterStyle.size();
+    const QRectF  visible = QRectF(area).adjusted(-reach, -reach, reach, reach);
+
+    for(int i = 0; i < m_keys.size(); i++){
+        double px, py;
+        coordsToPixels(m_keys[i], m_values[i], px, py);
+        if(!visible.contains(px, py)){
+            continue; // NaN is also rejected
+        }
+
+        // Skip the point on the pixel already painted.  The points out of the clip rect are not deduplicated.
+        const int ix = qRound(px) - area.left();
+        const int iy = qRound(py) - area.top();
+        if(ix >= 0 && ix < width && iy >= 0 && iy < height){
+            const int bit = iy*width + ix;
+            quint64& word = painted[bit >> 6];
+            const quint64 mask = quint64(1) << (bit & 63);
+            if(word & mask){
+                continue;
+            }
+            word |= mask;
+        }
+
+        if(vectorized){
+            m_scatterStyle.drawShape(painter, px, py);
+        }else{
+            painter->drawPixmap(QPointF(qRound(px), qRound(py)) + spriteOffset, m_sprite);
+        }
+        m_drawnCount++;
+    }
+}
+
+void QCPScatterPoints::drawLegendIcon(QCPPainter *painter, const QRectF &rect) const
+{
+    if(m_scatterStyle.isNone()){
+        return;
+    }
+
+    applyScattersAntialiasingHint(painter);
+    QCPScatterStyle style = m_scatterStyle;
+    if(style.size() > rect.height()*0.9){
+        style.setSize(rect.height()*0.9); // marker fits in the icon
+    }
+    style.applyTo(painter, mPen);
+    style.drawShape(painter, rect.center());
+}
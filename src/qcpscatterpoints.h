@@ -0,0 +1,77 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef QCPSCATTERPOINTS_H
+#define QCPSCATTERPOINTS_H
+
+#include "qcustomplot.h"
+
+/**
+ * @brief Plottable to draw a large point series with a single marker style
+ * @details The coordinates are transformed in one loop, and a point landing on the pixel already painted by this series is skipped.
+ *          The marker is rendered once to a sprite, which is blitted for each point.  The shapes are drawn as they are in vectorized export.
+ *          The points are not selectable.
+ */
+class QCPScatterPoints : public QCPAbstractPlottable
+{
+    Q_OBJECT
+
+public:
+    explicit QCPScatterPoints(QCPAxis *keyAxis, QCPAxis *valueAxis);
+
+    void setData(const QVector<double>& keys, const QVector<double>& values);
+    void setScatterStyle(const QCPScatterStyle& style);
+
+    const QCPScatterStyle& scatterStyle() const { return m_scatterStyle; }
+    int dataCount() const { return m_keys.size(); }
+
+    /** @return number of the points drawn in the last replot */
+    int drawnCount() const { return m_drawnCount; }
+
+    // reimplemented virtual methods
+    virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details=nullptr) const Q_DECL_OVERRIDE;
+    virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth) const Q_DECL_OVERRIDE;
+    virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange()) const Q_DECL_OVERRIDE;
+
+protected:
+    virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
+    virtual void drawLegendIcon(QCPPainter *painter, const QRectF &rect) const Q_DECL_OVERRIDE;
+
+private:
+    void updateSprite(double devicePixelRatio);
+
+    QVector<double> m_keys;
+    QVector<double> m_values;
+
+    QCPScatterStyle m_scatterStyle;
+
+    QPixmap m_sprite;             // pre-rendered marker
+    QPen    m_spritePen;          // pen with which the sprite was rendered
+    double  m_spriteDevicePixelRatio;
+
+    QVector<quint64> m_paintedPixels; // bitset over the clip rect, kept to avoid reallocation
+    int m_drawnCount;
+};
+
+#endif // QCPSCATTERPOINTS_H
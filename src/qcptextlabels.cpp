@@ -0,0 +1,250 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "qcptextlabels.h"
+
+QCPTextLabels::QCPTextLabels(QCPAxis *keyAxis, QCPAxis *valueAxis) :
+    QCPAbstractPlottable(keyAxis, valueAxis),
+    m_color(Qt::black),
+    m_padding(2),
+    m_drawnCount(0)
+{
+    m_font = mParentPlot->font();
+    setSelectable(QCP::stNone);
+    removeFromLegend(); // added by the parent plot
+}
+
+void QCPTextLabels::setData(const QVector<double> &keys, const QVector<double> &values, const QVector<QString> &texts)
+{
+    const int n = qMin(qMin(keys.size(), values.size()), texts.size());
+    m_keys   = keys.mid(0, n);
+    m_values = values.mid(0, n);
+    m_texts  = texts.mid(0, n);
+    m_textWidths.clear();
+}
+
+void QCPTextLabels::setFont(const QFont &font)
+{
+    m_font = font;
+    m_textWidths.clear();
+}
+
+void QCPTextLabels::setColor(const QColor &color)
+{
+    m_color = color;
+}
+
+void QCPTextLabels::setPadding(int padding)
+{
+    m_padding = padding;
+}
+
+double QCPTextLabels::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+    Q_UNUSED(pos)
+    Q_UNUSED(onlySelectable)
+    Q_UNUSED(details)
+    return -1;
+}
+
+QCPRange QCPTextLabels::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+    QCPRange range;
+    foundRange = false;
+    for(double key : m_keys){
+        if(!qIsFinite(key) || (inSignDomain == QCP::sdPositive && key <= 0) || (inSignDomain == QCP::sdNegative && key >= 0)){
+            continue;
+        }
+        if(!foundRange){
+            range = QCPRange(key, key);
+            foundRange = true;
+        }else{
+            range.expand(key);
+        }
+    }
+    return range;
+}
+
+QCPRange QCPTextLabels::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+{
+    const bool restrictKeyRange = (inKeyRange != QCPRange());
+
+    QCPRange range;
+    foundRange = false;
+    for(int i = 0; i < m_values.size(); i++){
+        double value = m_values[i];
+        if(!qIsFinite(value) || (inSignDomain == QCP::sdPositive && value <= 0) || (inSignDomain == QCP::sdNegative && value >= 0)){
+            continue;
+        }
+        if(restrictKeyRange && !inKeyRange.contains(m_keys[i])){
+            continue;
+        }
+        if(!foundRange){
+            range = QCPRange(value, value);
+            foundRange = true;
+        }else{
+            range.expand(value);
+        }
+    }
+    return range;
+}
+
+QCPTextLabels* QCPTextLabels::placementOwner()
+{
+    // The children of the layer are drawn in this order, so the owner is drawn first in every replot of the layer.
+    if(mLayer){
+        for(QCPLayerable* child : mLayer->children()){
+            QCPTextLabels* labels = qobject_cast<QCPTextLabels*>(child);
+            if(labels && labels->realVisibility()){
+                return labels;
+            }
+        }
+    }
+    return this;
+}
+
+void QCPTextLabels::draw(QCPPainter *painter)
+{
+    m_drawnCount = 0;
+
+    QFontMetrics metrics(m_font);
+    const QRect area   = clipRect();
+    const int   height = metrics.height();
+
+    // The owner clears the grid at the beginning of the replot, and the other labels on the layer avoid the labels placed before.
+    QCPTextLabels* owner = placementOwner();
+    if(owner == this){
+        m_grid.reset(area, qMax(1, 8*height), qMax(1, height));
+    }
+    OccupancyGrid& grid = owner->m_grid;
+
+    if(m_texts.isEmpty() || !mKeyAxis || !mValueAxis){
+        return;
+    }
+
+    if(m_textWidths.size() != m_texts.size()){
+        m_textWidths.resize(m_texts.size());
+        for(int i = 0; i < m_texts.size(); i++){
+            m_textWidths[i] = metrics.boundingRect(m_texts[i]).width();
+        }
+    }
+
+    painter->setFont(m_font);
+    painter->setPen(m_color);
+
+    for(int i = 0; i < m_texts.size(); i++){
+        double px, py;
+        coordsToPixels(m_keys[i], m_values[i], px, py);
+        if(!qIsFinite(px) || !qIsFinite(py) || !area.contains(qRound(px), qRound(py))){
+            continue; // the label of a point out of the viewport is not drawn
+        }
+
+        // Try the upper left first, as the former labels aligned at the right bottom with the point, and then the other corners.
+        const int x = qRound(px), y = qRound(py);
+        const int w = m_textWidths[i], p = m_padding;
+        const QRect candidates[4] = {
+            QRect(x - w - p, y - height - p, w, height),
+            QRect(x + p,     y - height - p, w, height),
+            QRect(x - w - p, y + p,          w, height),
+            QRect(x + p,     y + p,          w, height)
+        };
+
+        for(const QRect& rect : candidates){
+            if(area.contains(rect) && !grid.intersects(rect)){
+                grid.insert(rect);
+                painter->drawText(rect, Qt::AlignLeft|Qt::AlignVCenter, m_texts[i]);
+                m_drawnCount++;
+                break;
+            }
+        }
+    }
+}
+
+void QCPTextLabels::drawLegendIcon(QCPPainter *painter, const QRectF &rect) const
+{
+    painter->setFont(m_font);
+    painter->setPen(m_color);
+    painter->drawText(rect, Qt::AlignCenter, "A");
+}
+
+
+QCPTextLabels::OccupancyGrid::OccupancyGrid() :
+    m_cellWidth(1),
+    m_cellHeight(1),
+    m_columnCount(1),
+    m_rowCount(1)
+{
+    m_cells.resize(1);
+}
+
+void QCPTextLabels::OccupancyGrid::reset(const QRect &area, int cellWidth, int cellHeight)
+{
+    m_area        = area;
+    m_cellWidth   = cellWidth;
+    m_cellHeight  = cellHeight;
+    m_columnCount = qMax(1, area.width()/cellWidth + 1);
+    m_rowCount    = qMax(1, area.height()/cellHeight + 1);
+
+    m_cells.clear();
+    m_cells.resize(m_columnCount*m_rowCount);
+}
+
+int QCPTextLabels::OccupancyGrid::cellRange(int pos, int origin, int cellSize, int cellCount) const
+{
+    return qBound(0, (pos - origin)/cellSize, cellCount - 1);
+}
+
+bool QCPTextLabels::OccupancyGrid::intersects(const QRect &rect) const
+{
+    const int c0 = cellRange(rect.left(),   m_area.left(), m_cellWidth,  m_columnCount);
+    const int c1 = cellRange(rect.right(),  m_area.left(), m_cellWidth,  m_columnCount);
+    const int r0 = cellRange(rect.top(),    m_area.top(),  m_cellHeight, m_rowCount);
+    const int r1 = cellRange(rect.bottom(), m_area.top(),  m_cellHeight, m_rowCount);
+
+    for(int r = r0; r <= r1; r++){
+        for(int c = c0; c <= c1; c++){
+            for(const QRect& occupied : m_cells[r*m_columnCount + c]){
+                if(occupied.intersects(rect)){
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void QCPTextLabels::OccupancyGrid::insert(const QRect &rect)
+{
+    const int c0 = cellRange(rect.left(),   m_area.left(), m_cellWidth,  m_columnCount);
+    const int c1 = cellRange(rect.right(),  m_area.left(), m_cellWidth,  m_columnCount);
+    const int r0 = cellRange(rect.top(),    m_area.top(),  m_cellHeight, m_rowCount);
+    const int r1 = cellRange(rect.bottom(), m_area.top(),  m_cellHeight, m_rowCount);
+
+    // A rectangle is registered to every cell it covers, so that a query looks only at its own cells.
+    for(int r = r0; r <= r1; r++){
+        for(int c = c0; c <= c1; c++){
+            m_cells[r*m_columnCount + c].append(rect);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef QCPTEXTLABELS_H
+#define QCPTEXTLABELS_H
+
+#include "qcustomplot.h"
+
+/**
+ * @brief Plottable to draw the text labels of a point series in one pass
+ * @details The labels out of the axis rect are skipped, and the overlapping labels are hidden by greedy placement in the data order
+ *          at the current zoom, so that more labels are shown as the plot is zoomed in.
+ *          The labels of all the QCPTextLabels on the same layer are placed on one grid in the layer order, so that the series do not overlap each other either.
+ *          The labels are not selectable.
+ */
+class QCPTextLabels : public QCPAbstractPlottable
+{
+    Q_OBJECT
+
+public:
+    explicit QCPTextLabels(QCPAxis *keyAxis, QCPAxis *valueAxis);
+
+    void setData(const QVector<double>& keys, const QVector<double>& values, const QVector<QString>& texts);
+    void setFont(const QFont& font);
+    void setColor(const QColor& color);
+
+    /** Space in pixel between the point and its label */
+    void setPadding(int padding);
+
+    int dataCount() const { return m_texts.size(); }
+
+    /** @return number of the labels drawn in the last replot */
+    int drawnCount() const { return m_drawnCount; }
+
+    // reimplemented virtual methods
+    virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details=nullptr) const Q_DECL_OVERRIDE;
+    virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth) const Q_DECL_OVERRIDE;
+    virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange()) const Q_DECL_OVERRIDE;
+
+protected:
+    virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
+    virtual void drawLegendIcon(QCPPainter *painter, const QRectF &rect) const Q_DECL_OVERRIDE;
+
+private:
+    /** Occupied rectangles bucketed by a uniform grid over the axis rect */
+    class OccupancyGrid{
+    public:
+        OccupancyGrid();
+        void reset(const QRect& area, int cellWidth, int cellHeight);
+        bool intersects(const QRect& rect) const;
+        void insert(const QRect& rect);
+    private:
+        int cellRange(int pos, int origin, int cellSize, int cellCount) const;
+        QRect m_area;
+        int   m_cellWidth, m_cellHeight;
+        int   m_columnCount, m_rowCount;
+        QVector< QVector<QRect> > m_cells;
+    };
+
+    QVector<double>  m_keys;
+    QVector<double>  m_values;
+    QVector<QString> m_texts;
+    QVector<int>     m_textWidths; // cached width in pixel, empty if the font is changed
+
+    /** The first visible QCPTextLabels on the layer, which owns the grid shared in the replot */
+    QCPTextLabels* placementOwner();
+    OccupancyGrid  m_grid;
+
+    QFont  m_font;
+    QColor m_color;
+    int    m_padding;
+    int    m_drawnCount;
+};
+
+#endif // QCPTEXTLABELS_H
@@ -23,17 +23,21 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <cmath>
 #include <QShortcut>
 #include <QApplication>
 #include <QClipboard>
 #include <QFile>
 #include <QTextStream>
-#include <QDebug>
-#include "qcustomtablewidget.h"
+#include <QHeaderView>
+#include "qcustomtableview.h"
 
-QCustomTableWidget::QCustomTableWidget(QWidget* parent) :
-    QTableWidget(parent)
+QCustomTableView::QCustomTableView(QWidget* parent) :
+    QTableView(parent)
 {
+    // Rows have the same height, so that the view does not measure every row.
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+
     QShortcut *scCtrlC = new QShortcut(QKeySequence("Ctrl+C"), this);
     QObject::connect(scCtrlC, SIGNAL(activated()), this, SLOT(copyCell()));
     QShortcut *scCtrlV = new QShortcut(QKeySequence("Ctrl+V"), this);
@@ -41,19 +45,20 @@ QCustomTableWidget::QCustomTableWidget(QWidget* parent) :
 }
 
 
-void QCustomTableWidget::copyCell()
+void QCustomTableView::copyCell()
 {
-    //https://qiita.com/MOKYN/items/4b7c090af655efda0c42
-
     QAbstractItemModel* model = this->model();
     QItemSelectionModel* selection = this->selectionModel();
-    QModelIndexList indexes = selection->selectedIndexes();
+    if(!model || !selection){
+        return;
+    }
 
+    QModelIndexList indexes = selection->selectedIndexes();
     if (indexes.count() == 0) {
-            return;
+        return;
     }
 
-    //qSort(indexes); // デフォルトだと列ソートのため行でソートする
+    // sort by row
     std::sort(indexes.begin(), indexes.end());
 
     QString clip;
@@ -61,75 +66,85 @@ void QCustomTableWidget::copyCell()
     indexes.removeFirst();
     clip.append(model->data(previous).toString());
 
-    for(QModelIndex& current : indexes.toVector())
+    for(QModelIndex& current : indexes)
     {
-            if (current.row() != previous.row())
-            {
-                    clip.append("\n");
-            }
-            else
-            {
-                    clip.append("\t");
-            }
+        if (current.row() != previous.row())
+        {
+            clip.append("\n");
+        }
+        else
+        {
+            clip.append("\t");
+        }
 
-            clip.append(model->data(current).toString());
-            previous = current;
+        clip.append(model->data(current).toString());
+        previous = current;
     }
 
     QApplication::clipboard()->setText(clip);
 }
 
-void QCustomTableWidget::pasteCell()
+void QCustomTableView::pasteCell()
 {
-    if (this->selectedItems().size() != 1)
-    {
-            return;
+    QAbstractItemModel* model = this->model();
+    QItemSelectionModel* selection = this->selectionModel();
+    if(!model || !selection || selection->selectedIndexes().size() != 1){
+        return;
     }
+
     QString clip = QApplication::clipboard()->text();
     QStringList rowList = clip.split("\n");
 
-    QTableWidgetItem *currentItem = this->selectedItems().first();
-    int pasteRow = currentItem->row();
-    int pasteCol = currentItem->column();
-    for(QString &row : rowList.toVector())
+    QModelIndex currentIndex = selection->selectedIndexes().first();
+    int pasteRow = currentIndex.row();
+    for(QString &row : rowList)
     {
         QStringList colList = row.split("\t");
-        for (QString &cell : colList.toVector())
+        int pasteCol = currentIndex.column();
+        for (QString &cell : colList)
         {
-                this->item(pasteRow, pasteCol)->setText(cell);
-                pasteCol++;
+            QModelIndex index = model->index(pasteRow, pasteCol);
+            if(index.isValid()){
+                model->setData(index, cell);
+            }
+            pasteCol++;
         }
-        pasteCol = currentItem->column();
         pasteRow++;
     }
 }
 
-bool QCustomTableWidget::exportCSV(const QString &filepath)
+bool QCustomTableView::exportCSV(const QString &filepath)
 {
-    QFile data(filepath);
-    if (data.open(QFile::WriteOnly | QIODevice::Append)) {
+    QAbstractItemModel* model = this->model();
+    if(!model){
+        return false;
+    }
 
+    QFile data(filepath);
+    if (!data.open(QFile::WriteOnly | QIODevice::Append)) {
+        return false;
     }
 
     QTextStream output(&data);
 
-    const int nrows = this->rowCount();
-    const int ncolumns = this->columnCount();
+    const int nrows = model->rowCount();
+    const int ncolumns = model->columnCount();
 
     // header labels
     for(int j = 0; j < ncolumns; j++){
-        output << this->horizontalHeaderItem(j)->text();
+        output << model->headerData(j, Qt::Horizontal).toString();
         if( j < ncolumns - 1 ){
             output << ", ";
         }
     }
     output << "\n";
 
+    // The cells are formatted row by row, not kept in memory.
     for(int i = 0; i < nrows; i++){
         for(int j = 0; j < ncolumns; j++){
-            QTableWidgetItem* item = this->item(i,j);
-            if(item){
-                output << this->item(i,j)->text();
+            QVariant value = model->data(model->index(i, j));
+            if(value.isValid()){
+                output << value.toString();
             }else{
                 output << NAN;
             }
@@ -22,26 +22,27 @@
  **  Date    : 2020-1-25                                                    **
  *****************************************************************************/
 
-#ifndef QCUSTOMTABLEWIDGET_H
-#define QCUSTOMTABLEWIDGET_H
+#ifndef QCUSTOMTABLEVIEW_H
+#define QCUSTOMTABLEVIEW_H
 
-#include <QTableWidget>
+#include <QTableView>
 #include <QString>
 
-/** Modified table widget that allows copy and paste on the cells and exporting to csv file. */
-class QCustomTableWidget : public QTableWidget
+/** Modified table view that allows copy and paste on the cells and exporting to csv file. */
+class QCustomTableView : public QTableView
 {
     Q_OBJECT
 
 public:
-    QCustomTableWidget(QWidget* parent = nullptr);
+    QCustomTableView(QWidget* parent = nullptr);
 
     bool exportCSV(const QString& filepath);
 
 private slots:
     void copyCell();
+
+    /** Paste the clipboard from the selected cell.  Only the cells which the model accepts by setData() are modified. */
     void pasteCell();
 };
 
 #endif
-
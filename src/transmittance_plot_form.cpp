@@ -83,6 +83,14 @@ TransmittancePlotForm::TransmittancePlotForm(QWidget *parent) :
     m_editYmax = ui->lineEdit_Ymax;
 
 
+
+    // catalog files modified on disk
+    GlassCatalogManager* manager = GlassCatalogManager::instance();
+    if(manager){
+        QObject::connect(manager, SIGNAL(glassesRemoved(int,QStringList)), this, SLOT(onGlassesRemoved(int,QStringList)));
+        QObject::connect(manager, SIGNAL(glassesChanged(int,QStringList)), this, SLOT(onGlassesChanged(int,QStringList)));
+    }
+
     setDefault();
 }
 
@@ -95,7 +103,7 @@ TransmittancePlotForm::~TransmittancePlotForm()
     m_customPlot->clearPlottables();
     m_customPlot = nullptr;
 
-    m_plotDataTable->clear();
+    m_plotDataModel->clear();
     m_plotDataTable = nullptr;
 
     delete ui;
@@ -131,23 +139,20 @@ void TransmittancePlotForm::updateAll()
     m_customPlot->clearGraphs();
     m_customPlot->clearItems();
     m_customPlot->clearPlottables();
-    m_plotDataTable->clear();
-
-    double          thickness     = m_editThickness->text().toDouble();
-    double          plotStep      = m_editPlotStep->text().toDouble();
-    QVector<double> vLambdanano   = getVectorFromRange(m_customPlot->xAxis->range(), plotStep); // unit:nm
-    QVector<double> vLambdamicron = scaleVector(vLambdanano,0.001);
-    QVector<double> ydata;
-    QCPGraph*       graph;
-    QCPItemTracer*  upperTracer;
-    QCPItemTracer*  lowerTracer;
-
-    int i,j;
-    int rowCount    = vLambdanano.size();
-    int columnCount = m_glassList.size() + 1; // lambda + glasses
-    m_plotDataTable->setRowCount(rowCount);
-    m_plotDataTable->setColumnCount(columnCount);
 
+    // The glasses are held by the snapshot while the curves are sampled in the background.
+    std::shared_ptr<const CatalogSnapshot> snapshot = GlassCatalogManager::snapshot();
+
+    double              thickness = m_editThickness->text().toDouble();
+    QList<QCPGraph*>    graphs;
+    QList<CurveSampler> samplers;
+    QCPGraph*           graph;
+    QCPItemTracer*      upperTracer;
+    QCPItemTracer*      lowerTracer;
+
+    int i;
+
+    // columns of the table: lambda + glasses
     QStringList header = QStringList() << "Wavelength(nm)";
 
     int    glassCount = m_glassList.size();
@@ -161,12 +166,16 @@ void TransmittancePlotForm::updateAll()
         currentGlass = m_glassList[i];
 
         // graphs
-        ydata = currentGlass->transmittance(vLambdamicron, thickness);
         graph = m_customPlot->addGraph();
         graph->setName(currentGlass->fullName());
-        graph->setData(vLambdanano, ydata);
         graph->setPen(QPen(getColorFromIndex(i, m_maxGraphCount)));
         graph->setVisible(true);
+        graphs.append(graph);
+
+        // transmittance
+        samplers.append([currentGlass, snapshot, thickness](const QVector<double>& vLambdanano){
+            return currentGlass->transmittance(scaleVector(vLambdanano, 0.001), thickness); // nm to micron
+        });
 
         // tracer
         upperTracer = new QCPItemTracer(m_customPlot);
@@ -189,15 +198,10 @@ void TransmittancePlotForm::updateAll()
 
         // table
         header << currentGlass->productName();
-        for(j = 0; j< rowCount; j++)
-        {
-            setValueToCell(j, 0,   vLambdanano[j], digit ); // wavelength
-            setValueToCell(j, i+1, ydata[j],       digit ); // transmittance
-        }
     }
 
-    m_customPlot->replot();
-    m_plotDataTable->setHorizontalHeaderLabels(header);
+    // The tracers are positioned when the sampled curves are drawn.
+    startSampling(graphs, samplers, header, digit);
 
 }
 
@@ -222,11 +226,42 @@ void TransmittancePlotForm::deleteGraph()
 
 void TransmittancePlotForm::clearAll()
 {
+    cancelSampling();
     m_glassList.clear();
     m_customPlot->clearGraphs();
     m_customPlot->clearItems();
     m_customPlot->replot();
-    m_plotDataTable->clear();
-    m_plotDataTable->update();
+    m_plotDataModel->clear();
 }
 
+
+void TransmittancePlotForm::onGlassesRemoved(int catalogIndex, const QStringList& glassNames)
+{
+    bool found = false;
+    for(int i = m_glassList.size()-1; i >= 0; i--){
+        if(GlassCatalogManager::isListed(m_glassList[i], catalogIndex, glassNames)){
+            m_glassList.removeAt(i);
+            found = true;
+        }
+    }
+
+    if(found){
+        updateAll();
+    }
+}
+
+void TransmittancePlotForm::onGlassesChanged(int catalogIndex, const QStringList& glassNames)
+{
+    // The modified glasses are new objects in the new snapshot.
+    bool found = false;
+    for(auto &g : m_glassList){
+        if(GlassCatalogManager::isListed(g, catalogIndex, glassNames)){
+            g = GlassCatalogManager::find(g->fullName());
+            found = true;
+        }
+    }
+
+    if(found){
+        updateAll();
+    }
+}
@@ -45,6 +45,8 @@ private slots:
     void addGraph() override;
     void deleteGraph() override;
     void clearAll() override;
+    void onGlassesRemoved(int catalogIndex, const QStringList& glassNames);
+    void onGlassesChanged(int catalogIndex, const QStringList& glassNames);
     void updateAll() override;
 
 private:
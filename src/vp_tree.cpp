@@ -0,0 +1,170 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "vp_tree.h"
+
+#include <algorithm>
+#include <QtMath>
+#include <QtNumeric>
+
+namespace {
+
+bool neighborLess(const VpTree::Neighbor& a, const VpTree::Neighbor& b)
+{
+    return a.distance < b.distance;
+}
+
+}
+
+VpTree::VpTree()
+{
+    m_dimension = 0;
+    m_root      = -1;
+}
+
+void VpTree::clear()
+{
+    m_coords.clear();
+    m_ids.clear();
+    m_nodes.clear();
+    m_dimension = 0;
+    m_root      = -1;
+}
+
+double VpTree::distance(int point, const double *query) const
+{
+    const double* p = m_coords.constData() + point*m_dimension;
+
+    double d2 = 0.0;
+    for(int i = 0; i < m_dimension; i++){
+        double d = p[i] - query[i];
+        d2 += d*d;
+    }
+    return sqrt(d2);
+}
+
+void VpTree::build(const QVector<double> &coords, int dimension, const QVector<int> &ids)
+{
+    Q_ASSERT(coords.size() == dimension*ids.size());
+
+    m_coords    = coords;
+    m_ids       = ids;
+    m_dimension = dimension;
+    m_nodes.clear();
+    m_nodes.reserve(ids.size());
+
+    QVector<int> points(ids.size());
+    for(int i = 0; i < points.size(); i++){
+        points[i] = i;
+    }
+    QVector<double> distances(ids.size());
+
+    m_root = buildRange(points, 0, points.size(), distances);
+}
+
+int VpTree::buildRange(QVector<int>& points, int begin, int end, QVector<double>& distances)
+{
+    if(begin >= end){
+        return -1;
+    }
+
+    // The middle point is taken as the vantage point, which is effectively random since the ranges are reordered by distance.
+    std::swap(points[begin], points[(begin + end)/2]);
+    int vantage = points[begin];
+    const double* v = m_coords.constData() + vantage*m_dimension;
+
+    int nodeIndex = m_nodes.size();
+    m_nodes.append(Node{vantage, 0.0, -1, -1});
+
+    if(end - begin == 1){
+        return nodeIndex;
+    }
+
+    for(int i = begin + 1; i < end; i++){
+        distances[points[i]] = distance(points[i], v);
+    }
+
+    // split the rest at the median distance
+    int mid = (begin + 1 + end)/2;
+    std::nth_element(points.begin() + begin + 1, points.begin() + mid, points.begin() + end, [&distances](int a, int b){
+        return distances[a] < distances[b];
+    });
+    double threshold = distances[points[mid]];
+
+    int inside  = buildRange(points, begin + 1, mid + 1, distances);
+    int outside = buildRange(points, mid + 1, end, distances);
+
+    m_nodes[nodeIndex].threshold = threshold;
+    m_nodes[nodeIndex].inside    = inside;
+    m_nodes[nodeIndex].outside   = outside;
+
+    return nodeIndex;
+}
+
+void VpTree::search(int node, const double *query, int k, const std::function<bool(int)> &accept, QVector<Neighbor> &heap, double &tau) const
+{
+    if(node < 0){
+        return;
+    }
+
+    const Node& n = m_nodes[node];
+    double d = distance(n.point, query);
+    int    id = m_ids[n.point];
+
+    if(d < tau && (!accept || accept(id))){
+        heap.append(Neighbor{id, d});
+        std::push_heap(heap.begin(), heap.end(), neighborLess);
+        if(heap.size() > k){
+            std::pop_heap(heap.begin(), heap.end(), neighborLess);
+            heap.removeLast();
+        }
+        if(heap.size() == k){
+            tau = heap.first().distance;
+        }
+    }
+
+    // visit the side containing the query first
+    if(d <= n.threshold){
+        if(d - tau <= n.threshold) search(n.inside,  query, k, accept, heap, tau);
+        if(d + tau >= n.threshold) search(n.outside, query, k, accept, heap, tau);
+    }else{
+        if(d + tau >= n.threshold) search(n.outside, query, k, accept, heap, tau);
+        if(d - tau <= n.threshold) search(n.inside,  query, k, accept, heap, tau);
+    }
+}
+
+QVector<VpTree::Neighbor> VpTree::kNearest(const double *query, int k, const std::function<bool(int)> &accept) const
+{
+    QVector<Neighbor> heap;
+    if(k <= 0 || m_root < 0){
+        return heap;
+    }
+
+    heap.reserve(k + 1);
+    double tau = qInf();
+    search(m_root, query, k, accept, heap, tau);
+
+    std::sort(heap.begin(), heap.end(), neighborLess);
+    return heap;
+}
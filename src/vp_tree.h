@@ -0,0 +1,87 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef VP_TREE_H
+#define VP_TREE_H
+
+#include <functional>
+#include <QVector>
+
+/**
+ * @brief Vantage-point tree for k nearest neighbor search in a multi-dimensional Euclidean space
+ * @details Each node splits its points by the median distance from the vantage point.
+ *          The points farther than the current k-th candidate are pruned by the triangle inequality.
+ */
+class VpTree
+{
+public:
+    struct Neighbor{
+        int    id;
+        double distance;
+    };
+
+    VpTree();
+
+    /**
+     * @brief Build the tree
+     * @param coords coordinates of the points, (point count) x (dimension) in row-major order
+     * @param dimension dimension of the space
+     * @param ids id of each point
+     */
+    void build(const QVector<double>& coords, int dimension, const QVector<int>& ids);
+    void clear();
+
+    int  size() const { return m_ids.size(); }
+    int  dimension() const { return m_dimension; }
+    bool isEmpty() const { return m_ids.isEmpty(); }
+
+    /**
+     * @brief k nearest points
+     * @param query coordinates of the query point, whose size is dimension()
+     * @param k maximum number of the results
+     * @param accept filter by id. Points rejected by it are not counted.
+     * @return neighbors sorted by the distance
+     */
+    QVector<Neighbor> kNearest(const double* query, int k, const std::function<bool(int)>& accept = nullptr) const;
+
+private:
+    struct Node{
+        int    point;     // index of the vantage point
+        double threshold; // median distance
+        int    inside;    // child node of the points within the threshold, -1 if none
+        int    outside;   // child node of the points beyond the threshold, -1 if none
+    };
+
+    int    buildRange(QVector<int>& points, int begin, int end, QVector<double>& distances);
+    void   search(int node, const double* query, int k, const std::function<bool(int)>& accept, QVector<Neighbor>& heap, double& tau) const;
+    double distance(int point, const double* query) const;
+
+    QVector<double> m_coords;
+    QVector<int>    m_ids;
+    QVector<Node>   m_nodes;
+    int             m_dimension;
+    int             m_root;
+};
+
+#endif // VP_TREE_H